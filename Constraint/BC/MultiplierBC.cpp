@@ -36,29 +36,29 @@ int MultiplierBC::process(const shared_ptr<DomainBase>& D) {
     if(IntegratorType::Explicit == D->get_current_step()->get_integrator()->type()) {
         if(auto& t_mass = W->get_mass(); nullptr != t_mass) {
             std::scoped_lock lock(W->get_mass_mutex());
-            for(const auto I : dof_encoding) t_mass->unify(I);
+            t_mass->unify(dof_encoding);
         }
     }
     else {
         if(auto& t_stiff = W->get_stiffness(); nullptr != t_stiff) {
             std::scoped_lock lock(W->get_stiffness_mutex());
-            for(const auto I : dof_encoding) t_stiff->unify(I);
+            t_stiff->unify(dof_encoding);
         }
         if(auto& t_mass = W->get_mass(); nullptr != t_mass) {
             std::scoped_lock lock(W->get_mass_mutex());
-            for(const auto I : dof_encoding) t_mass->nullify(I);
+            t_mass->nullify(dof_encoding);
         }
         if(auto& t_damping = W->get_damping(); nullptr != t_damping) {
             std::scoped_lock lock(W->get_damping_mutex());
-            for(const auto I : dof_encoding) t_damping->nullify(I);
+            t_damping->nullify(dof_encoding);
         }
         if(auto& t_nonviscous = W->get_nonviscous(); nullptr != t_nonviscous) {
             std::scoped_lock lock(W->get_nonviscous_mutex());
-            for(const auto I : dof_encoding) t_nonviscous->nullify(I);
+            t_nonviscous->nullify(dof_encoding);
         }
         if(auto& t_geometry = W->get_geometry(); nullptr != t_geometry) {
             std::scoped_lock lock(W->get_geometry_mutex());
-            for(const auto I : dof_encoding) t_geometry->nullify(I);
+            t_geometry->nullify(dof_encoding);
         }
     }
 
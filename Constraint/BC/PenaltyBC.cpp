@@ -65,7 +65,9 @@ int PenaltyBC::process(const shared_ptr<DomainBase>& D) {
 
     stiffness.zeros(dof_encoding.n_elem, dof_encoding.n_elem);
 
-    stiffness.diag().fill(multiplier * D->get_factory()->get_stiffness()->max());
+    // restrained DoFs are decoupled by matrix-free solvers, the magnitude does not matter
+    const auto& t_stiffness = D->get_factory()->get_stiffness();
+    stiffness.diag().fill(multiplier * (nullptr == t_stiffness ? 1. : t_stiffness->max()));
 
     return SUANPAN_SUCCESS;
 }
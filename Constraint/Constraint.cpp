@@ -16,6 +16,7 @@
  ******************************************************************************/
 
 #include "Constraint.h"
+#include <Toolbox/state_archive.h>
 
 double Constraint::multiplier = 1E8;
 
@@ -47,4 +48,6 @@ void Constraint::set_multiplier_size(const unsigned S) {
 
 unsigned Constraint::get_multiplier_size() const { return num_size; }
 
+void Constraint::archive(state_archive& A) { A(trial_lambda, current_lambda); }
+
 void set_constraint_multiplier(const double M) { Constraint::multiplier = M; }
@@ -33,6 +33,8 @@
 
 #include <Domain/ConditionalModifier.h>
 
+class state_archive;
+
 class Constraint : public ConditionalModifier {
 protected:
     static double multiplier;
@@ -76,6 +78,11 @@ public:
 
     void set_multiplier_size(unsigned);
     [[nodiscard]] unsigned get_multiplier_size() const;
+
+    /**
+     * \brief Archive multipliers, constraints with additional history variables shall override this method.
+     */
+    virtual void archive(state_archive&);
 };
 
 void set_constraint_multiplier(double);
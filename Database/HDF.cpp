@@ -18,15 +18,102 @@
 #ifdef SUANPAN_HDF5
 
 #include "HDF.h"
+#include <Domain/DomainBase.h>
+#include <Step/Step.h>
+#include <Toolbox/state_archive.h>
+#include <Toolbox/writer_queue.hpp>
 #include <hdf5.h>
+#include <hdf5_hl.h>
 
-//#include <hdf5_hl.h>
+HDF::HDF(string N)
+    : file_name(std::move(N)) {}
 
-HDF::HDF(const char* N)
-    : file_id(H5Fcreate(N, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) {}
+int HDF::save() {
+    const auto& D = get_domain();
+    if(nullptr == D) return SUANPAN_FAIL;
 
-HDF::~HDF() { H5Fclose(file_id); }
+    state_archive A;
+    D->archive(A);
 
-int HDF::save() { return 0; }
+    auto step_tag = D->get_current_step_tag();
+    auto time_left = 0.;
+    if(D->find_step(step_tag)) time_left = D->get_step(step_tag)->get_time_left();
+
+    suanpan::output_queue().push([target = fs::path(file_name), data = A.get_data(), shape = A.get_shape(), step_tag, time_left] {
+        auto temporary = target;
+        temporary += ".tmp";
+
+        const auto file_id = H5Fcreate(temporary.generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        if(file_id < 0) {
+            suanpan_error("Fail to create checkpoint file {}.\n", temporary.generic_string());
+            return;
+        }
+
+        const hsize_t data_size[1] = {data.size()}, shape_size[1] = {shape.size()};
+        H5LTmake_dataset(file_id, "state", 1, data_size, H5T_NATIVE_DOUBLE, data.data());
+        H5LTmake_dataset(file_id, "shape", 1, shape_size, H5T_NATIVE_UINT64, shape.data());
+
+        constexpr auto version = state_checkpoint::version;
+        H5LTset_attribute_uint(file_id, "/", "version", &version, 1);
+        H5LTset_attribute_uint(file_id, "/", "step", &step_tag, 1);
+        H5LTset_attribute_double(file_id, "/", "time_left", &time_left, 1);
+
+        H5Fclose(file_id);
+
+        std::error_code code;
+        fs::rename(temporary, target, code);
+        if(code) suanpan_error("Fail to write checkpoint file {}.\n", target.generic_string());
+    }, D.get());
+
+    return SUANPAN_SUCCESS;
+}
+
+unique_ptr<state_checkpoint> HDF::load() const {
+    // the file may be still written
+    if(const auto& D = get_domain(); nullptr == D) suanpan::output_queue().flush();
+    else suanpan::output_queue().flush(D.get());
+
+    if(!fs::exists(file_name)) {
+        suanpan_error("Cannot find checkpoint file {}.\n", file_name);
+        return nullptr;
+    }
+
+    const auto file_id = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if(file_id < 0) {
+        suanpan_error("Fail to open checkpoint file {}.\n", file_name);
+        return nullptr;
+    }
+
+    unique_ptr<state_checkpoint> checkpoint;
+
+    auto read = [&] {
+        unsigned version = 0;
+        if(1 != H5LTfind_attribute(file_id, "version") || H5LTget_attribute_uint(file_id, "/", "version", &version) < 0 || state_checkpoint::version != version) {
+            suanpan_error("Checkpoint file {} is not written by a compatible version.\n", file_name);
+            return;
+        }
+
+        unsigned step_tag;
+        double time_left;
+        if(H5LTget_attribute_uint(file_id, "/", "step", &step_tag) < 0 || H5LTget_attribute_double(file_id, "/", "time_left", &time_left) < 0) return;
+
+        hsize_t data_size[1], shape_size[1];
+        if(H5LTget_dataset_info(file_id, "state", data_size, nullptr, nullptr) < 0 || H5LTget_dataset_info(file_id, "shape", shape_size, nullptr, nullptr) < 0) return;
+
+        std::vector<double> data(data_size[0]);
+        std::vector<uword> shape(shape_size[0]);
+        if(H5LTread_dataset_double(file_id, "state", data.data()) < 0 || H5LTread_dataset(file_id, "shape", H5T_NATIVE_UINT64, shape.data()) < 0) return;
+
+        checkpoint = std::make_unique<state_checkpoint>(step_tag, time_left, state_archive(std::move(data), std::move(shape)));
+    };
+
+    read();
+
+    H5Fclose(file_id);
+
+    if(nullptr == checkpoint) suanpan_error("Fail to read checkpoint file {}.\n", file_name);
+
+    return checkpoint;
+}
 
 #endif
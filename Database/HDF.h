@@ -14,6 +14,21 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  ******************************************************************************/
+/**
+ * @class HDF
+ * @brief A HDF class writes and reads checkpoints of a domain.
+ *
+ * The state is captured on the calling thread and written by the output thread, so that the analysis does not
+ * wait for the file system. The file is first written to a temporary file which then replaces the target, an
+ * interrupted write does not destroy the previous checkpoint.
+ *
+ * @author tlc
+ * @date 18/10/2026
+ * @version 0.1.0
+ * @file HDF.h
+ * @addtogroup Database
+ * @{
+ */
 
 #ifndef HDF_H
 #define HDF_H
@@ -22,16 +37,25 @@
 
 #include <Database/Database.h>
 
+struct state_checkpoint;
+
 class HDF final : public Database {
-    hid_t file_id;
+    const string file_name;
 
 public:
-    explicit HDF(const char*);
-    ~HDF() override;
+    explicit HDF(string);
 
     int save() override;
+
+    /**
+     * \brief Read the checkpoint, pending writes are completed first.
+     * \return the checkpoint, `nullptr` if the file is not a valid checkpoint
+     */
+    [[nodiscard]] unique_ptr<state_checkpoint> load() const;
 };
 
 #endif
 
 #endif
+
+//! @}
@@ -20,10 +20,12 @@
 #include <Constraint/Criterion/Criterion.h>
 #include <Converger/Converger.h>
 #include <Database/Database.h>
+#include <Database/HDF.h>
 #include <Domain/Factory.hpp>
 #include <Domain/Group/Group.h>
 #include <Domain/Node.h>
 #include <Element/Element.h>
+#include <Element/ElementArena.h>
 #include <Element/Modifier/Modifier.h>
 #include <Element/Utility/Orientation.h>
 #include <Load/Amplitude/Amplitude.h>
@@ -36,9 +38,12 @@
 #include <Step/ArcLength.h>
 #include <Toolbox/sort_color.hpp>
 #include <Toolbox/sort_rcm.h>
+#include <Toolbox/writer_queue.hpp>
 #include <Toolbox/Expression.h>
 #include <numeric>
 
+extern int SUANPAN_NUM_THREADS;
+
 Domain::Domain(const unsigned T)
     : DomainBase(T)
     , factory(make_shared<Factory<double>>())
@@ -60,7 +65,14 @@ bool Domain::insert(const shared_ptr<future<void>>& T) {
     return true;
 }
 
-void Domain::wait() { for(const auto& thread : thread_pond) thread->wait(); }
+void Domain::wait() {
+    for(const auto& thread : thread_pond) thread->wait();
+    suanpan::output_queue().flush(static_cast<const DomainBase*>(this));
+}
+
+void Domain::set_output_path(const fs::path& P) { output_path = P; }
+
+const fs::path& Domain::get_output_path() const { return output_path; }
 
 bool Domain::insert(const shared_ptr<ExternalModule>& E) {
     external_module_pond.emplace_back(E);
@@ -770,8 +782,30 @@ void Domain::set_color_model(const ColorMethod B) {
     color_map.clear();
 }
 
+void Domain::set_frozen_pattern(const bool B) {
+    if(B == frozen_pattern) return;
+    frozen_pattern = B;
+    updated = false;
+}
+
+bool Domain::is_frozen_pattern() const { return frozen_pattern; }
+
+void Domain::set_element_arena(const bool B) {
+    if(B == use_element_arena) return;
+    use_element_arena = B;
+    updated = false;
+}
+
+bool Domain::is_element_arena() const { return use_element_arena; }
+
 const std::vector<std::vector<unsigned>>& Domain::get_color_map() const { return color_map; }
 
+void Domain::share_topology(const shared_ptr<DomainBase>& D) {
+    if(D.get() == this) return;
+    prototype = std::dynamic_pointer_cast<const Domain>(D);
+    updated = false;
+}
+
 std::pair<std::vector<unsigned>, suanpan::graph<unsigned>> Domain::get_element_connectivity(const bool all_elements) {
     // node tag <--> pool of connected elements
     suanpan::unordered_map<uword, suanpan::unordered_set<unsigned>> node_register;
@@ -805,6 +839,20 @@ int Domain::reorder_dof() {
     if(0u == dof_counter) return SUANPAN_FAIL;
     // active flag is now properly set for node and element
 
+    // the identical model shares the same ordering
+    if(nullptr != prototype && prototype->dof_reordering.n_elem == dof_counter) {
+        dof_reordering = prototype->dof_reordering;
+        bandwidth = prototype->bandwidth;
+
+        suanpan::for_all(element_pond.get(), [](const shared_ptr<Element>& t_element) { t_element->update_dof_encoding(); });
+        suanpan::for_all(node_pond.get(), [&](const shared_ptr<Node>& t_node) { t_node->set_reordered_dof(dof_reordering(t_node->get_original_dof())); });
+
+        factory->set_size(dof_counter);
+        factory->set_bandwidth(bandwidth.first, bandwidth.second);
+
+        return SUANPAN_SUCCESS;
+    }
+
     // RCM optimization
     // collect connectivity
     std::vector<suanpan::unordered_set<uword>> adjacency(dof_counter);
@@ -827,30 +875,33 @@ int Domain::reorder_dof() {
     });
 
     const auto idx_rcm = sort_rcm(adjacency);
-    const uvec idx_sorted = sort_index(idx_rcm);
+    dof_reordering = sort_index(idx_rcm);
 
     // get bandwidth
     auto low_bw = 0, up_bw = 0;
     for(unsigned i = 0; i < dof_counter; ++i)
         for(const auto j : adjacency[idx_rcm(i)]) {
-            if(const auto t_bw = static_cast<int>(idx_sorted(j)) - static_cast<int>(i); t_bw > low_bw) low_bw = t_bw;
+            if(const auto t_bw = static_cast<int>(dof_reordering(j)) - static_cast<int>(i); t_bw > low_bw) low_bw = t_bw;
             else if(t_bw < up_bw) up_bw = t_bw;
         }
 
     suanpan_debug("The global matrix has a size of {} with bandwidth {} (lower) and {} (upper).\n", dof_counter, low_bw, -up_bw);
 
     // assign new labels to active nodes
-    suanpan::for_all(node_pond.get(), [&](const shared_ptr<Node>& t_node) { t_node->set_reordered_dof(idx_sorted(t_node->get_original_dof())); });
+    suanpan::for_all(node_pond.get(), [&](const shared_ptr<Node>& t_node) { t_node->set_reordered_dof(dof_reordering(t_node->get_original_dof())); });
+
+    bandwidth = {static_cast<unsigned>(low_bw), static_cast<unsigned>(-up_bw)};
 
     factory->set_size(dof_counter);
-    factory->set_bandwidth(static_cast<unsigned>(low_bw), static_cast<unsigned>(-up_bw));
+    factory->set_bandwidth(bandwidth.first, bandwidth.second);
 
     return SUANPAN_SUCCESS;
 }
 
 int Domain::assign_color() {
     // deal with k-coloring optimization
-    if(ColorMethod::OFF != color_model) {
+    if(ColorMethod::OFF != color_model && nullptr != prototype && prototype->color_model == color_model && !prototype->color_map.empty()) color_map = prototype->color_map;
+    else if(ColorMethod::OFF != color_model) {
         const auto color_algorithm = ColorMethod::WP == color_model ? sort_color_wp<unsigned> : sort_color_mis<unsigned>;
 
         std::vector<unsigned> element_map;
@@ -873,13 +924,148 @@ int Domain::assign_color() {
         factory->set_entry(std::transform_reduce(t_element_pool.cbegin(), t_element_pool.cend(), 1000llu, std::plus(), [](const shared_ptr<Element>& t_element) { return t_element->get_total_number() * t_element->get_total_number(); }));
     }
 
+    assign_sparse_pattern();
+    assign_element_arena();
+
     return SUANPAN_SUCCESS;
 }
 
+/**
+ * \brief Build the sparsity pattern of global matrices from element connectivity and
+ * store the scatter map of each element so that assembly writes into the value array directly.
+ * The pattern is computed once and reused by all subsequent assemblies until the model changes.
+ */
+void Domain::assign_sparse_pattern() const {
+    if(!frozen_pattern || !is_sparse()) {
+        factory->set_sparse_pattern({});
+        return;
+    }
+
+    const auto n_size = factory->get_size();
+
+    triplet_form<double, uword> pattern;
+    if(nullptr != prototype && prototype->factory->get_sparse_pattern().n_rows == n_size) pattern = prototype->factory->get_sparse_pattern();
+    else {
+        pattern = triplet_form<double, uword>(n_size, n_size, factory->get_entry());
+        for(const auto& I : element_pond.get()) {
+            auto& t_encoding = I->get_dof_encoding();
+            pattern.assemble(mat(t_encoding.n_elem, t_encoding.n_elem, fill::ones), t_encoding);
+        }
+        pattern.csc_condense();
+    }
+
+    suanpan::for_all(element_pond.get(), [&](const shared_ptr<Element>& t_element) { t_element->set_sparse_mapping(pattern.locate(t_element->get_dof_encoding())); });
+
+    pattern.zeros_val();
+
+    suanpan_debug("The frozen sparse pattern contains {} entries.\n", pattern.n_elem);
+
+    factory->set_sparse_pattern(std::move(pattern));
+}
+
+/**
+ * \brief Build rigid body modes from nodal coordinates as the near null space for algebraic multigrid.
+ * Translations are assigned to the leading DoFs of each node, rotations are formed about the centroid.
+ * For nodes with rotational DoFs (beams, shells), the rotational DoFs take unit rotations.
+ */
+void Domain::assign_near_null_space() const {
+    auto t_setting = factory->get_solver_setting();
+    t_setting.near_null_space = nullptr;
+
+    if(PreconditionerType::AMG != t_setting.preconditioner_type) {
+        factory->set_solver_setting(t_setting);
+        return;
+    }
+
+    const auto& t_node_pool = node_pond.get();
+
+    uword n_dim = 0;
+    vec center(3, fill::zeros);
+    for(const auto& I : t_node_pool) {
+        const auto& t_coor = I->get_coordinate();
+        n_dim = std::max(n_dim, std::min(t_coor.n_elem, 3llu));
+        center.head(std::min(t_coor.n_elem, 3llu)) += t_coor.head(std::min(t_coor.n_elem, 3llu));
+    }
+    if(!t_node_pool.empty()) center /= static_cast<double>(t_node_pool.size());
+
+    // one rotation in 2D, three rotations in 3D
+    const auto n_mode = n_dim < 2 ? 1llu : 2 == n_dim ? 3llu : 6llu;
+
+    const auto n_size = factory->get_size();
+
+    auto space = std::make_shared<NearNullSpace<double>>();
+    space->basis.zeros(n_size, n_mode);
+    space->group.zeros(n_size);
+
+    uvec covered(n_size, fill::zeros);
+
+    for(uword N = 0; N < t_node_pool.size(); ++N) {
+        const auto& t_node = t_node_pool[N];
+        const auto& t_dof = t_node->get_reordered_dof();
+        vec x(3, fill::zeros);
+        const auto& t_coor = t_node->get_coordinate();
+        x.head(std::min(t_coor.n_elem, 3llu)) = t_coor.head(std::min(t_coor.n_elem, 3llu)) - center.head(std::min(t_coor.n_elem, 3llu));
+
+        for(uword D = 0; D < t_dof.n_elem; ++D) {
+            const auto R = t_dof(D);
+            if(R >= n_size) continue;
+            covered(R) = 1;
+            space->group(R) = N;
+
+            if(D < n_dim) space->basis(R, D) = 1.;
+
+            if(2 == n_dim) {
+                if(0 == D) space->basis(R, 2) = -x(1);
+                else if(1 == D) space->basis(R, 2) = x(0);
+                else if(2 == D) space->basis(R, 2) = 1.;
+            }
+            else if(3 == n_dim) {
+                // rotations about x, y and z axes
+                if(0 == D) {
+                    space->basis(R, 4) = x(2);
+                    space->basis(R, 5) = -x(1);
+                }
+                else if(1 == D) {
+                    space->basis(R, 3) = -x(2);
+                    space->basis(R, 5) = x(0);
+                }
+                else if(2 == D) {
+                    space->basis(R, 3) = x(1);
+                    space->basis(R, 4) = -x(0);
+                }
+                else if(D < 6) space->basis(R, D) = 1.;
+            }
+        }
+    }
+
+    // DoFs not owned by any node (e.g., multipliers) cannot be described, fall back to the default space
+    if(all(covered)) t_setting.near_null_space = std::move(space);
+    else suanpan_debug("Not all DoFs are attached to nodes, the default near null space is used.\n");
+
+    factory->set_solver_setting(t_setting);
+}
+
+/**
+ * \brief Move state containers of all active elements into contiguous pools.
+ * The arena is rebuilt whenever the model changes, the previous one hands memory back to elements first.
+ */
+void Domain::assign_element_arena() {
+    element_arena.reset();
+
+    if(!use_element_arena) return;
+
+    element_arena = std::make_unique<ElementArena>(element_pond.get());
+
+    suanpan_debug("The element arena hosts {} entries.\n", element_arena->get_size());
+}
+
 int Domain::restart() {
     // try to initialize to check if anything changes
     if(SUANPAN_SUCCESS != initialize()) return SUANPAN_FAIL;
 
+    // the solver setting is reset by each step
+    assign_near_null_space();
+
     // try to initialize to check if anything changes
     if(SUANPAN_SUCCESS != factory->initialize()) return SUANPAN_FAIL;
 
@@ -968,6 +1154,9 @@ int Domain::initialize() {
             return;
         }
 
+        // materials and sections copied during initialisation are enrolled to the element for checkpoints
+        const state_registry::scope enrolment(t_element->get_registry());
+
         // if first initialisation fails, the element can be safely deleted
         if(SUANPAN_SUCCESS != t_element->initialize(shared_from_this())) {
             disable_element(t_element->get_tag());
@@ -1001,14 +1190,24 @@ int Domain::initialize() {
     factory->set_nonviscous(nonviscous);
 
     // recorder may depend on groups, nodes, elements, etc.
-    suanpan::for_all(recorder_pond, [&](const dual<Recorder>& t_recorder) { t_recorder.second->initialize(shared_from_this()); });
+    suanpan::for_all(recorder_pond, [&](const dual<Recorder>& t_recorder) {
+        t_recorder.second->set_output(output_path, this);
+        t_recorder.second->initialize(shared_from_this());
+    });
     recorder_pond.update();
 
     suanpan::for_all(criterion_pond, [&](const dual<Criterion>& t_criterion) { t_criterion.second->initialize(shared_from_this()); });
     criterion_pond.update();
 
     // element initialization may change the status of the domain
-    return updated ? assign_color() : initialize();
+    if(!updated) return initialize();
+
+    const auto code = assign_color();
+
+    // the shared preparation only applies to the very first initialisation
+    prototype.reset();
+
+    return code;
 }
 
 int Domain::initialize_load() {
@@ -1091,6 +1290,32 @@ int Domain::initialize_section() {
     return SUANPAN_SUCCESS;
 }
 
+/**
+ * \brief Reduce sparse load contributions into a global vector.
+ * The global vector is split into contiguous DOF ranges, each range is only written by one task so that no locking is required.
+ * Contributions are grouped by range once so that each task only visits its own entries.
+ * Within each range, contributions are added in the order of loads so that the result is deterministic.
+ */
+template<std::invocable<const Load&> F> void reduce_load(vec& global, const std::vector<shared_ptr<Load>>& load_pool, F&& getter) {
+    if(global.empty()) return;
+#ifdef SUANPAN_MT
+    const auto n_chunk = std::min(static_cast<uword>(std::max(1, SUANPAN_NUM_THREADS)), global.n_elem);
+#else
+    constexpr auto n_chunk = 1llu;
+#endif
+    const auto width = (global.n_elem + n_chunk - 1) / n_chunk;
+    const auto n_group = (global.n_elem + width - 1) / width;
+
+    suanpan::for_all(load_pool, [&](const shared_ptr<Load>& J) {
+        if(J->is_initialized()) getter(*J).group(width, n_group);
+    });
+
+    suanpan::for_each(n_group, [&](const uword I) {
+        for(const auto& J : load_pool)
+            if(J->is_initialized()) getter(*J).scatter_group(global, I);
+    });
+}
+
 int Domain::process_load(const bool full) {
     loaded_dofs.clear();
 
@@ -1114,20 +1339,17 @@ int Domain::process_load(const bool full) {
 #else
         code += std::invoke(process_handler, t_load, shared_from_this());
 #endif
-        if(!t_load->get_trial_load().empty() && !trial_load.empty()) {
-            std::scoped_lock trial_load_lock(factory->get_trial_load_mutex());
-            trial_load += t_load->get_trial_load();
-        }
-        if(!t_load->get_trial_settlement().empty() && !trial_settlement.empty()) {
-            std::scoped_lock trial_settlement_lock(factory->get_trial_settlement_mutex());
-            trial_settlement += t_load->get_trial_settlement();
-        }
-        if(!t_load->get_reference_load().empty() && !reference_load.empty()) {
-            std::scoped_lock reference_load_lock(factory->get_reference_load_mutex());
-            reference_load += t_load->get_reference_load();
-        }
     });
 
+    reduce_load(trial_load, load_pond.get(), std::mem_fn(&Load::get_trial_load));
+    reduce_load(trial_settlement, load_pond.get(), std::mem_fn(&Load::get_trial_settlement));
+
+    if(!reference_load.empty()) {
+        vec t_reference(reference_load.n_rows, fill::zeros);
+        reduce_load(t_reference, load_pond.get(), std::mem_fn(&Load::get_reference_load));
+        reference_load = t_reference;
+    }
+
     factory->update_trial_load(trial_load);
     factory->update_trial_settlement(trial_settlement);
 
@@ -1266,6 +1488,82 @@ void Domain::update_constraint() {
 
 void Domain::assemble_load_stiffness() {}
 
-void Domain::assemble_constraint_stiffness() { for(auto& I : get_constraint_pool()) if(I->is_initialized() && !I->get_stiffness().empty()) factory->assemble_stiffness(I->get_stiffness(), I->get_dof_encoding()); }
+void Domain::assemble_constraint_stiffness() {
+    // matrix-free solvers use the stiffness held by each constraint
+    if(nullptr == factory->get_stiffness()) return;
+
+    for(auto& I : get_constraint_pool()) if(I->is_initialized() && !I->get_stiffness().empty()) factory->assemble_stiffness(I->get_stiffness(), I->get_dof_encoding());
+}
+
+/**
+ * \brief Relative file names are placed in the output folder of the domain if one is assigned.
+ */
+string Domain::resolve_output(string file_name) const {
+    if(output_path.empty() || fs::path(file_name).is_absolute()) return file_name;
+    return (output_path / file_name).generic_string();
+}
+
+void Domain::save([[maybe_unused]] string file_name) {
+#ifdef SUANPAN_HDF5
+    if(!is_updated()) {
+        suanpan_warning("The model needs to be initialised before saving a checkpoint.\n");
+        return;
+    }
+
+    HDF database(resolve_output(std::move(file_name)));
+    database.set_domain(shared_from_this());
+    if(SUANPAN_SUCCESS != database.save()) suanpan_error("Fail to save checkpoint.\n");
+#else
+    suanpan_warning("Checkpoints require HDF5 support.\n");
+#endif
+}
+
+void Domain::restore([[maybe_unused]] string file_name) {
+#ifdef SUANPAN_HDF5
+    HDF database(resolve_output(std::move(file_name)));
+    database.set_domain(shared_from_this());
+    if(auto t_checkpoint = database.load(); nullptr != t_checkpoint) checkpoint = std::move(t_checkpoint);
+#else
+    suanpan_warning("Checkpoints require HDF5 support.\n");
+#endif
+}
+
+void Domain::archive(state_archive& A) {
+    // the order shall not depend on the storage
+    auto sorted = []<typename T>(const std::vector<shared_ptr<T>>& pool) {
+        auto t_pool = pool;
+        std::ranges::sort(t_pool, [](const shared_ptr<T>& a, const shared_ptr<T>& b) { return a->get_tag() < b->get_tag(); });
+        return t_pool;
+    };
+
+    factory->archive(A);
+    // the integrator is owned by the step in progress
+    if(find_step(current_step_tag))
+        if(const auto& t_integrator = get_step(current_step_tag)->get_integrator(); nullptr != t_integrator) t_integrator->archive(A);
+    for(const auto& I : sorted(get_node_pool())) I->archive(A);
+    for(const auto& I : sorted(get_element_pool())) I->archive(A);
+    for(const auto& I : sorted(get_constraint_pool())) I->archive(A);
+}
+
+bool Domain::is_restoring() const { return nullptr != checkpoint; }
+
+unsigned Domain::get_restore_step_tag() const { return nullptr == checkpoint ? 0 : checkpoint->step_tag; }
+
+int Domain::apply_restore() {
+    if(nullptr == checkpoint) return SUANPAN_SUCCESS;
+
+    const auto t_checkpoint = std::move(checkpoint);
+
+    archive(t_checkpoint->state);
 
-void Domain::save(string) {}
+    if(!t_checkpoint->state.is_valid()) {
+        suanpan_error("The checkpoint does not match the model.\n");
+        return SUANPAN_FAIL;
+    }
+
+    if(t_checkpoint->step_tag == current_step_tag) get_current_step()->set_time_left(t_checkpoint->time_left);
+
+    suanpan_info("Analysis resumes at time {:.5f}.\n", factory->get_current_time());
+
+    return SUANPAN_SUCCESS;
+}
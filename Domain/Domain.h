@@ -32,12 +32,17 @@
 #include <Domain/Storage.hpp>
 #include <array>
 
+class ElementArena;
+struct state_checkpoint;
+
 using ExternalModuleQueue = std::vector<shared_ptr<ExternalModule>>;
 using ThreadQueue = std::vector<shared_ptr<future<void>>>;
 
 class Domain final : public DomainBase, public std::enable_shared_from_this<Domain> {
     std::atomic_bool updated = false;
     ColorMethod color_model = ColorMethod::MIS;
+    bool frozen_pattern = false;
+    bool use_element_arena = false;
 
     unsigned current_step_tag = 0;
     std::pair<unsigned, unsigned> current_converger_tag{0, 0};  // current converger tag, current step tag
@@ -46,6 +51,8 @@ class Domain final : public DomainBase, public std::enable_shared_from_this<Doma
 
     ThreadQueue thread_pond;
 
+    fs::path output_path; /**< empty to use the global output folder */
+
     // dynamic libraries should be destroyed after all dependent objects are destroyed
     ExternalModuleQueue external_module_pond;
 
@@ -77,10 +84,23 @@ class Domain final : public DomainBase, public std::enable_shared_from_this<Doma
 
     std::vector<std::vector<unsigned>> color_map;
 
+    uvec dof_reordering;                       // new label of each original DoF
+    std::pair<unsigned, unsigned> bandwidth{}; // lower and upper bandwidth
+    shared_ptr<const Domain> prototype;        // domain holding the identical model, its preparation is reused
+
     std::vector<bool> attribute;
 
     mutable std::array<double, 5> statistics{};
 
+    unique_ptr<state_checkpoint> checkpoint; // checkpoint pending to be applied
+
+    // declared last so that element containers are handed back before anything else is destroyed
+    unique_ptr<ElementArena> element_arena;
+
+    void assign_element_arena();
+
+    [[nodiscard]] string resolve_output(string) const;
+
 public:
     explicit Domain(unsigned = 0);
     Domain(const Domain&) = delete;            // copy forbidden
@@ -96,6 +116,9 @@ public:
 
     void wait() override;
 
+    void set_output_path(const fs::path&) override;
+    const fs::path& get_output_path() const override;
+
     bool insert(const shared_ptr<ExternalModule>&) override;
     const ExternalModuleQueue& get_external_module_pool() const override;
 
@@ -325,11 +348,18 @@ public:
     [[nodiscard]] bool get_attribute(ModalAttribute) override;
 
     void set_color_model(ColorMethod) override;
+    void set_frozen_pattern(bool) override;
+    [[nodiscard]] bool is_frozen_pattern() const override;
+    void set_element_arena(bool) override;
+    [[nodiscard]] bool is_element_arena() const override;
     const std::vector<std::vector<unsigned>>& get_color_map() const override;
     std::pair<std::vector<unsigned>, suanpan::graph<unsigned>> get_element_connectivity(bool) override;
+    void share_topology(const shared_ptr<DomainBase>&) override;
 
     int reorder_dof() override;
     int assign_color() override;
+    void assign_sparse_pattern() const;
+    void assign_near_null_space() const;
 
     // restart domain from the previous step
     int restart() override;
@@ -410,6 +440,13 @@ public:
     double stats(const Statistics T) const override { return statistics[static_cast<size_t>(T)]; }
 
     void save(string) override;
+    void restore(string) override;
+
+    void archive(state_archive&) override;
+
+    [[nodiscard]] bool is_restoring() const override;
+    [[nodiscard]] unsigned get_restore_step_tag() const override;
+    int apply_restore() override;
 };
 
 #endif
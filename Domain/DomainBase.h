@@ -61,6 +61,7 @@ class Recorder;
 class Section;
 class Solver;
 class Step;
+class state_archive;
 
 using AmplitudeQueue = std::vector<shared_ptr<Amplitude>>;
 using ExpressionQueue = std::vector<shared_ptr<Expression>>;
@@ -117,8 +118,17 @@ public:
 
     virtual bool insert(const shared_ptr<future<void>>&) = 0;
 
+    /**
+     * \brief Wait for detached tasks and output of this domain.
+     */
     virtual void wait() = 0;
 
+    /**
+     * \brief Set the folder where recorders and checkpoints of this domain write to, empty means the global output folder.
+     */
+    virtual void set_output_path(const fs::path&) = 0;
+    [[nodiscard]] virtual const fs::path& get_output_path() const = 0;
+
     virtual bool insert(const shared_ptr<ExternalModule>&) = 0;
     [[nodiscard]] virtual const std::vector<shared_ptr<ExternalModule>>& get_external_module_pool() const = 0;
 
@@ -356,8 +366,17 @@ public:
     [[nodiscard]] virtual bool get_attribute(ModalAttribute) = 0;
 
     virtual void set_color_model(ColorMethod) = 0;
+    virtual void set_frozen_pattern(bool) = 0;
+    [[nodiscard]] virtual bool is_frozen_pattern() const = 0;
+    virtual void set_element_arena(bool) = 0;
+    [[nodiscard]] virtual bool is_element_arena() const = 0;
     [[nodiscard]] virtual const std::vector<std::vector<unsigned>>& get_color_map() const = 0;
     [[nodiscard]] virtual std::pair<std::vector<unsigned>, suanpan::graph<unsigned>> get_element_connectivity(bool) = 0;
+    /**
+     * \brief Adopt the DoF ordering, colouring and sparse pattern of another domain that holds the identical model.
+     * The graph algorithms are skipped in the next initialisation if the adopted data matches the model.
+     */
+    virtual void share_topology(const shared_ptr<DomainBase>&) = 0;
 
     virtual int reorder_dof() = 0;
     virtual int assign_color() = 0;
@@ -434,7 +453,26 @@ public:
 
     [[nodiscard]] virtual double stats(Statistics) const = 0;
 
+    /**
+     * \brief Write a checkpoint of the complete state to the given file, the file is written by the output thread.
+     */
     virtual void save(string) = 0;
+    /**
+     * \brief Read a checkpoint from the given file, the analysis resumes from it in the next run.
+     */
+    virtual void restore(string) = 0;
+
+    /**
+     * \brief Archive factory, nodes, elements and constraints in ascending order of tags.
+     */
+    virtual void archive(state_archive&) = 0;
+
+    [[nodiscard]] virtual bool is_restoring() const = 0;
+    [[nodiscard]] virtual unsigned get_restore_step_tag() const = 0;
+    /**
+     * \brief Apply the pending checkpoint to the current step, the remaining time of the step is restored if the checkpoint is taken in it.
+     */
+    virtual int apply_restore() = 0;
 };
 
 template<typename T> bool DomainBase::erase(unsigned) { throw invalid_argument("unsupported"); }
@@ -20,9 +20,32 @@
 #include <Domain/Factory.hpp>
 #include <Domain/Node.h>
 #include <Element/Element.h>
+#include <Element/ElementArena.h>
 #include <Load/Load.h>
 #include <Recorder/Recorder.h>
 
+extern int SUANPAN_NUM_THREADS;
+
+/**
+ * \brief Assemble element matrices into a sparse global matrix without a frozen pattern.
+ * Elements are split into contiguous chunks, each chunk is assembled into a private triplet buffer concurrently.
+ * The buffers are then appended to the global matrix so that no locking is required.
+ */
+template<std::invocable<triplet_form<double, uword>&, const shared_ptr<Element>&> F> void assemble_sparse(const std::vector<shared_ptr<Element>>& element_pool, const shared_ptr<MetaMat<double>>& global_mat, F&& assembler) {
+#ifdef SUANPAN_MT
+    if(const auto n_chunk = std::min(static_cast<size_t>(std::max(1, SUANPAN_NUM_THREADS)), element_pool.size()); n_chunk > 1) {
+        std::vector buffer(n_chunk, triplet_form<double, uword>(global_mat->n_rows, global_mat->n_cols));
+        suanpan::for_each(n_chunk, [&](const size_t I) {
+            const auto chunk_end = (I + 1) * element_pool.size() / n_chunk;
+            for(auto J = I * element_pool.size() / n_chunk; J < chunk_end; ++J) assembler(buffer[I], element_pool[J]);
+        });
+        for(const auto& I : buffer) *global_mat += I;
+        return;
+    }
+#endif
+    for(const auto& I : element_pool) assembler(global_mat->triplet_mat, I);
+}
+
 void Domain::update_current_resistance() const {
     factory->modify_trial_resistance().zeros();
     if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_resistance(I->get_current_resistance(), I->get_dof_encoding());
@@ -146,12 +169,13 @@ void Domain::assemble_inertial_force() const {
 
 void Domain::assemble_initial_mass() const {
     factory->clear_mass();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_initial_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_mass(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_initial_mass(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_initial_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_mass(I->get_initial_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_mass(I->get_initial_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -160,12 +184,13 @@ void Domain::assemble_initial_mass() const {
 
 void Domain::assemble_current_mass() const {
     factory->clear_mass();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_current_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_mass(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_current_mass(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_current_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_mass(I->get_current_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_mass(I->get_current_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -174,12 +199,13 @@ void Domain::assemble_current_mass() const {
 
 void Domain::assemble_trial_mass() const {
     factory->clear_mass();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_trial_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_mass(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_trial_mass(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_trial_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_mass(I->get_trial_mass(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_mass(I->get_trial_mass(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -188,12 +214,13 @@ void Domain::assemble_trial_mass() const {
 
 void Domain::assemble_initial_damping() const {
     factory->clear_damping();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_initial_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_damping(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_initial_viscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_initial_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_damping(I->get_initial_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_damping(I->get_initial_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -202,12 +229,13 @@ void Domain::assemble_initial_damping() const {
 
 void Domain::assemble_current_damping() const {
     factory->clear_damping();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_current_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_damping(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_current_viscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_current_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_damping(I->get_current_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_damping(I->get_current_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -216,12 +244,13 @@ void Domain::assemble_current_damping() const {
 
 void Domain::assemble_trial_damping() const {
     factory->clear_damping();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_trial_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_damping(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_trial_viscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_damping(I->get_trial_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_damping(I->get_trial_viscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_damping(I->get_trial_viscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -231,12 +260,13 @@ void Domain::assemble_trial_damping() const {
 void Domain::assemble_initial_nonviscous() const {
     if(!factory->is_nonviscous()) return;
     factory->clear_nonviscous();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_initial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_nonviscous(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_initial_nonviscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_initial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_nonviscous(I->get_initial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_nonviscous(I->get_initial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -246,12 +276,13 @@ void Domain::assemble_initial_nonviscous() const {
 void Domain::assemble_current_nonviscous() const {
     if(!factory->is_nonviscous()) return;
     factory->clear_nonviscous();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_current_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_nonviscous(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_current_nonviscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_current_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_nonviscous(I->get_current_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_nonviscous(I->get_current_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -261,12 +292,13 @@ void Domain::assemble_current_nonviscous() const {
 void Domain::assemble_trial_nonviscous() const {
     if(!factory->is_nonviscous()) return;
     factory->clear_nonviscous();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_trial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_nonviscous(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_trial_nonviscous(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_nonviscous(I->get_trial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_nonviscous(I->get_trial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_nonviscous(I->get_trial_nonviscous(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -275,12 +307,13 @@ void Domain::assemble_trial_nonviscous() const {
 
 void Domain::assemble_initial_stiffness() const {
     factory->clear_stiffness();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_initial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_stiffness(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_initial_stiffness(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_initial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_stiffness(I->get_initial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_stiffness(I->get_initial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -289,12 +322,13 @@ void Domain::assemble_initial_stiffness() const {
 
 void Domain::assemble_current_stiffness() const {
     factory->clear_stiffness();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_stiffness(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_current_stiffness(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -303,12 +337,13 @@ void Domain::assemble_current_stiffness() const {
 
 void Domain::assemble_trial_stiffness() const {
     factory->clear_stiffness();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_trial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_stiffness(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_trial_stiffness(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_trial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_stiffness(I->get_trial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_stiffness(I->get_trial_stiffness(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -318,12 +353,13 @@ void Domain::assemble_trial_stiffness() const {
 void Domain::assemble_initial_geometry() const {
     if(!factory->is_nlgeom()) return;
     factory->clear_geometry();
-    if(color_map.empty() || is_sparse()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_initial_geometry(), I->get_dof_encoding(), I->get_dof_mapping()); }
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_geometry(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { if(I->is_nlgeom()) B.assemble(I->get_initial_geometry(), I->get_dof_encoding()); });
+    else if(color_map.empty()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_initial_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping()); }
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_geometry(I->get_initial_geometry(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_geometry(I->get_initial_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -333,12 +369,13 @@ void Domain::assemble_initial_geometry() const {
 void Domain::assemble_current_geometry() const {
     if(!factory->is_nlgeom()) return;
     factory->clear_geometry();
-    if(color_map.empty() || is_sparse()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_current_geometry(), I->get_dof_encoding(), I->get_dof_mapping()); }
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_geometry(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { if(I->is_nlgeom()) B.assemble(I->get_current_geometry(), I->get_dof_encoding()); });
+    else if(color_map.empty()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_current_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping()); }
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_geometry(I->get_current_geometry(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_geometry(I->get_current_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -348,12 +385,13 @@ void Domain::assemble_current_geometry() const {
 void Domain::assemble_trial_geometry() const {
     if(!factory->is_nlgeom()) return;
     factory->clear_geometry();
-    if(color_map.empty() || is_sparse()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_trial_geometry(), I->get_dof_encoding(), I->get_dof_mapping()); }
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_geometry(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { if(I->is_nlgeom()) B.assemble(I->get_trial_geometry(), I->get_dof_encoding()); });
+    else if(color_map.empty()) { for(const auto& I : element_pond.get()) if(I->is_nlgeom()) factory->assemble_geometry(I->get_trial_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping()); }
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_geometry(I->get_trial_geometry(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_geometry(I->get_trial_geometry(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -362,12 +400,13 @@ void Domain::assemble_trial_geometry() const {
 
 void Domain::assemble_mass_container() const {
     factory->clear_mass();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_mass_container(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_mass(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_mass_container(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_mass(I->get_mass_container(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_mass(I->get_mass_container(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_mass(I->get_mass_container(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -376,12 +415,13 @@ void Domain::assemble_mass_container() const {
 
 void Domain::assemble_stiffness_container() const {
     factory->clear_stiffness();
-    if(color_map.empty() || is_sparse()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_stiffness_container(), I->get_dof_encoding(), I->get_dof_mapping());
+    if(is_sparse() && !factory->has_sparse_pattern()) assemble_sparse(element_pond.get(), factory->get_stiffness(), [](triplet_form<double, uword>& B, const shared_ptr<Element>& I) { B.assemble(I->get_stiffness_container(), I->get_dof_encoding()); });
+    else if(color_map.empty()) for(const auto& I : element_pond.get()) factory->assemble_stiffness(I->get_stiffness_container(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
     else
         std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) {
             suanpan::for_all(color, [&](const unsigned tag) {
                 const auto& I = get_element(tag);
-                factory->assemble_stiffness(I->get_stiffness_container(), I->get_dof_encoding(), I->get_dof_mapping());
+                factory->assemble_stiffness(I->get_stiffness_container(), I->get_dof_encoding(), I->get_dof_mapping(), I->get_sparse_mapping());
             });
         });
 
@@ -458,6 +498,7 @@ int Domain::update_current_status() const {
         t_element->Element::commit_status();
         t_element->commit_status();
     });
+    if(element_arena) element_arena->commit_status();
 
     update_current_resistance();
     if(analysis_type == AnalysisType::DYNAMICS) {
@@ -478,6 +519,7 @@ void Domain::commit_status() const {
         t_element->Element::commit_status();
         t_element->commit_status();
     });
+    if(element_arena) element_arena->commit_status();
     suanpan::for_all(node_pond.get(), [](const shared_ptr<Node>& t_node) { t_node->commit_status(); });
     suanpan::for_all(load_pond.get(), [](const shared_ptr<Load>& t_load) { t_load->commit_status(); });
     suanpan::for_all(constraint_pond.get(), [](const shared_ptr<Constraint>& t_constraint) { t_constraint->commit_status(); });
@@ -516,6 +558,7 @@ void Domain::reset_status() const {
         t_element->Element::reset_status();
         t_element->reset_status();
     });
+    if(element_arena) element_arena->reset_status();
     suanpan::for_all(node_pond.get(), [](const shared_ptr<Node>& t_node) { t_node->reset_status(); });
     suanpan::for_all(load_pond.get(), [](const shared_ptr<Load>& t_load) { t_load->reset_status(); });
     suanpan::for_all(constraint_pond.get(), [](const shared_ptr<Constraint>& t_constraint) { t_constraint->reset_status(); });
@@ -35,6 +35,7 @@
 #include <Toolbox/container.h>
 #include <Element/MappingDOF.h>
 #include <Domain/MetaMat/MetaMat>
+#include <Toolbox/state_archive.h>
 
 #ifdef SUANPAN_MAGMA
 #include <magmasparse.h>
@@ -88,6 +89,8 @@ template<sp_d T> class Factory final {
 
     bool nlgeom = false;
     bool nonviscous = false;
+    bool lumped_mass = false; // mass is stored as a lumped diagonal, other matrices follow the storage scheme
+    bool matrix_free = false;  // global stiffness and geometry are not allocated, products are evaluated by solvers
 
     SolverType solver = SolverType::LAPACK;
     SolverSetting<T> setting{};
@@ -177,6 +180,8 @@ template<sp_d T> class Factory final {
     shared_ptr<MetaMat<T>> global_stiffness = nullptr;  // global stiffness matrix
     shared_ptr<MetaMat<T>> global_geometry = nullptr;   // global geometry matrix
 
+    triplet_form<T, uword> sparse_pattern; // frozen sparsity pattern shared by all global sparse matrices
+
     std::vector<std::mutex> global_mutex{20};
 
     Col<T> eigenvalue; // eigenvalues
@@ -186,7 +191,9 @@ template<sp_d T> class Factory final {
     unique_ptr<MetaMat<T>> get_basic_container();
     unique_ptr<MetaMat<T>> get_matrix_container();
 
-    void assemble_matrix_helper(shared_ptr<MetaMat<T>>&, const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
+    void clear_matrix_helper(const shared_ptr<MetaMat<T>>&);
+
+    void assemble_matrix_helper(shared_ptr<MetaMat<T>>&, const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
 
 public:
     const bool initialized = false;
@@ -205,6 +212,12 @@ public:
     void set_nonviscous(bool);
     [[nodiscard]] bool is_nonviscous() const;
 
+    void set_lumped_mass(bool);
+    [[nodiscard]] bool is_lumped_mass() const;
+
+    void set_matrix_free(bool);
+    [[nodiscard]] bool is_matrix_free() const;
+
     void set_solver_type(SolverType);
     [[nodiscard]] bool contain_solver_type(SolverType) const;
 
@@ -228,6 +241,10 @@ public:
 
     [[nodiscard]] bool is_sparse() const;
 
+    void set_sparse_pattern(triplet_form<T, uword>&&);
+    [[nodiscard]] const triplet_form<T, uword>& get_sparse_pattern() const;
+    [[nodiscard]] bool has_sparse_pattern() const;
+
     void set_bandwidth(unsigned, unsigned);
     [[nodiscard]] std::pair<unsigned, unsigned> get_bandwidth() const;
 
@@ -680,16 +697,21 @@ public:
     void assemble_nonviscous_force(const Mat<T>&, const uvec&);
     void assemble_inertial_force(const Mat<T>&, const uvec&);
 
-    void assemble_mass(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
-    void assemble_damping(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
-    void assemble_nonviscous(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
-    void assemble_stiffness(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
-    void assemble_geometry(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&);
+    void assemble_mass(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
+    void assemble_damping(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
+    void assemble_nonviscous(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
+    void assemble_stiffness(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
+    void assemble_geometry(const Mat<T>&, const uvec&, const std::vector<MappingDOF>&, const uvec&);
 
     void assemble_stiffness(const SpMat<T>&, const uvec&);
 
     /*************************UTILITY*************************/
 
+    /**
+     * \brief Archive time, energy and all state vectors, global matrices are not archived as they are assembled on demand.
+     */
+    void archive(state_archive&) requires std::is_same_v<T, double>;
+
     void print() const;
 };
 
@@ -729,6 +751,22 @@ template<sp_d T> void Factory<T>::set_nonviscous(const bool B) {
 
 template<sp_d T> bool Factory<T>::is_nonviscous() const { return nonviscous; }
 
+template<sp_d T> void Factory<T>::set_lumped_mass(const bool B) {
+    if(B == lumped_mass) return;
+    lumped_mass = B;
+    access::rw(initialized) = false;
+}
+
+template<sp_d T> bool Factory<T>::is_lumped_mass() const { return lumped_mass; }
+
+template<sp_d T> void Factory<T>::set_matrix_free(const bool B) {
+    if(B == matrix_free) return;
+    matrix_free = B;
+    access::rw(initialized) = false;
+}
+
+template<sp_d T> bool Factory<T>::is_matrix_free() const { return matrix_free; }
+
 template<sp_d T> void Factory<T>::set_solver_type(const SolverType E) { solver = E; }
 
 template<sp_d T> void Factory<T>::set_sub_solver_type(const SolverType E) { sub_solver = E; }
@@ -759,6 +797,16 @@ template<sp_d T> StorageScheme Factory<T>::get_storage_scheme() const { return s
 
 template<sp_d T> bool Factory<T>::is_sparse() const { return StorageScheme::SPARSE == storage_type || StorageScheme::SPARSESYMM == storage_type; }
 
+/**
+ * \brief The pattern shall be csc condensed with all values being zero.
+ * An empty pattern disables the frozen pattern mode.
+ */
+template<sp_d T> void Factory<T>::set_sparse_pattern(triplet_form<T, uword>&& P) { sparse_pattern = std::move(P); }
+
+template<sp_d T> const triplet_form<T, uword>& Factory<T>::get_sparse_pattern() const { return sparse_pattern; }
+
+template<sp_d T> bool Factory<T>::has_sparse_pattern() const { return is_sparse() && !sparse_pattern.is_empty() && n_size == sparse_pattern.n_rows; }
+
 template<sp_d T> void Factory<T>::set_bandwidth(const unsigned L, const unsigned U) {
     if(L == n_lobw && U == n_upbw) return;
     n_lobw = L;
@@ -916,7 +964,15 @@ template<sp_d T> void Factory<T>::initialize_auxiliary_resistance() {
     current_constraint_resistance.zeros(n_size);
 }
 
-template<sp_d T> void Factory<T>::initialize_mass() { global_mass = get_matrix_container(); }
+template<sp_d T> void Factory<T>::initialize_mass() {
+    if(!lumped_mass) {
+        global_mass = get_matrix_container();
+        return;
+    }
+
+    global_mass = std::make_unique<DiagMat<T>>(n_size);
+    global_mass->set_solver_setting(setting);
+}
 
 template<sp_d T> void Factory<T>::initialize_damping() { global_damping = get_matrix_container(); }
 
@@ -926,10 +982,14 @@ template<sp_d T> void Factory<T>::initialize_nonviscous() {
     global_nonviscous = get_matrix_container();
 }
 
-template<sp_d T> void Factory<T>::initialize_stiffness() { global_stiffness = get_matrix_container(); }
+template<sp_d T> void Factory<T>::initialize_stiffness() {
+    if(matrix_free) return;
+
+    global_stiffness = get_matrix_container();
+}
 
 template<sp_d T> void Factory<T>::initialize_geometry() {
-    if(!nlgeom) return;
+    if(!nlgeom || matrix_free) return;
 
     global_geometry = get_matrix_container();
 }
@@ -1408,15 +1468,19 @@ template<sp_d T> void Factory<T>::clear_eigen() {
     if(!eigenvector.is_empty()) eigenvector.zeros();
 }
 
-template<sp_d T> void Factory<T>::clear_mass() { if(global_mass != nullptr) global_mass->zeros(); }
+template<sp_d T> void Factory<T>::clear_mass() {
+    // the frozen sparse pattern does not apply to the lumped diagonal
+    if(lumped_mass && nullptr != global_mass) global_mass->zeros();
+    else clear_matrix_helper(global_mass);
+}
 
-template<sp_d T> void Factory<T>::clear_damping() { if(global_damping != nullptr) global_damping->zeros(); }
+template<sp_d T> void Factory<T>::clear_damping() { clear_matrix_helper(global_damping); }
 
-template<sp_d T> void Factory<T>::clear_nonviscous() { if(global_nonviscous != nullptr) global_nonviscous->zeros(); }
+template<sp_d T> void Factory<T>::clear_nonviscous() { clear_matrix_helper(global_nonviscous); }
 
-template<sp_d T> void Factory<T>::clear_stiffness() { if(global_stiffness != nullptr) global_stiffness->zeros(); }
+template<sp_d T> void Factory<T>::clear_stiffness() { clear_matrix_helper(global_stiffness); }
 
-template<sp_d T> void Factory<T>::clear_geometry() { if(global_geometry != nullptr) global_geometry->zeros(); }
+template<sp_d T> void Factory<T>::clear_geometry() { clear_matrix_helper(global_geometry); }
 
 template<sp_d T> void Factory<T>::clear_auxiliary() {
     n_mpc = 0;
@@ -1454,28 +1518,79 @@ template<sp_d T> void Factory<T>::assemble_inertial_force(const Mat<T>& ER, cons
     for(auto I = 0llu; I < EI.n_elem; ++I) trial_inertial_force(EI(I)) += ER(I);
 }
 
-template<sp_d T> void Factory<T>::assemble_matrix_helper(shared_ptr<MetaMat<T>>& GM, const Mat<T>& EM, const uvec& EI, const std::vector<MappingDOF>& MAP) {
+template<sp_d T> void Factory<T>::clear_matrix_helper(const shared_ptr<MetaMat<T>>& GM) {
+    if(nullptr == GM) return;
+
+    // the storage still holds the frozen pattern, only values are cleared
+    if(has_sparse_pattern() && GM->triplet_mat.has_same_pattern(sparse_pattern)) {
+        GM->set_factored(false);
+        GM->triplet_mat.zeros_val();
+        return;
+    }
+
+    GM->zeros();
+
+    // entries outside the frozen pattern have been added or dropped, restore the pattern so that element contributions
+    // can be written into the value array directly
+    if(has_sparse_pattern()) GM->triplet_mat = sparse_pattern;
+}
+
+template<sp_d T> void Factory<T>::assemble_matrix_helper(shared_ptr<MetaMat<T>>& GM, const Mat<T>& EM, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) {
     if(EM.is_empty()) return;
 
+    // the scatter map gives the storage position of each entry of the element matrix in the frozen pattern
+    if(SM.n_elem == EM.n_elem && has_sparse_pattern() && GM->triplet_mat.n_elem >= sparse_pattern.n_elem) {
+        const auto t_val = GM->triplet_mat.val_mem();
+        for(auto I = 0llu; I < SM.n_elem; ++I) t_val[SM(I)] += EM(I);
+        return;
+    }
+
     if(StorageScheme::BANDSYMM == storage_type || StorageScheme::SYMMPACK == storage_type) for(const auto [g_row, g_col, l_row, l_col] : MAP) GM->unsafe_at(g_row, g_col) += EM(l_row, l_col);
     else for(auto I = 0llu; I < EI.n_elem; ++I) for(auto J = 0llu; J < EI.n_elem; ++J) GM->unsafe_at(EI(J), EI(I)) += EM(J, I);
 }
 
-template<sp_d T> void Factory<T>::assemble_mass(const Mat<T>& EM, const uvec& EI, const std::vector<MappingDOF>& MAP) { this->assemble_matrix_helper(global_mass, EM, EI, MAP); }
+/**
+ * \brief Under lumped mass, the element mass is lumped by the HRZ scheme, which scales the diagonal so that the total mass is preserved.
+ * Unlike the row sum, this gives positive entries for quadratic elements, as long as the consistent diagonal is positive.
+ * Element matrices that are already diagonal are kept as they are.
+ */
+template<sp_d T> void Factory<T>::assemble_mass(const Mat<T>& EM, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) {
+    if(!lumped_mass) return this->assemble_matrix_helper(global_mass, EM, EI, MAP, SM);
+
+    if(EM.is_empty()) return;
+
+    const Col<T> diagonal = EM.diag();
+    const auto diagonal_sum = accu(diagonal);
+    // massless element
+    if(diagonal_sum <= T(0)) return;
+
+    const Col<T> lumped = diagonal * (accu(EM) / diagonal_sum);
+    for(auto I = 0llu; I < EI.n_elem; ++I) global_mass->unsafe_at(EI(I), EI(I)) += lumped(I);
+}
 
-template<sp_d T> void Factory<T>::assemble_damping(const Mat<T>& EC, const uvec& EI, const std::vector<MappingDOF>& MAP) { this->assemble_matrix_helper(global_damping, EC, EI, MAP); }
+template<sp_d T> void Factory<T>::assemble_damping(const Mat<T>& EC, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) { this->assemble_matrix_helper(global_damping, EC, EI, MAP, SM); }
 
-template<sp_d T> void Factory<T>::assemble_nonviscous(const Mat<T>& EC, const uvec& EI, const std::vector<MappingDOF>& MAP) { this->assemble_matrix_helper(global_nonviscous, EC, EI, MAP); }
+template<sp_d T> void Factory<T>::assemble_nonviscous(const Mat<T>& EC, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) { this->assemble_matrix_helper(global_nonviscous, EC, EI, MAP, SM); }
 
-template<sp_d T> void Factory<T>::assemble_stiffness(const Mat<T>& EK, const uvec& EI, const std::vector<MappingDOF>& MAP) { this->assemble_matrix_helper(global_stiffness, EK, EI, MAP); }
+template<sp_d T> void Factory<T>::assemble_stiffness(const Mat<T>& EK, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) { this->assemble_matrix_helper(global_stiffness, EK, EI, MAP, SM); }
 
-template<sp_d T> void Factory<T>::assemble_geometry(const Mat<T>& EG, const uvec& EI, const std::vector<MappingDOF>& MAP) { this->assemble_matrix_helper(global_geometry, EG, EI, MAP); }
+template<sp_d T> void Factory<T>::assemble_geometry(const Mat<T>& EG, const uvec& EI, const std::vector<MappingDOF>& MAP, const uvec& SM) { this->assemble_matrix_helper(global_geometry, EG, EI, MAP, SM); }
 
 template<sp_d T> void Factory<T>::assemble_stiffness(const SpMat<T>& EK, const uvec& EI) {
     if(EK.is_empty()) return;
     for(auto I = EK.begin(); I != EK.end(); ++I) global_stiffness->at(EI(I.row()), EI(I.col())) += *I;
 }
 
+template<sp_d T> void Factory<T>::archive(state_archive& A) requires std::is_same_v<T, double> {
+    A(trial_time, incre_time, current_time, pre_time);
+    A(strain_energy, kinetic_energy, viscous_energy, nonviscous_energy, complementary_energy, momentum);
+    A(trial_load_factor, trial_load, trial_settlement, trial_resistance, trial_damping_force, trial_nonviscous_force, trial_inertial_force, trial_displacement, trial_velocity, trial_acceleration, trial_temperature);
+    A(incre_load_factor, incre_load, incre_settlement, incre_resistance, incre_damping_force, incre_nonviscous_force, incre_inertial_force, incre_displacement, incre_velocity, incre_acceleration, incre_temperature);
+    A(current_load_factor, current_load, current_settlement, current_resistance, current_damping_force, current_nonviscous_force, current_inertial_force, current_displacement, current_velocity, current_acceleration, current_temperature);
+    A(pre_load_factor, pre_load, pre_settlement, pre_resistance, pre_damping_force, pre_nonviscous_force, pre_inertial_force, pre_displacement, pre_velocity, pre_acceleration, pre_temperature);
+    A(eigenvalue, eigenvector);
+}
+
 template<sp_d T> void Factory<T>::print() const {
     suanpan_info("A Factory object with size of {}.\n", n_size);
 }
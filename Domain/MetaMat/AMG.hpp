@@ -0,0 +1,523 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class AMG
+ * @brief A AMG class.
+ *
+ * Smoothed aggregation algebraic multigrid preconditioner.
+ *
+ * DoFs are grouped into nodes, a node level strength graph is built from
+ * Frobenius norms of nodal blocks and nodes are aggregated in three passes.
+ * The tentative prolongator interpolates the near null space (e.g., rigid
+ * body modes) exactly on each aggregate and is smoothed by one damped Jacobi
+ * step. Each level is smoothed by a Chebyshev polynomial in
+ * \f$D^{-1}A\f$, which keeps the V-cycle symmetric so that it can be
+ * used with CG.
+ *
+ * The aggregates and tentative prolongators are kept and reused if the next
+ * matrix shares the same structural pattern, in which case only smoothed
+ * prolongators and Galerkin products are recomputed. Zero-valued entries
+ * are part of the structural pattern.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file AMG.hpp
+ * @addtogroup Preconditioner
+ * @{
+ */
+
+#ifndef AMG_HPP
+#define AMG_HPP
+
+#include "Preconditioner.hpp"
+#include "SolverSetting.hpp"
+#include "triplet_form.hpp"
+
+template<sp_d data_t> class AMG final : public Preconditioner<data_t> {
+    static constexpr uword coarse_size = 1000;
+    static constexpr uword max_dense_size = 5000;
+    static constexpr uword max_level = 10;
+    static constexpr unsigned smoother_degree = 2;
+    static constexpr data_t strength_threshold = data_t(.08);
+
+    struct Level {
+        triplet_form<data_t, uword> A, P, R;
+        Col<data_t> inv_diag;
+        data_t lambda = data_t(1);
+        SpMat<data_t> T; // tentative prolongator, only depends on the pattern
+    };
+
+    shared_ptr<const NearNullSpace<data_t>> null_space;
+
+    SpMat<data_t> fine_mat;
+
+    u64 pattern_hash = 0, hierarchy_hash = 0;
+
+    unsigned symbolic_counter = 0;
+    unsigned numeric_counter = 0;
+
+    std::vector<Level> levels;
+
+    Mat<data_t> coarse_factor;
+    bool coarse_cholesky = false;
+
+    template<sp_i index_t> static SpMat<data_t> to_sp_mat(const triplet_form<data_t, index_t>&);
+    static triplet_form<data_t, uword> to_triplet(const SpMat<data_t>&);
+    static u64 hash(const SpMat<data_t>&);
+
+    static std::pair<uvec, uword> aggregate(const SpMat<data_t>&, const uvec&, uword);
+    static std::pair<SpMat<data_t>, Mat<data_t>> tentative(const uvec&, uword, const Mat<data_t>&);
+
+    void prepare_level(Level&, const SpMat<data_t>&) const;
+    SpMat<data_t> galerkin(Level&, const SpMat<data_t>&) const;
+    void factorise_coarse(const SpMat<data_t>&);
+
+    void chebyshev(const Level&, Col<data_t>&, const Col<data_t>&) const;
+    Col<data_t> cycle(uword, const Col<data_t>&) const;
+
+    int build();
+    int rebuild();
+
+public:
+    explicit AMG(shared_ptr<const NearNullSpace<data_t>> = nullptr);
+
+    template<sp_i index_t> void set_matrix(const triplet_form<data_t, index_t>&);
+
+    [[nodiscard]] uword get_level() const;
+
+    /**
+     * \brief Number of full setups performed, i.e., aggregation and tentative prolongators
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_symbolic_counter() const { return symbolic_counter; }
+
+    /**
+     * \brief Number of setups performed, including the ones that reuse the hierarchy
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_numeric_counter() const { return numeric_counter; }
+
+    int init() override;
+
+    [[nodiscard]] Col<data_t> apply(const Col<data_t>&) override;
+};
+
+template<sp_d data_t> template<sp_i index_t> SpMat<data_t> AMG<data_t>::to_sp_mat(const triplet_form<data_t, index_t>& in_mat) {
+    umat locations(2, in_mat.n_elem);
+    Col<data_t> values(in_mat.n_elem);
+
+    suanpan::for_each(in_mat.n_elem, [&](const index_t I) {
+        locations(0, I) = uword(in_mat.row(I));
+        locations(1, I) = uword(in_mat.col(I));
+        values(I) = in_mat.val(I);
+    });
+
+    // zeros are kept so that the pattern is structural
+    return SpMat<data_t>(true, locations, values, uword(in_mat.n_rows), uword(in_mat.n_cols), true, false);
+}
+
+template<sp_d data_t> triplet_form<data_t, uword> AMG<data_t>::to_triplet(const SpMat<data_t>& in_mat) {
+    in_mat.sync();
+
+    triplet_form<data_t, uword> out_mat(in_mat.n_rows, in_mat.n_cols, in_mat.n_nonzero);
+    for(uword J = 0; J < in_mat.n_cols; ++J) for(auto I = in_mat.col_ptrs[J]; I < in_mat.col_ptrs[J + 1]; ++I) out_mat.at(in_mat.row_indices[I], J) = in_mat.values[I];
+    out_mat.csr_condense();
+
+    return out_mat;
+}
+
+template<sp_d data_t> u64 AMG<data_t>::hash(const SpMat<data_t>& in_mat) {
+    in_mat.sync();
+
+    // FNV-1a over the compressed pattern
+    u64 value = 14695981039346656037llu;
+    auto mix = [&](const u64 in) { value = (value ^ in) * 1099511628211llu; };
+
+    mix(in_mat.n_rows);
+    mix(in_mat.n_cols);
+    for(uword I = 0; I <= in_mat.n_cols; ++I) mix(in_mat.col_ptrs[I]);
+    for(uword I = 0; I < in_mat.n_nonzero; ++I) mix(in_mat.row_indices[I]);
+
+    return value;
+}
+
+/**
+ * \brief Aggregate nodes based on the strength of nodal blocks.
+ * \param A system matrix, assumed to be structurally symmetric
+ * \param group node index of each DoF
+ * \param n_group number of nodes
+ * \return aggregate index of each node and the number of aggregates
+ */
+template<sp_d data_t> std::pair<uvec, uword> AMG<data_t>::aggregate(const SpMat<data_t>& A, const uvec& group, const uword n_group) {
+    A.sync();
+
+    const uvec order = stable_sort_index(group);
+    uvec node_ptr(n_group + 1, fill::zeros);
+    for(const auto I : group) ++node_ptr(I + 1);
+    node_ptr = cumsum(node_ptr);
+
+    // squared Frobenius norm of each nodal block
+    std::vector<std::vector<std::pair<uword, data_t>>> node_graph(n_group);
+    Col<data_t> node_diag(n_group, fill::zeros);
+
+    suanpan::for_each(n_group, [&](const uword I) {
+        auto& t_row = node_graph[I];
+        for(auto K = node_ptr(I); K < node_ptr(I + 1); ++K) {
+            const auto C = order(K);
+            for(auto J = A.col_ptrs[C]; J < A.col_ptrs[C + 1]; ++J) t_row.emplace_back(group(A.row_indices[J]), A.values[J] * A.values[J]);
+        }
+
+        if(t_row.empty()) return;
+
+        std::ranges::sort(t_row, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        size_t current = 0;
+        for(size_t J = 1; J < t_row.size(); ++J)
+            if(t_row[J].first == t_row[current].first) t_row[current].second += t_row[J].second;
+            else t_row[++current] = t_row[J];
+        t_row.resize(current + 1);
+
+        for(const auto& [J, V] : t_row)
+            if(J == I) node_diag(I) = V;
+    });
+
+    constexpr auto theta = strength_threshold * strength_threshold * strength_threshold * strength_threshold;
+
+    std::vector<std::vector<uword>> strong(n_group);
+
+    suanpan::for_each(n_group, [&](const uword I) {
+        for(const auto& [J, V] : node_graph[I])
+            if(J != I && V > data_t(0) && V * V >= theta * node_diag(I) * node_diag(J)) strong[I].emplace_back(J);
+        std::vector<std::pair<uword, data_t>>().swap(node_graph[I]);
+    });
+
+    constexpr auto unassigned = std::numeric_limits<uword>::max();
+
+    uvec node_agg(n_group);
+    node_agg.fill(unassigned);
+    uword n_agg = 0;
+
+    // pass one: nodes whose strong neighbours are all free form new aggregates
+    for(uword I = 0; I < n_group; ++I) {
+        if(unassigned != node_agg(I) || strong[I].empty()) continue;
+        if(std::ranges::any_of(strong[I], [&](const uword J) { return unassigned != node_agg(J); })) continue;
+        node_agg(I) = n_agg;
+        for(const auto J : strong[I]) node_agg(J) = n_agg;
+        ++n_agg;
+    }
+
+    // pass two: remaining nodes join a neighbouring aggregate
+    const uvec first_pass = node_agg;
+    for(uword I = 0; I < n_group; ++I) {
+        if(unassigned != node_agg(I)) continue;
+        for(const auto J : strong[I])
+            if(unassigned != first_pass(J)) {
+                node_agg(I) = first_pass(J);
+                break;
+            }
+    }
+
+    // pass three: leftover nodes form aggregates with their free neighbours
+    for(uword I = 0; I < n_group; ++I) {
+        if(unassigned != node_agg(I)) continue;
+        node_agg(I) = n_agg;
+        for(const auto J : strong[I])
+            if(unassigned == node_agg(J)) node_agg(J) = n_agg;
+        ++n_agg;
+    }
+
+    return {node_agg, n_agg};
+}
+
+/**
+ * \brief Form the tentative prolongator by orthogonalising the near null space on each aggregate.
+ * \param dof_agg aggregate index of each DoF
+ * \param n_agg number of aggregates
+ * \param B near null space
+ * \return tentative prolongator and coarse near null space
+ */
+template<sp_d data_t> std::pair<SpMat<data_t>, Mat<data_t>> AMG<data_t>::tentative(const uvec& dof_agg, const uword n_agg, const Mat<data_t>& B) {
+    const auto n_mode = B.n_cols;
+
+    const uvec order = stable_sort_index(dof_agg);
+    uvec agg_ptr(n_agg + 1, fill::zeros);
+    for(const auto I : dof_agg) ++agg_ptr(I + 1);
+    agg_ptr = cumsum(agg_ptr);
+
+    umat locations(2, B.n_rows * n_mode);
+    Col<data_t> values(B.n_rows * n_mode);
+    Mat<data_t> coarse_basis(n_agg * n_mode, n_mode, fill::zeros);
+
+    suanpan::for_each(n_agg, [&](const uword I) {
+        const auto n_dof = agg_ptr(I + 1) - agg_ptr(I);
+        const uvec dof = order.subvec(agg_ptr(I), agg_ptr(I + 1) - 1);
+
+        Mat<data_t> Q, R;
+        if(!arma::qr_econ(Q, R, Mat<data_t>(B.rows(dof)))) {
+            Q.zeros(n_dof, std::min(n_dof, n_mode));
+            R.zeros(Q.n_cols, n_mode);
+        }
+
+        coarse_basis.submat(I * n_mode, 0, I * n_mode + R.n_rows - 1, n_mode - 1) = R;
+
+        const auto offset = agg_ptr(I) * n_mode;
+        for(uword C = 0; C < n_mode; ++C)
+            for(uword K = 0; K < n_dof; ++K) {
+                const auto pos = offset + C * n_dof + K;
+                locations(0, pos) = dof(K);
+                locations(1, pos) = I * n_mode + C;
+                values(pos) = C < Q.n_cols ? Q(K, C) : data_t(0);
+            }
+    });
+
+    return {SpMat<data_t>(locations, values, B.n_rows, n_agg * n_mode, true, true), std::move(coarse_basis)};
+}
+
+template<sp_d data_t> void AMG<data_t>::prepare_level(Level& level, const SpMat<data_t>& A) const {
+    level.A = to_triplet(A);
+
+    const Col<data_t> diag(A.diag());
+    level.inv_diag.set_size(diag.n_elem);
+    suanpan::for_each(diag.n_elem, [&](const uword I) { level.inv_diag(I) = suanpan::approx_equal(diag(I), data_t(0)) ? data_t(0) : data_t(1) / diag(I); });
+
+    // Lanczos iteration for the spectral radius of D^{-1/2}AD^{-1/2}, which shares the spectrum of D^{-1}A
+    const Col<data_t> scale = arma::sqrt(arma::abs(level.inv_diag));
+
+    Col<data_t> v(diag.n_elem), pre_v(diag.n_elem, fill::zeros);
+    suanpan::for_each(v.n_elem, [&](const uword I) { v(I) = data_t(1) + data_t(I % 7) / data_t(7); });
+    v /= arma::norm(v);
+
+    std::vector<data_t> alpha, beta;
+    for(auto I = 0; I < 20; ++I) {
+        Col<data_t> w = scale % Col<data_t>(level.A * Col<data_t>(scale % v));
+        alpha.emplace_back(arma::dot(w, v));
+        w -= alpha.back() * v;
+        if(!beta.empty()) w -= beta.back() * pre_v;
+        const auto t_norm = arma::norm(w);
+        if(t_norm < std::numeric_limits<data_t>::epsilon() * std::fabs(alpha.back())) break;
+        beta.emplace_back(t_norm);
+        pre_v = std::move(v);
+        v = w / t_norm;
+    }
+
+    Mat<data_t> tridiagonal(alpha.size(), alpha.size(), fill::zeros);
+    for(size_t I = 0; I < alpha.size(); ++I) {
+        tridiagonal(I, I) = alpha[I];
+        if(I + 1 < alpha.size()) tridiagonal(I, I + 1) = tridiagonal(I + 1, I) = beta[I];
+    }
+
+    level.lambda = alpha.empty() ? data_t(1) : arma::max(arma::abs(Col<data_t>(arma::eig_sym(tridiagonal))));
+    if(suanpan::approx_equal(level.lambda, data_t(0))) level.lambda = data_t(1);
+}
+
+/**
+ * \brief Smooth the tentative prolongator of the given level and compute the coarse operator.
+ */
+template<sp_d data_t> SpMat<data_t> AMG<data_t>::galerkin(Level& level, const SpMat<data_t>& A) const {
+    const auto n_size = A.n_rows;
+
+    umat locations(2, n_size);
+    locations.row(0) = regspace<urowvec>(0, n_size - 1);
+    locations.row(1) = locations.row(0);
+    const SpMat<data_t> inv_diag(locations, level.inv_diag, n_size, n_size);
+
+    const auto omega = data_t(4) / data_t(3) / level.lambda;
+
+    const SpMat<data_t> P = level.T - omega * (inv_diag * (A * level.T));
+    SpMat<data_t> R = P.t();
+
+    SpMat<data_t> coarse_mat = R * (A * P);
+
+    level.P = to_triplet(P);
+    level.R = to_triplet(R);
+
+    return coarse_mat;
+}
+
+template<sp_d data_t> void AMG<data_t>::factorise_coarse(const SpMat<data_t>& A) {
+    coarse_factor.reset();
+
+    if(A.n_rows > max_dense_size) return;
+
+    Mat<data_t> dense(A);
+    // isolated DoFs from rank deficient aggregates
+    for(uword I = 0; I < dense.n_rows; ++I)
+        if(suanpan::approx_equal(dense(I, I), data_t(0))) dense(I, I) = data_t(1);
+
+    if((coarse_cholesky = arma::chol(coarse_factor, dense))) return;
+
+    if(!arma::inv(coarse_factor, dense)) coarse_factor = arma::pinv(dense);
+}
+
+/**
+ * \brief Chebyshev smoother targeting the upper part of the spectrum of \f$D^{-1}A\f$.
+ */
+template<sp_d data_t> void AMG<data_t>::chebyshev(const Level& level, Col<data_t>& x, const Col<data_t>& b) const {
+    const auto upper = data_t(1.1) * level.lambda, lower = upper / data_t(30);
+    const auto theta = data_t(.5) * (upper + lower), delta = data_t(.5) * (upper - lower);
+    const auto sigma = theta / delta;
+
+    auto rho = data_t(1) / sigma;
+
+    Col<data_t> r = level.inv_diag % (b - level.A * x);
+    Col<data_t> d = r / theta;
+
+    for(auto K = 1u; K <= smoother_degree; ++K) {
+        x += d;
+        if(smoother_degree == K) break;
+        r -= level.inv_diag % Col<data_t>(level.A * d);
+        const auto rho_new = data_t(1) / (data_t(2) * sigma - rho);
+        d = rho_new * rho * d + data_t(2) * rho_new / delta * r;
+        rho = rho_new;
+    }
+}
+
+template<sp_d data_t> Col<data_t> AMG<data_t>::cycle(const uword L, const Col<data_t>& b) const {
+    const auto& level = levels[L];
+
+    Col<data_t> x(b.n_elem, fill::zeros);
+
+    if(L + 1 == levels.size()) {
+        if(coarse_factor.empty())
+            for(auto I = 0; I < 5; ++I) chebyshev(level, x, b);
+        else if(coarse_cholesky) x = arma::solve(arma::trimatu(coarse_factor), arma::solve(arma::trimatl(coarse_factor.t()), b));
+        else x = coarse_factor * b;
+        return x;
+    }
+
+    chebyshev(level, x, b);
+
+    const Col<data_t> r = b - level.A * x;
+
+    x += level.P * cycle(L + 1, level.R * r);
+
+    chebyshev(level, x, b);
+
+    return x;
+}
+
+template<sp_d data_t> int AMG<data_t>::build() {
+    levels.clear();
+
+    auto A = fine_mat;
+
+    Mat<data_t> B;
+    uvec group;
+    if(null_space && null_space->basis.n_rows == A.n_rows && null_space->group.n_elem == A.n_rows) {
+        B = null_space->basis;
+        group = null_space->group;
+    }
+    else {
+        B.ones(A.n_rows, 1);
+        group = regspace<uvec>(0, A.n_rows - 1);
+    }
+    auto n_group = group.empty() ? 0 : group.max() + 1;
+
+    while(true) {
+        auto& level = levels.emplace_back();
+
+        prepare_level(level, A);
+
+        if(A.n_rows <= coarse_size || levels.size() >= max_level) break;
+
+        const auto [node_agg, n_agg] = aggregate(A, group, n_group);
+
+        // stop if coarsening stagnates
+        if(5 * n_agg * B.n_cols > 4 * A.n_rows) break;
+
+        auto [T, coarse_basis] = tentative(node_agg.elem(group), n_agg, B);
+
+        level.T = std::move(T);
+
+        A = galerkin(level, A);
+
+        B = std::move(coarse_basis);
+        group = regspace<uvec>(0, A.n_rows - 1) / B.n_cols;
+        n_group = n_agg;
+    }
+
+    factorise_coarse(A);
+
+    suanpan_debug("AMG hierarchy contains {} levels with a coarse size of {}.\n", levels.size(), A.n_rows);
+
+    return SUANPAN_SUCCESS;
+}
+
+template<sp_d data_t> int AMG<data_t>::rebuild() {
+    auto A = fine_mat;
+
+    for(uword I = 0; I < levels.size(); ++I) {
+        prepare_level(levels[I], A);
+        if(I + 1 < levels.size()) A = galerkin(levels[I], A);
+    }
+
+    factorise_coarse(A);
+
+    return SUANPAN_SUCCESS;
+}
+
+template<sp_d data_t> AMG<data_t>::AMG(shared_ptr<const NearNullSpace<data_t>> in_space)
+    : Preconditioner<data_t>()
+    , null_space(std::move(in_space)) {}
+
+/**
+ * \brief Assign the system matrix, the hierarchy is kept if the sparsity pattern is unchanged.
+ */
+template<sp_d data_t> template<sp_i index_t> void AMG<data_t>::set_matrix(const triplet_form<data_t, index_t>& in_mat) {
+    fine_mat = to_sp_mat(in_mat);
+    pattern_hash = hash(fine_mat);
+}
+
+template<sp_d data_t> uword AMG<data_t>::get_level() const { return levels.size(); }
+
+template<sp_d data_t> int AMG<data_t>::init() {
+    if(0 == fine_mat.n_rows) {
+        suanpan_error("AMG requires a valid system matrix.\n");
+        return SUANPAN_FAIL;
+    }
+
+    const auto reuse = !levels.empty() && hierarchy_hash == pattern_hash;
+
+    if(!reuse) ++symbolic_counter;
+    ++numeric_counter;
+
+    const auto code = reuse ? rebuild() : build();
+
+    hierarchy_hash = pattern_hash;
+
+    // no longer needed once the hierarchy is formed
+    fine_mat.reset();
+
+    return code;
+}
+
+template<sp_d data_t> Col<data_t> AMG<data_t>::apply(const Col<data_t>& in) {
+    if(levels.empty()) return in;
+
+    const auto n_size = levels.front().inv_diag.n_elem;
+
+    Col<data_t> out(arma::size(in), fill::none);
+
+    for(auto I = 0llu; I < in.n_elem; I += n_size) out.subvec(I, arma::size(n_size, 1)) = cycle(0, in.subvec(I, arma::size(n_size, 1)));
+
+    return out;
+}
+
+#endif
+
+//! @}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class DiagMat
+ * @brief A DiagMat class that holds diagonal matrices.
+ *
+ * Only the diagonal is stored, off-diagonal entries are silently discarded.
+ * It is meant to hold lumped mass matrices in explicit dynamics, so that
+ * solving the system reduces to a vectorised division. Thus, all diagonal
+ * entries shall be positive.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file DiagMat.hpp
+ * @addtogroup MetaMat
+ * @{
+ */
+
+#ifndef DIAGMAT_HPP
+#define DIAGMAT_HPP
+
+#include "DenseMat.hpp"
+
+template<sp_d T> class DiagMat final : public DenseMat<T> {
+    T bin = T(0);
+
+    [[nodiscard]] Col<T> diag_view() const { return Col<T>(const_cast<T*>(this->memptr()), this->n_rows, false, true); }
+
+protected:
+    using DenseMat<T>::direct_solve;
+
+    int direct_solve(Mat<T>&, Mat<T>&&) override;
+
+public:
+    explicit DiagMat(const uword in_size)
+        : DenseMat<T>(in_size, in_size, in_size) {}
+
+    unique_ptr<MetaMat<T>> make_copy() override { return std::make_unique<DiagMat>(*this); }
+
+    void nullify(const uword K) override {
+        this->factored = false;
+        this->memory[K] = T(0);
+    }
+
+    [[nodiscard]] Col<T> diag() const override { return Col<T>(this->memptr(), this->n_rows); }
+
+    T operator()(const uword in_row, const uword in_col) const override { return in_row == in_col ? this->memory[in_row] : T(0); }
+
+    T& at(const uword in_row, const uword in_col) override {
+        if(in_row != in_col) [[unlikely]] return bin = T(0);
+        this->factored = false;
+        return this->memory[in_row];
+    }
+
+    Mat<T> operator*(const Mat<T>& X) const override { return X.each_col() % diag_view(); }
+
+    [[nodiscard]] int sign_det() const override {
+        auto det_sign = 1;
+        for(uword I = 0; I < this->n_rows; ++I) if(this->memory[I] < T(0)) det_sign = -det_sign;
+        return det_sign;
+    }
+};
+
+template<sp_d T> int DiagMat<T>::direct_solve(Mat<T>& X, Mat<T>&& B) {
+    const auto D = diag_view();
+
+    // a lumped mass shall be positive definite
+    if(any(D <= T(0))) {
+        suanpan_error("Non-positive diagonal entry detected, the lumped matrix is not positive definite.\n");
+        return SUANPAN_FAIL;
+    }
+
+    B.each_col() /= D;
+    X = std::move(B);
+
+    return SUANPAN_SUCCESS;
+}
+
+#endif
+
+//! @}
@@ -62,6 +62,8 @@ public:
     }
 
     Mat<T> operator*(const Mat<T>&) const override;
+
+    [[nodiscard]] uword inertia() override;
 };
 
 template<sp_d T> Mat<T> FullMat<T>::operator*(const Mat<T>& B) const {
@@ -100,6 +102,55 @@ template<sp_d T> Mat<T> FullMat<T>::operator*(const Mat<T>& B) const {
     return C;
 }
 
+/**
+ * \brief The LU factorisation used for solving does not reveal the inertia, a Bunch--Kaufman \f$LDL^T\f$ factorisation
+ * is performed on a copy instead. Thus, it shall be called before the matrix is factorised.
+ */
+template<sp_d T> uword FullMat<T>::inertia() {
+    if(IterativeSolver::NONE != this->setting.iterative_solver) throw invalid_argument("analysis requires the inertia but iterative solver does not support it");
+    if(this->factored) throw invalid_argument("inertia is not available from the LU factorisation");
+
+    static constexpr char UPLO = 'L';
+
+    Mat<T> D(this->memptr(), this->n_rows, this->n_cols);
+
+    const auto N = static_cast<int>(this->n_rows);
+    podarray<int> IPIV(N);
+    auto LWORK = -1, INFO = 0;
+    T WORK_SIZE;
+
+    if constexpr(std::is_same_v<T, float>) {
+        using E = float;
+        arma_fortran(arma_ssytrf)(&UPLO, &N, (E*)D.memptr(), &N, IPIV.memptr(), (E*)&WORK_SIZE, &LWORK, &INFO);
+        podarray<T> WORK(LWORK = static_cast<int>(WORK_SIZE));
+        arma_fortran(arma_ssytrf)(&UPLO, &N, (E*)D.memptr(), &N, IPIV.memptr(), (E*)WORK.memptr(), &LWORK, &INFO);
+    }
+    else {
+        using E = double;
+        arma_fortran(arma_dsytrf)(&UPLO, &N, (E*)D.memptr(), &N, IPIV.memptr(), (E*)&WORK_SIZE, &LWORK, &INFO);
+        podarray<T> WORK(LWORK = static_cast<int>(WORK_SIZE));
+        arma_fortran(arma_dsytrf)(&UPLO, &N, (E*)D.memptr(), &N, IPIV.memptr(), (E*)WORK.memptr(), &LWORK, &INFO);
+    }
+
+    // a positive INFO indicates an exactly zero pivot, which does not affect the count of negative pivots
+    if(INFO < 0) throw invalid_argument("fail to factorise the matrix");
+
+    uword counter = 0;
+    for(auto I = 0; I < N; ++I) {
+        if(IPIV[I] > 0) {
+            if(D(I, I) < T(0)) ++counter;
+            continue;
+        }
+        // 2 by 2 diagonal block
+        const auto a = D(I, I), b = D(I + 1, I), c = D(I + 1, I + 1);
+        if(const auto det = a * c - b * b; det < T(0)) ++counter;
+        else if(a + c < T(0)) counter += det > T(0) ? 2 : 1;
+        ++I;
+    }
+
+    return counter;
+}
+
 template<sp_d T> int FullMat<T>::direct_solve(Mat<T>& X, Mat<T>&& B) {
     if(this->factored) return this->solve_trs(X, std::forward<Mat<T>>(B));
 
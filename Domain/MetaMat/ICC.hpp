@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class ICC
+ * @brief A ICC class.
+ *
+ * Incomplete Cholesky factorisation with zero fill-in, IC(0).
+ *
+ * The lower triangle of the matrix is factorised on its own sparsity pattern.
+ * If a non-positive pivot is encountered, the factorisation is restarted
+ * with a shifted diagonal \f$(1+\alpha)D\f$ so that the preconditioner
+ * always exists for symmetric positive definite matrices.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file ICC.hpp
+ * @addtogroup Preconditioner
+ * @{
+ */
+
+#ifndef ICC_HPP
+#define ICC_HPP
+
+#include "Preconditioner.hpp"
+#include "csc_form.hpp"
+
+template<sp_d data_t> class ICC final : public Preconditioner<data_t> {
+    static constexpr unsigned max_attempt = 20;
+
+    csc_form<data_t, uword> factor;
+
+    std::vector<data_t> original;
+
+    bool factorise();
+
+    template<sp_i index_t> static triplet_form<data_t, uword> lower_triangle(const triplet_form<data_t, index_t>&);
+
+public:
+    template<sp_i index_t> explicit ICC(const triplet_form<data_t, index_t>&);
+
+    int init() override;
+
+    [[nodiscard]] Col<data_t> apply(const Col<data_t>&) override;
+};
+
+template<sp_d data_t> template<sp_i index_t> triplet_form<data_t, uword> ICC<data_t>::lower_triangle(const triplet_form<data_t, index_t>& triplet_mat) {
+    triplet_form<data_t, uword> lower_mat(triplet_mat.n_rows, triplet_mat.n_cols, triplet_mat.n_elem);
+    for(index_t I = 0; I < triplet_mat.n_elem; ++I) if(triplet_mat.row(I) >= triplet_mat.col(I)) lower_mat.at(triplet_mat.row(I), triplet_mat.col(I)) = triplet_mat.val(I);
+    return lower_mat;
+}
+
+template<sp_d data_t> template<sp_i index_t> ICC<data_t>::ICC(const triplet_form<data_t, index_t>& triplet_mat)
+    : Preconditioner<data_t>() {
+    auto lower_mat = lower_triangle(triplet_mat);
+    // diagonal entries are always present and stored first in each column
+    factor = csc_form<data_t, uword>(lower_mat, SparseBase::ZERO, true);
+    original.assign(factor.val_mem(), factor.val_mem() + factor.n_elem);
+}
+
+/**
+ * \brief Right-looking IC(0), updates outside the sparsity pattern are discarded.
+ * \return true if all pivots are positive
+ */
+template<sp_d data_t> bool ICC<data_t>::factorise() {
+    const auto col_ptr = factor.col_mem();
+    const auto row_idx = factor.row_mem();
+    const auto val = factor.val_mem();
+
+    for(uword K = 0; K < factor.n_cols; ++K) {
+        const auto K_begin = col_ptr[K], K_end = col_ptr[K + 1];
+
+        if(K_begin == K_end || row_idx[K_begin] != K || val[K_begin] <= data_t(0)) return false;
+
+        const auto pivot = val[K_begin] = std::sqrt(val[K_begin]);
+        for(auto I = K_begin + 1; I < K_end; ++I) val[I] /= pivot;
+
+        // column J receives contribution L(I,K)*L(J,K) for all I>=J in column K
+        for(auto J = K_begin + 1; J < K_end; ++J) {
+            const auto t_col = row_idx[J];
+            const auto t_factor = val[J];
+            auto P = col_ptr[t_col];
+            const auto P_end = col_ptr[t_col + 1];
+            for(auto I = J; I < K_end && P < P_end; ++I) {
+                while(P < P_end && row_idx[P] < row_idx[I]) ++P;
+                if(P < P_end && row_idx[P] == row_idx[I]) val[P] -= val[I] * t_factor;
+            }
+        }
+    }
+
+    return true;
+}
+
+template<sp_d data_t> int ICC<data_t>::init() {
+    const auto col_ptr = factor.col_mem();
+    const auto row_idx = factor.row_mem();
+    const auto val = factor.val_mem();
+
+    auto shift = data_t(0);
+    for(auto attempt = 0u; attempt < max_attempt; ++attempt) {
+        std::copy(original.begin(), original.end(), val);
+        if(shift > data_t(0))
+            for(uword K = 0; K < factor.n_cols; ++K)
+                if(col_ptr[K] < col_ptr[K + 1] && row_idx[col_ptr[K]] == K) val[col_ptr[K]] *= data_t(1) + shift;
+
+        if(factorise()) {
+            if(shift > data_t(0)) suanpan_debug("Incomplete Cholesky factorisation succeeds with a diagonal shift of {:.3E}.\n", shift);
+            return SUANPAN_SUCCESS;
+        }
+
+        shift = shift > data_t(0) ? data_t(2) * shift : data_t(1E-3);
+    }
+
+    suanpan_error("Incomplete Cholesky factorisation fails, the matrix may not be positive definite.\n");
+    return SUANPAN_FAIL;
+}
+
+template<sp_d data_t> Col<data_t> ICC<data_t>::apply(const Col<data_t>& in) {
+    const auto col_ptr = factor.col_mem();
+    const auto row_idx = factor.row_mem();
+    const auto val = factor.val_mem();
+
+    Col<data_t> out = in;
+
+    for(auto L = 0llu; L < out.n_elem; L += factor.n_cols) {
+        const auto t_out = out.memptr() + L;
+
+        // forward substitution with L
+        for(uword K = 0; K < factor.n_cols; ++K) {
+            const auto t_val = t_out[K] /= val[col_ptr[K]];
+            for(auto I = col_ptr[K] + 1; I < col_ptr[K + 1]; ++I) t_out[row_idx[I]] -= val[I] * t_val;
+        }
+
+        // backward substitution with L^T
+        for(auto K = factor.n_cols; K > 0; --K) {
+            const auto C = K - 1;
+            auto t_val = t_out[C];
+            for(auto I = col_ptr[C] + 1; I < col_ptr[C + 1]; ++I) t_val -= val[I] * t_out[row_idx[I]];
+            t_out[C] = t_val / val[col_ptr[C]];
+        }
+    }
+
+    return out;
+}
+
+#endif
+
+//! @}
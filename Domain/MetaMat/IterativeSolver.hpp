@@ -98,7 +98,9 @@ template<sp_d data_t, HasEvaluate<data_t> System> int GMRES(const System* system
         for(auto i = 0, j = 1; i < setting.restart && counter <= setting.max_iteration; ++i, ++j, ++counter) {
             auto w = conditioner->apply(system->evaluate(v.col(i)));
             for(auto k = 0; k <= i; ++k) w -= (hessenberg(k, i) = arma::dot(w, v.col(k))) * v.col(k);
-            v.col(j) = w / (hessenberg(j, i) = arma::norm(w));
+            // the subspace is invariant, the solution cannot be improved any further
+            const auto breakdown = suanpan::approx_equal(hessenberg(j, i) = arma::norm(w), ZERO);
+            if(!breakdown) v.col(j) = w / hessenberg(j, i);
 
             for(auto k = 0; k < i; ++k) apply_rotation(hessenberg(k, i), hessenberg(k + 1llu, i), cs(k), sn(k));
 
@@ -114,6 +116,13 @@ template<sp_d data_t, HasEvaluate<data_t> System> int GMRES(const System* system
                 setting.max_iteration = counter;
                 return SUANPAN_SUCCESS;
             }
+
+            if(breakdown) {
+                x += update(i);
+                if(SUANPAN_SUCCESS == stop_criterion()) return SUANPAN_SUCCESS;
+                setting.tolerance = residual;
+                return SUANPAN_FAIL;
+            }
         }
 
         x += update(setting.restart - 1);
@@ -200,4 +209,65 @@ template<sp_d data_t, HasEvaluate<data_t> System> int BiCGSTAB(const System* sys
     return SUANPAN_FAIL;
 }
 
+/**
+ * \brief Preconditioned conjugate gradient method, the system and the preconditioner are assumed to be symmetric positive definite.
+ */
+template<sp_d data_t, HasEvaluate<data_t> System> int CG(const System* system, Col<data_t>& x, const Col<data_t>& b, SolverSetting<data_t>& setting) {
+    constexpr sp_d auto ZERO = data_t(0);
+    constexpr sp_d auto ONE = data_t(1);
+
+    const auto& conditioner = setting.preconditioner;
+
+    data_t norm_b = arma::norm(b);
+    if(suanpan::approx_equal(norm_b, ZERO)) norm_b = ONE;
+
+    if(x.empty()) x = conditioner->apply(b);
+    else x.zeros(arma::size(b));
+
+    Col<data_t> r = b - system->evaluate(x);
+
+    data_t residual = arma::norm(r) / norm_b;
+    suanpan_debug("CG iterative solver residual: {:.5E}.\n", residual);
+    if(residual < setting.tolerance) {
+        setting.tolerance = residual;
+        setting.max_iteration = 0;
+        return SUANPAN_SUCCESS;
+    }
+
+    Col<data_t> z = conditioner->apply(r);
+    Col<data_t> p = z;
+    auto rho = arma::dot(r, z);
+
+    for(auto i = 1; i <= setting.max_iteration; ++i) {
+        const Col<data_t> q = system->evaluate(p);
+
+        const auto pq = arma::dot(p, q);
+        if(pq <= ZERO) {
+            suanpan_debug("CG iterative solver encounters a non-positive curvature.\n");
+            setting.tolerance = residual;
+            setting.max_iteration = i;
+            return SUANPAN_FAIL;
+        }
+
+        const auto alpha = rho / pq;
+        x += alpha * p;
+        r -= alpha * q;
+
+        suanpan_debug("CG iterative solver residual: {:.5E}.\n", residual = arma::norm(r) / norm_b);
+        if(residual < setting.tolerance) {
+            setting.tolerance = residual;
+            setting.max_iteration = i;
+            return SUANPAN_SUCCESS;
+        }
+
+        z = conditioner->apply(r);
+        const auto pre_rho = rho;
+        rho = arma::dot(r, z);
+        p = z + rho / pre_rho * p;
+    }
+
+    setting.tolerance = residual;
+    return SUANPAN_FAIL;
+}
+
 #endif
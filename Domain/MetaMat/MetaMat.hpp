@@ -31,6 +31,8 @@
 
 #include "triplet_form.hpp"
 #include "IterativeSolver.hpp"
+#include "AMG.hpp"
+#include "ICC.hpp"
 #include "ILU.hpp"
 #include "Jacobi.hpp"
 
@@ -75,6 +77,9 @@ protected:
 
     SolverSetting<T> setting{};
 
+    // the multigrid hierarchy is kept so that it can be reused by the next solve with the same pattern
+    shared_ptr<AMG<T>> amg_preconditioner = nullptr;
+
     virtual int direct_solve(Mat<T>&, const Mat<T>&) = 0;
 
     virtual int direct_solve(Mat<T>&, Mat<T>&&) = 0;
@@ -125,7 +130,14 @@ public:
         , n_cols(in_cols)
         , n_elem(in_elem) {}
 
-    MetaMat(const MetaMat&) = default;
+    // the multigrid hierarchy belongs to the original matrix and is not shared
+    MetaMat(const MetaMat& other)
+        : factored(other.factored)
+        , setting(other.setting)
+        , triplet_mat(other.triplet_mat)
+        , n_rows(other.n_rows)
+        , n_cols(other.n_cols)
+        , n_elem(other.n_elem) {}
     MetaMat(MetaMat&&) noexcept = delete;
     MetaMat& operator=(const MetaMat&) = delete;
     MetaMat& operator=(MetaMat&&) noexcept = delete;
@@ -137,6 +149,11 @@ public:
 
     void set_factored(const bool F) { factored = F; }
 
+    /**
+     * \brief The multigrid preconditioner kept from the last iterative solve, if any
+     */
+    [[nodiscard]] const AMG<T>* get_amg_preconditioner() const { return amg_preconditioner.get(); }
+
     [[nodiscard]] virtual bool is_empty() const = 0;
     virtual void zeros() = 0;
 
@@ -147,8 +164,26 @@ public:
         this->at(K, K) = T(1);
     }
 
+    /**
+     * \brief Zero out the rows and columns of all given DoFs and set the diagonal to unity
+     * \param K list of DoFs
+     */
+    void unify(const uvec& K) {
+        this->nullify(K);
+        for(const auto I : K) this->at(I, I) = T(1);
+    }
+
     virtual void nullify(uword) = 0;
 
+    /**
+     * \brief Zero out the rows and columns of all given DoFs
+     * Storage schemes with costly single DoF access should override this to process all DoFs in one pass.
+     * \param K list of DoFs
+     */
+    virtual void nullify(const uvec& K) {
+        for(const auto I : K) this->nullify(I);
+    }
+
     [[nodiscard]] virtual T max() const = 0;
     [[nodiscard]] virtual Col<T> diag() const = 0;
 
@@ -211,6 +246,13 @@ public:
 
     [[nodiscard]] virtual int sign_det() const = 0;
 
+    /**
+     * \brief Number of negative eigenvalues, by Sylvester's law of inertia, it equals the number of negative pivots of
+     * the \f$LDL^T\f$ factorisation. The matrix may be factorised if it is not yet.
+     * \return number of negative eigenvalues
+     */
+    [[nodiscard]] virtual uword inertia() { throw invalid_argument("not supported"); }
+
     void save(const char* name) {
         if(!to_mat(*this).save(name, raw_ascii))
             suanpan_error("Cannot save to file \"{}\".\n", name);
@@ -224,7 +266,9 @@ public:
 };
 
 template<sp_d T> int MetaMat<T>::iterative_solve(Mat<T>& X, const Mat<T>& B) {
-    this->csc_condense();
+    // zero-valued entries are kept so that the multigrid hierarchy is reused as long as the structure is unchanged
+    if(PreconditionerType::AMG == this->setting.preconditioner_type) this->triplet_mat.csc_structure_condense();
+    else this->csc_condense();
 
     X.zeros(arma::size(B));
 
@@ -236,11 +280,22 @@ template<sp_d T> int MetaMat<T>::iterative_solve(Mat<T>& X, const Mat<T>& B) {
         else preconditioner = std::make_unique<ILU<T>>(this->triplet_mat);
     }
 #endif
+    else if(PreconditionerType::ICC == this->setting.preconditioner_type) {
+        if(this->triplet_mat.is_empty()) preconditioner = std::make_unique<ICC<T>>(to_triplet_form<T, uword>(this));
+        else preconditioner = std::make_unique<ICC<T>>(this->triplet_mat);
+    }
+    else if(PreconditionerType::AMG == this->setting.preconditioner_type) {
+        if(nullptr == this->amg_preconditioner) this->amg_preconditioner = std::make_shared<AMG<T>>(this->setting.near_null_space);
+        if(this->triplet_mat.is_empty()) this->amg_preconditioner->set_matrix(to_triplet_form<T, uword>(this));
+        else this->amg_preconditioner->set_matrix(this->triplet_mat);
+    }
     else if(PreconditionerType::NONE == this->setting.preconditioner_type) preconditioner = std::make_unique<UnityPreconditioner<T>>();
 
-    if(SUANPAN_SUCCESS != preconditioner->init()) return SUANPAN_FAIL;
+    Preconditioner<T>* t_preconditioner = PreconditionerType::AMG == this->setting.preconditioner_type ? this->amg_preconditioner.get() : preconditioner.get();
 
-    this->setting.preconditioner = preconditioner.get();
+    if(SUANPAN_SUCCESS != t_preconditioner->init()) return SUANPAN_FAIL;
+
+    this->setting.preconditioner = t_preconditioner;
 
     std::atomic_int code = 0;
 
@@ -258,6 +313,13 @@ template<sp_d T> int MetaMat<T>::iterative_solve(Mat<T>& X, const Mat<T>& B) {
             auto col_setting = setting;
             code += BiCGSTAB(this, sub_x, sub_b, col_setting);
         });
+    else if(IterativeSolver::CG == setting.iterative_solver)
+        suanpan::for_each(B.n_cols, [&](const uword I) {
+            Col<T> sub_x(X.colptr(I), X.n_rows, false, true);
+            const Col<T> sub_b(B.colptr(I), B.n_rows);
+            auto col_setting = setting;
+            code += CG(this, sub_x, sub_b, col_setting);
+        });
     else throw invalid_argument("no proper iterative solver assigned but somehow iterative solving is called");
 
     return 0 == code ? SUANPAN_SUCCESS : SUANPAN_FAIL;
@@ -28,15 +28,27 @@ enum class Precision {
 enum class IterativeSolver {
     BICGSTAB,
     GMRES,
+    CG,
     NONE
 };
 
 enum class PreconditionerType {
     ILU,
+    ICC,
     JACOBI,
+    AMG,
     NONE
 };
 
+/**
+ * \brief The near null space of the operator used by algebraic multigrid.
+ * Each column of the basis is a zero energy mode (e.g., rigid body mode), DoFs sharing the same group (e.g., node) are aggregated together.
+ */
+template<sp_d data_t> struct NearNullSpace {
+    Mat<data_t> basis;
+    uvec group;
+};
+
 template<sp_d data_t> struct SolverSetting {
     int restart = 20;
     int max_iteration = 200;
@@ -46,6 +58,7 @@ template<sp_d data_t> struct SolverSetting {
     IterativeSolver iterative_solver = IterativeSolver::NONE;
     PreconditionerType preconditioner_type = PreconditionerType::JACOBI;
     Preconditioner<data_t>* preconditioner = nullptr;
+    shared_ptr<const NearNullSpace<data_t>> near_null_space = nullptr;
     string lis_options{};
 };
 
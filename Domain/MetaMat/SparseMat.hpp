@@ -53,6 +53,15 @@ public:
         suanpan::for_each(this->triplet_mat.n_elem, [&](const uword I) { if(this->triplet_mat.row(I) == idx || this->triplet_mat.col(I) == idx) this->triplet_mat.val_mem()[I] = T(0); });
     }
 
+    void nullify(const uvec& idx) override {
+        if(idx.empty()) return;
+        this->factored = false;
+        // flag restrained DoFs so that all triplets are checked in a single pass
+        std::vector<char> mask(std::max(this->n_rows, this->n_cols), 0);
+        for(const auto I : idx) mask[I] = 1;
+        suanpan::for_each(this->triplet_mat.n_elem, [&](const uword I) { if(mask[this->triplet_mat.row(I)] || mask[this->triplet_mat.col(I)]) this->triplet_mat.val_mem()[I] = T(0); });
+    }
+
     [[nodiscard]] T max() const override { return this->triplet_mat.max(); }
 
     [[nodiscard]] Col<T> diag() const override { return this->triplet_mat.diag(); }
@@ -35,12 +35,32 @@
 #if defined(SUANPAN_MPI) && defined(SUANPAN_MKL)
 
 #include <mpi.h>
+#include <MPI/command.pardiso.h>
 
 extern int SUANPAN_NUM_NODES;
 
+/**
+ * \brief The worker group is spawned on first solve and kept alive for the lifetime of the matrix.
+ *
+ * Reordering and symbolic factorisation are only performed if the sparsity pattern changes.
+ * Otherwise only new values are sent for numeric factorisation.
+ * Repeated solves with an existing factorisation only send the right hand side.
+ */
 template<sp_d T> class SparseMatMPIPARDISO final : public SparseMat<T> {
     int iparm[64];
 
+    MPI_Comm worker = MPI_COMM_NULL, remote = MPI_COMM_NULL;
+
+    // the matrix last sent to the worker group, also serves as the reference pattern
+    csr_form<T, int> csr_mat;
+
+    bool analysed = false;
+
+    void send_command(PardisoCommand);
+    int receive_error() const;
+    int factorise();
+    void shutdown();
+
 protected:
     using SparseMat<T>::direct_solve;
 
@@ -53,53 +73,116 @@ public:
         iparm[34] = 1; // zero-based indexing
     }
 
+    SparseMatMPIPARDISO(const SparseMatMPIPARDISO& other)
+        : SparseMat<T>(other)
+        , iparm{} {
+        std::copy(std::begin(other.iparm), std::end(other.iparm), std::begin(iparm));
+    }
+
+    SparseMatMPIPARDISO(SparseMatMPIPARDISO&&) noexcept = delete;
+    SparseMatMPIPARDISO& operator=(const SparseMatMPIPARDISO&) = delete;
+    SparseMatMPIPARDISO& operator=(SparseMatMPIPARDISO&&) noexcept = delete;
+
+    ~SparseMatMPIPARDISO() override { shutdown(); }
+
     unique_ptr<MetaMat<T>> make_copy() override { return std::make_unique<SparseMatMPIPARDISO>(*this); }
 };
 
-template<sp_d T> int SparseMatMPIPARDISO<T>::direct_solve(Mat<T>& X, const Mat<T>& B) {
-    X.set_size(B.n_rows, B.n_cols);
+template<sp_d T> void SparseMatMPIPARDISO<T>::send_command(PardisoCommand command) {
+    if(MPI_COMM_NULL == worker) {
+        MPI_Comm_spawn("solver.pardiso", MPI_ARGV_NULL, SUANPAN_NUM_NODES, MPI_INFO_NULL, 0, MPI_COMM_SELF, &worker, MPI_ERRCODES_IGNORE);
+        MPI_Intercomm_merge(worker, 0, &remote);
+    }
+
+    MPI_Bcast(&command, 1, MPI_INT, 0, remote);
+}
+
+template<sp_d T> int SparseMatMPIPARDISO<T>::receive_error() const {
+    int error = -1;
+    MPI_Recv(&error, 1, MPI_INT, 0, 0, worker, MPI_STATUS_IGNORE);
+    return error;
+}
+
+template<sp_d T> int SparseMatMPIPARDISO<T>::factorise() {
+    const auto FLOAT_TYPE = std::is_same_v<T, double> ? MPI_DOUBLE : MPI_FLOAT;
+
+    csr_form<T, int> new_mat(this->triplet_mat, SparseBase::ZERO, true);
+
+    const auto same_pattern = analysed && new_mat.n_rows == csr_mat.n_rows && new_mat.n_elem == csr_mat.n_elem && std::equal(new_mat.row_mem(), new_mat.row_mem() + new_mat.n_rows + 1, csr_mat.row_mem()) && std::equal(new_mat.col_mem(), new_mat.col_mem() + new_mat.n_elem, csr_mat.col_mem());
 
-    csr_form<T, int> csr_mat(this->triplet_mat, SparseBase::ZERO, true);
+    csr_mat = std::move(new_mat);
 
-    const auto n = static_cast<int>(B.n_rows);
-    const auto nrhs = static_cast<int>(B.n_cols);
+    const auto n = static_cast<int>(csr_mat.n_rows);
     const auto nnz = static_cast<int>(csr_mat.n_elem);
 
-    MPI_Comm worker;
-    MPI_Comm_spawn("solver.pardiso", MPI_ARGV_NULL, SUANPAN_NUM_NODES, MPI_INFO_NULL, 0, MPI_COMM_SELF, &worker, MPI_ERRCODES_IGNORE);
+    if(same_pattern) {
+        send_command(PardisoCommand::UPDATE);
+        MPI_Send(csr_mat.val_mem(), nnz, FLOAT_TYPE, 0, 0, worker);
+    }
+    else {
+        send_command(PardisoCommand::ANALYSE);
+
+        int config[8];
+
+        config[0] = 11; // mtype
+        config[1] = 1;  // nrhs
+        config[2] = 1;  // maxfct
+        config[3] = 1;  // mnum
+        config[4] = 0;  // msglvl
+        config[5] = n;  // n
+        config[6] = nnz;
+        config[7] = std::is_same_v<T, double> ? 1 : -1;
+
+        MPI_Bcast(&config, 8, MPI_INT, 0, remote);
+
+        MPI_Request requests[4];
+        MPI_Isend(&iparm, 64, MPI_INT, 0, 0, worker, &requests[0]);
+        MPI_Isend(csr_mat.row_mem(), n + 1, MPI_INT, 0, 0, worker, &requests[1]);
+        MPI_Isend(csr_mat.col_mem(), nnz, MPI_INT, 0, 0, worker, &requests[2]);
+        MPI_Isend(csr_mat.val_mem(), nnz, FLOAT_TYPE, 0, 0, worker, &requests[3]);
+        MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+
+        if(analysed = 0 == receive_error(); !analysed) return SUANPAN_FAIL;
+    }
 
-    int config[8];
+    send_command(PardisoCommand::FACTORISE);
 
-    config[0] = 11;   // mtype
-    config[1] = nrhs; // nrhs
-    config[2] = 1;    // maxfct
-    config[3] = 1;    // mnum
-    config[4] = 0;    // msglvl
-    config[5] = n;    // n
-    config[6] = nnz;  // nnz
-    config[7] = std::is_same_v<T, double> ? 1 : -1;
-    const auto FLOAT_TYPE = std::is_same_v<T, double> ? MPI_DOUBLE : MPI_FLOAT;
+    return 0 == receive_error() ? SUANPAN_SUCCESS : SUANPAN_FAIL;
+}
 
-    MPI_Comm remote;
-    MPI_Intercomm_merge(worker, 0, &remote);
-    MPI_Bcast(&config, 8, MPI_INT, 0, remote);
+template<sp_d T> void SparseMatMPIPARDISO<T>::shutdown() {
+    if(MPI_COMM_NULL == worker) return;
 
-    MPI_Request requests[5];
-    MPI_Isend(&iparm, 64, MPI_INT, 0, 0, worker, &requests[0]);
-    MPI_Isend(csr_mat.row_mem(), n + 1, MPI_INT, 0, 0, worker, &requests[1]);
-    MPI_Isend(csr_mat.col_mem(), nnz, MPI_INT, 0, 0, worker, &requests[2]);
-    MPI_Isend(csr_mat.val_mem(), nnz, FLOAT_TYPE, 0, 0, worker, &requests[3]);
-    MPI_Isend(B.memptr(), static_cast<int>(B.n_elem), FLOAT_TYPE, 0, 0, worker, &requests[4]);
-    MPI_Waitall(5, requests, MPI_STATUSES_IGNORE);
+    send_command(PardisoCommand::SHUTDOWN);
 
-    int error = -1;
-    MPI_Recv(&error, 1, MPI_INT, 0, 0, worker, MPI_STATUS_IGNORE);
-    if(0 == error) {
-        MPI_Recv(X.memptr(), static_cast<int>(B.n_elem), FLOAT_TYPE, 0, 0, worker, MPI_STATUS_IGNORE);
-        return SUANPAN_SUCCESS;
+    MPI_Comm_free(&remote);
+    MPI_Comm_disconnect(&worker);
+
+    analysed = false;
+}
+
+template<sp_d T> int SparseMatMPIPARDISO<T>::direct_solve(Mat<T>& X, const Mat<T>& B) {
+    if(!this->factored) {
+        if(SUANPAN_SUCCESS != factorise()) return SUANPAN_FAIL;
+        this->factored = true;
     }
 
-    return SUANPAN_FAIL;
+    X.set_size(B.n_rows, B.n_cols);
+
+    const auto FLOAT_TYPE = std::is_same_v<T, double> ? MPI_DOUBLE : MPI_FLOAT;
+
+    send_command(PardisoCommand::SOLVE);
+
+    auto nrhs = static_cast<int>(B.n_cols);
+    MPI_Bcast(&nrhs, 1, MPI_INT, 0, remote);
+
+    MPI_Send(B.memptr(), static_cast<int>(B.n_elem), FLOAT_TYPE, 0, 0, worker);
+
+    if(0 != receive_error()) return SUANPAN_FAIL;
+
+    MPI_Recv(X.memptr(), static_cast<int>(B.n_elem), FLOAT_TYPE, 0, 0, worker, MPI_STATUS_IGNORE);
+
+    return SUANPAN_SUCCESS;
 }
 
 #endif
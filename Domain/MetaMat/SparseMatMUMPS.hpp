@@ -44,53 +44,85 @@ template<sp_d T> class SparseMatBaseMUMPS : public SparseMat<T> {
 
     triplet_form<float, int> s_mat;
 
-    s32_vec l_irn, l_jrn;
+    // one-based indices of the analysed pattern, kept alive as MUMPS refers to them in the factorisation phase
+    s32_vec d_irn, d_jrn, s_irn, s_jrn;
 
-    template<bool convert, typename ST,std::invocable<ST*> F, typename COO> int alloc(COO& triplet, ST& mumps_job, F& mumps_c) {
-        if(this->factored) return 0;
+    unsigned symbolic_counter = 0;
+    unsigned numeric_counter = 0;
 
-        dealloc(mumps_job, mumps_c);
+    /**
+     * \brief Factorise the given matrix, the analysis phase (ordering and symbolic factorisation) is only performed if the pattern changes.
+     * \return error code
+     */
+    template<typename ST, std::invocable<ST*> F, typename COO> int alloc(COO& triplet, ST& mumps_job, F& mumps_c, s32_vec& irn, s32_vec& jrn) {
+        if(this->factored) return 0;
 
         this->factored = true;
 
-        mumps_job.job = -1;
-        mumps_c(&mumps_job);
+        // non-zero base converts zero-based indices to one-based ones
+        constexpr auto base = std::is_same_v<COO, triplet_form<float, int>> ? 0 : 1;
+
+        // zero-valued entries are kept so that the pattern check below is structural
+        // otherwise an entry that happens to vanish would trigger a new analysis phase
+        // the one-based copy is created from a condensed source
+        if constexpr(0 != base) triplet.csc_structure_condense();
+
+        auto same_pattern = mumps_job.job > 0 && mumps_job.n == static_cast<int>(triplet.n_rows) && irn.n_elem == static_cast<uword>(triplet.n_elem);
+        for(auto I = 0llu; same_pattern && I < static_cast<uword>(triplet.n_elem); ++I) same_pattern = irn[I] == static_cast<int>(triplet.row(I) + base) && jrn[I] == static_cast<int>(triplet.col(I) + base);
 
-        triplet.csc_condense();
+        if(!same_pattern) {
+            dealloc(mumps_job, mumps_c);
 
-        if constexpr(convert) {
-            l_irn.set_size(triplet.n_elem);
-            l_jrn.set_size(triplet.n_elem);
+            mumps_job.job = -1;
+            mumps_c(&mumps_job);
+
+            irn.set_size(triplet.n_elem);
+            jrn.set_size(triplet.n_elem);
 
             suanpan::for_each(static_cast<int>(triplet.n_elem), [&](const int I) {
-                l_irn[I] = static_cast<int>(triplet.row(I) + 1);
-                l_jrn[I] = static_cast<int>(triplet.col(I) + 1);
+                irn[I] = static_cast<int>(triplet.row(I) + base);
+                jrn[I] = static_cast<int>(triplet.col(I) + base);
             });
 
-            mumps_job.irn = l_irn.memptr();
-            mumps_job.jcn = l_jrn.memptr();
-        }
-        else {
-            mumps_job.irn = triplet.row_mem();
-            mumps_job.jcn = triplet.col_mem();
+            mumps_job.irn = irn.memptr();
+            mumps_job.jcn = jrn.memptr();
+            // values may be used in the analysis phase to compute the column permutation
+            mumps_job.a = triplet.val_mem();
+
+            mumps_job.n = static_cast<int>(triplet.n_rows);
+            mumps_job.nnz = static_cast<int64_t>(triplet.n_elem);
+
+            mumps_job.icntl[0] = -1;
+            mumps_job.icntl[1] = -1;
+            mumps_job.icntl[2] = -1;
+            mumps_job.icntl[3] = 0;
+            mumps_job.icntl[9] = -2;
+            mumps_job.icntl[13] = 100;
+            mumps_job.icntl[19] = 0; // dense rhs
+            mumps_job.icntl[32] = 1; // determinant
+            mumps_job.icntl[34] = 1; // BLR
+
+            ++symbolic_counter;
+
+            mumps_job.job = 1;
+            mumps_c(&mumps_job);
+
+            if(0 != mumps_job.info[0]) {
+                suanpan_error("Error code {} received.\n", mumps_job.info[0]);
+                const auto info = mumps_job.info[0];
+                dealloc(mumps_job, mumps_c);
+                irn.reset();
+                jrn.reset();
+                return info;
+            }
         }
 
+        // the value buffer may have been reallocated since the last analysis phase
         mumps_job.a = triplet.val_mem();
 
-        mumps_job.n = static_cast<int>(triplet.n_rows);
-        mumps_job.nnz = static_cast<int64_t>(triplet.n_elem);
+        ++numeric_counter;
 
-        mumps_job.icntl[0] = -1;
-        mumps_job.icntl[1] = -1;
-        mumps_job.icntl[2] = -1;
-        mumps_job.icntl[3] = 0;
-        mumps_job.icntl[9] = -2;
-        mumps_job.icntl[13] = 100;
-        mumps_job.icntl[19] = 0; // dense rhs
-        mumps_job.icntl[32] = 1; // determinant
-        mumps_job.icntl[34] = 1; // BLR
-
-        mumps_job.job = 4;
+        mumps_job.job = 2;
         mumps_c(&mumps_job);
 
         if(0 != mumps_job.info[0])
@@ -99,13 +131,14 @@ template<sp_d T> class SparseMatBaseMUMPS : public SparseMat<T> {
         return mumps_job.info[0];
     }
 
-    template<typename ST,std::invocable<ST*> F> static void dealloc(ST& mumps_job, F& mumps_c) {
-        if(3 != mumps_job.job) return;
+    template<typename ST, std::invocable<ST*> F> static void dealloc(ST& mumps_job, F& mumps_c) {
+        // any positive job indicates an initialised instance
+        if(mumps_job.job < 1) return;
         mumps_job.job = -2;
         mumps_c(&mumps_job);
     }
 
-    template<typename ST,std::invocable<ST*> F> static void run(ST& mumps_job, F& mumps_c) {
+    template<typename ST, std::invocable<ST*> F> static void run(ST& mumps_job, F& mumps_c) {
         mumps_job.job = 3;
         mumps_c(&mumps_job);
     }
@@ -119,7 +152,7 @@ protected:
         auto mat_ptr = 0 == this->sym ? &this->triplet_mat : &h_mat;
 
         if constexpr(std::is_same_v<T, float>) {
-            if(0 != (INFO = alloc<true>(*mat_ptr, smumps_job, smumps_c))) return INFO;
+            if(0 != (INFO = alloc(*mat_ptr, smumps_job, smumps_c, s_irn, s_jrn))) return INFO;
 
             smumps_job.rhs = B.memptr();
             smumps_job.lrhs = static_cast<int>(B.n_rows);
@@ -132,7 +165,7 @@ protected:
             INFO = smumps_job.info[0];
         }
         else if(Precision::FULL == this->setting.precision) {
-            if(0 != (INFO = alloc<true>(*mat_ptr, dmumps_job, dmumps_c))) return INFO;
+            if(0 != (INFO = alloc(*mat_ptr, dmumps_job, dmumps_c, d_irn, d_jrn))) return INFO;
 
             dmumps_job.rhs = B.memptr();
             dmumps_job.lrhs = static_cast<int>(B.n_rows);
@@ -145,9 +178,12 @@ protected:
             INFO = dmumps_job.info[0];
         }
         else {
-            if(!this->factored) s_mat = triplet_form<float, int>(*mat_ptr, SparseBase::ONE, false);
+            if(!this->factored) {
+                mat_ptr->csc_structure_condense();
+                s_mat = triplet_form<float, int>(*mat_ptr, SparseBase::ONE, false);
+            }
 
-            if(0 != (INFO = alloc<false>(s_mat, smumps_job, smumps_c))) return INFO;
+            if(0 != (INFO = alloc(s_mat, smumps_job, smumps_c, s_irn, s_jrn))) return INFO;
 
             INFO = this->mixed_trs(X, std::forward<Mat<T>>(B), [&](fmat& residual) {
                 smumps_job.rhs = residual.memptr();
@@ -174,9 +210,7 @@ public:
         : SparseMat<T>(other)
         , sym(other.sym)
         , dmumps_job{other.sym, 1, -1, -987654}
-        , smumps_job{other.sym, 1, -1, -987654}
-        , l_irn(other.l_irn)
-        , l_jrn(other.l_jrn) {}
+        , smumps_job{other.sym, 1, -1, -987654} {}
 
     SparseMatBaseMUMPS(SparseMatBaseMUMPS&&) noexcept = delete;
     SparseMatBaseMUMPS& operator=(const SparseMatBaseMUMPS&) = delete;
@@ -187,11 +221,19 @@ public:
         dealloc(smumps_job, smumps_c);
     }
 
-    void zeros() override {
-        SparseMat<T>::zeros();
-        dealloc(dmumps_job, dmumps_c);
-        dealloc(smumps_job, smumps_c);
-    }
+    void zeros() override { SparseMat<T>::zeros(); }
+
+    /**
+     * \brief Number of analysis phases performed
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_symbolic_counter() const { return symbolic_counter; }
+
+    /**
+     * \brief Number of numeric factorisations performed
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_numeric_counter() const { return numeric_counter; }
 
     [[nodiscard]] int sign_det() const override {
         if(IterativeSolver::NONE != this->setting.iterative_solver) throw invalid_argument("analysis requires the sign of determinant but iterative solver does not support it");
@@ -204,6 +246,25 @@ public:
 
         return det_sign;
     }
+
+    /**
+     * \brief The number of negative pivots is only reported by MUMPS for symmetric matrices.
+     */
+    [[nodiscard]] uword inertia() override {
+        if(IterativeSolver::NONE != this->setting.iterative_solver) throw invalid_argument("analysis requires the inertia but iterative solver does not support it");
+        if(0 == sym) throw invalid_argument("analysis requires the inertia but unsymmetric storage does not support it");
+
+        if(!this->factored)
+            if(Mat<T> X; SUANPAN_SUCCESS != this->direct_solve(X, Mat<T>(this->n_rows, 1, fill::zeros))) throw invalid_argument("fail to factorise the matrix");
+
+        int negative_pivot;
+
+        if constexpr(std::is_same_v<T, float>) negative_pivot = smumps_job.infog[11];
+        else if(Precision::FULL == this->setting.precision) negative_pivot = dmumps_job.infog[11];
+        else negative_pivot = smumps_job.infog[11];
+
+        return static_cast<uword>(negative_pivot);
+    }
 };
 
 template<sp_d T> class SparseMatMUMPS final : public SparseMatBaseMUMPS<T> {
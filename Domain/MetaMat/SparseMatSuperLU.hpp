@@ -34,6 +34,15 @@
 #include "SparseMat.hpp"
 #include "csc_form.hpp"
 
+#ifndef SUANPAN_SUPERLUMT
+// the supernodal storage of L is not exposed by the built-in definitions
+// take it from the bundled library so that the index type always matches
+namespace superlu_store {
+#include <Toolbox/superlu-src/superlu_config.h>
+#include <Toolbox/superlu-src/supermatrix.h>
+} // namespace superlu_store
+#endif
+
 template<sp_d T> class SparseMatSuperLU final : public SparseMat<T> {
     SuperMatrix A{}, L{}, U{}, B{};
 
@@ -53,11 +62,21 @@ template<sp_d T> class SparseMatSuperLU final : public SparseMat<T> {
 
     int* perm_r = nullptr;
     int* perm_c = nullptr;
+    // postordered elimination tree of the last symbolic factorization, input only under SamePattern
+    int* etree = nullptr;
+
+    // sparsity pattern of the last symbolic factorization
+    std::vector<int> pattern_row, pattern_col;
 
     bool allocated = false;
+    bool same_pattern = false;
+
+    unsigned symbolic_counter = 0;
+    unsigned numeric_counter = 0;
 
     template<sp_d ET> void alloc(csc_form<ET, int>&&);
     void dealloc();
+    void dealloc_pattern();
 
     template<sp_d ET> void wrap_b(const Mat<ET>&);
     template<sp_d ET> void tri_solve(int&);
@@ -65,6 +84,8 @@ template<sp_d T> class SparseMatSuperLU final : public SparseMat<T> {
 
     int solve_trs(Mat<T>&, Mat<T>&&);
 
+    template<sp_d ET> [[nodiscard]] uword count_negative_pivot() const;
+
 protected:
     int direct_solve(Mat<T>& out_mat, const Mat<T>& in_mat) override { return this->direct_solve(out_mat, Mat<T>(in_mat)); }
 
@@ -81,6 +102,20 @@ public:
     void zeros() override;
 
     unique_ptr<MetaMat<T>> make_copy() override;
+
+    /**
+     * \brief Number of factorizations that compute the column ordering and the elimination tree
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_symbolic_counter() const { return symbolic_counter; }
+
+    /**
+     * \brief Number of numeric factorizations, including those following a symbolic one
+     * \return counter
+     */
+    [[nodiscard]] unsigned get_numeric_counter() const { return numeric_counter; }
+
+    [[nodiscard]] uword inertia() override;
 };
 
 template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::alloc(csc_form<ET, int>&& in) {
@@ -98,6 +133,20 @@ template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::alloc(csc_form<ET,
     t_col = (int*)superlu_malloc(t_size);
     memcpy(t_col, (void*)in.col_mem(), t_size);
 
+    // the ordering and the elimination tree only depend on the sparsity pattern
+    same_pattern = nullptr != perm_c && pattern_col.size() == in.n_cols + 1llu && pattern_row.size() == static_cast<size_t>(in.n_elem) && std::equal(pattern_col.cbegin(), pattern_col.cend(), t_col) && std::equal(pattern_row.cbegin(), pattern_row.cend(), t_row);
+
+    if(!same_pattern) {
+        dealloc_pattern();
+
+        pattern_row.assign(t_row, t_row + in.n_elem);
+        pattern_col.assign(t_col, t_col + in.n_cols + 1llu);
+
+        perm_r = (int*)superlu_malloc(sizeof(int) * (this->n_rows + 1));
+        perm_c = (int*)superlu_malloc(sizeof(int) * (this->n_cols + 1));
+        etree = (int*)superlu_malloc(sizeof(int) * (this->n_cols + 1));
+    }
+
     if constexpr(std::is_same_v<ET, double>) {
         using E = double;
         dCreate_CompCol_Matrix(&A, in.n_rows, in.n_cols, in.n_elem, (E*)t_val, t_row, t_col, Stype_t::SLU_NC, Dtype_t::SLU_D, Mtype_t::SLU_GE);
@@ -107,9 +156,6 @@ template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::alloc(csc_form<ET,
         sCreate_CompCol_Matrix(&A, in.n_rows, in.n_cols, in.n_elem, (E*)t_val, t_row, t_col, Stype_t::SLU_NC, Dtype_t::SLU_S, Mtype_t::SLU_GE);
     }
 
-    perm_r = (int*)superlu_malloc(sizeof(int) * (this->n_rows + 1));
-    perm_c = (int*)superlu_malloc(sizeof(int) * (this->n_cols + 1));
-
     allocated = true;
 }
 
@@ -128,10 +174,25 @@ template<sp_d T> void SparseMatSuperLU<T>::dealloc() {
     if(t_val) superlu_free(t_val);
     if(t_row) superlu_free(t_row);
     if(t_col) superlu_free(t_col);
+
+    t_val = nullptr;
+    t_row = nullptr;
+    t_col = nullptr;
+
+    allocated = false;
+}
+
+template<sp_d T> void SparseMatSuperLU<T>::dealloc_pattern() {
     if(perm_r) superlu_free(perm_r);
     if(perm_c) superlu_free(perm_c);
+    if(etree) superlu_free(etree);
 
-    allocated = false;
+    perm_r = nullptr;
+    perm_c = nullptr;
+    etree = nullptr;
+
+    pattern_row.clear();
+    pattern_col.clear();
 }
 
 template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::wrap_b(const Mat<ET>& in_mat) {
@@ -157,15 +218,58 @@ template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::tri_solve(int& flag
 }
 
 template<sp_d T> template<sp_d ET> void SparseMatSuperLU<T>::full_solve(int& flag) {
+    if(!same_pattern) ++symbolic_counter;
+    ++numeric_counter;
+
 #ifdef SUANPAN_SUPERLUMT
-    get_perm_c(ordering_num, &A, perm_c);
+    // only the column ordering is reused, pxgssv always recomputes the elimination tree
+    if(!same_pattern) get_perm_c(ordering_num, &A, perm_c);
     if(std::is_same_v<ET, float>) psgssv(SUANPAN_NUM_THREADS, &A, perm_c, perm_r, &L, &U, &B, &flag);
     else pdgssv(SUANPAN_NUM_THREADS, &A, perm_c, perm_r, &L, &U, &B, &flag);
+
+    Destroy_SuperMatrix_Store(&B);
 #else
-    superlu::gssv<ET>(&options, &A, perm_c, perm_r, &L, &U, &B, &stat, &flag);
+    // equivalent to gssv, under SamePattern sp_preorder only applies perm_c to A
+    // the postordered perm_c and etree from the last DOFACT call are kept in the buffers and reused as inputs
+    options.Fact = same_pattern ? superlu::fact_t::SamePattern : superlu::fact_t::DOFACT;
+
+    if(!same_pattern) superlu::get_permutation_c(static_cast<int>(options.ColPerm), &A, perm_c);
+
+    SuperMatrix AC{};
+    superlu::sp_preorder_mat(&options, &A, perm_c, etree, &AC);
+
+    GlobalLU_t glu{};
+    superlu::gstrf<ET>(&options, &AC, superlu::sp_ispec_environ(2), superlu::sp_ispec_environ(1), etree, nullptr, 0, perm_c, perm_r, &L, &U, &glu, &stat, &flag);
+
+    superlu::destroy_compcolperm_mat(&AC);
+
+    // an unsuccessful factorization invalidates the cached pattern so that the next attempt starts afresh
+    if(0 != flag) {
+        Destroy_SuperMatrix_Store(&B);
+        dealloc_pattern();
+        return;
+    }
+
+    tri_solve<ET>(flag);
 #endif
+}
 
-    Destroy_SuperMatrix_Store(&B);
+/**
+ * \brief The diagonal of \f$U\f$ is stored in the supernodes of \f$L\f$.
+ */
+template<sp_d T> template<sp_d ET> uword SparseMatSuperLU<T>::count_negative_pivot() const {
+    uword counter = 0;
+
+#ifndef SUANPAN_SUPERLUMT
+    const auto store = static_cast<const superlu_store::SCformat*>(L.Store);
+    const auto value = static_cast<const ET*>(store->nzval);
+
+    for(auto K = 0; K <= store->nsuper; ++K)
+        for(auto J = store->sup_to_col[K]; J < store->sup_to_col[K + 1]; ++J)
+            if(value[store->nzval_colptr[J] + J - store->sup_to_col[K]] < ET(0)) ++counter;
+#endif
+
+    return counter;
 }
 
 template<sp_d T> SparseMatSuperLU<T>::SparseMatSuperLU(const uword in_row, const uword in_col, const uword in_elem)
@@ -202,6 +306,7 @@ template<sp_d T> SparseMatSuperLU<T>::SparseMatSuperLU(const SparseMatSuperLU& o
 
 template<sp_d T> SparseMatSuperLU<T>::~SparseMatSuperLU() {
     dealloc();
+    dealloc_pattern();
     StatFree(&stat);
 }
 
@@ -212,11 +317,54 @@ template<sp_d T> void SparseMatSuperLU<T>::zeros() {
 
 template<sp_d T> unique_ptr<MetaMat<T>> SparseMatSuperLU<T>::make_copy() { return std::make_unique<SparseMatSuperLU>(*this); }
 
+/**
+ * \brief If all pivots are taken from the diagonal, the factorisation is a symmetrically permuted \f$LDL^T\f$ so that
+ * the number of negative pivots can be counted. To this end, the matrix is factorised again in the symmetric mode if
+ * necessary, the original options are restored afterwards.
+ */
+template<sp_d T> uword SparseMatSuperLU<T>::inertia() {
+#ifdef SUANPAN_SUPERLUMT
+    throw invalid_argument("analysis requires the inertia but SuperLU MT does not support it");
+#else
+    if(IterativeSolver::NONE != this->setting.iterative_solver) throw invalid_argument("analysis requires the inertia but iterative solver does not support it");
+
+    const auto diagonal_pivot = [&] { return std::equal(perm_r, perm_r + this->n_rows, perm_c); };
+
+    if(!this->factored || !diagonal_pivot()) {
+        const auto symmetric_mode = options.SymmetricMode;
+        const auto pivot_threshold = options.DiagPivotThresh;
+
+        options.SymmetricMode = superlu::yes_no_t::YES;
+        options.DiagPivotThresh = 0.;
+
+        this->factored = false;
+
+        Mat<T> X;
+        const auto code = this->direct_solve(X, Mat<T>(this->n_rows, 1, fill::zeros));
+
+        // later factorisations follow the original setting
+        options.SymmetricMode = symmetric_mode;
+        options.DiagPivotThresh = pivot_threshold;
+
+        if(SUANPAN_SUCCESS != code) throw invalid_argument("fail to factorise the matrix");
+
+        if(!diagonal_pivot()) throw invalid_argument("inertia is not available as off-diagonal pivots are taken");
+    }
+
+    if(std::is_same_v<T, float> || Precision::FULL != this->setting.precision) return count_negative_pivot<float>();
+
+    return count_negative_pivot<double>();
+#endif
+}
+
 template<sp_d T> int SparseMatSuperLU<T>::direct_solve(Mat<T>& out_mat, Mat<T>&& in_mat) {
     if(this->factored) return solve_trs(out_mat, std::forward<Mat<T>>(in_mat));
 
     this->factored = true;
 
+    // keep zero-valued entries so that the pattern reuse check is structural
+    this->triplet_mat.csc_structure_condense();
+
     auto flag = 0;
 
     if constexpr(std::is_same_v<T, float>) {
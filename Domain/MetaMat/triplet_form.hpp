@@ -21,6 +21,8 @@
 #include <Toolbox/utility.h>
 #include <numeric>
 
+extern int SUANPAN_NUM_THREADS;
+
 template<sp_d data_t, sp_i index_t> class csc_form;
 template<sp_d data_t, sp_i index_t> class csr_form;
 
@@ -71,6 +73,10 @@ template<sp_d data_t, sp_i index_t> class triplet_form final {
 
     bool csc_sorted = false;
     bool csr_sorted = false;
+    bool condensed = false;
+
+    // compressed row/column pointer of a condensed and sorted pattern, empty if not available
+    std::vector<index_t> cmp_ptr;
 
     template<sp_d in_dt, sp_i in_it> void copy_to(const std::unique_ptr<in_it[]>& new_row_idx, const std::unique_ptr<in_it[]>& new_col_idx, const std::unique_ptr<in_dt[]>& new_val_idx, const index_t begin, const index_t row_offset, const index_t col_offset, const data_t scalar) const { copy_to(new_row_idx.get(), new_col_idx.get(), new_val_idx.get(), begin, row_offset, col_offset, scalar); }
 
@@ -101,9 +107,17 @@ template<sp_d data_t, sp_i index_t> class triplet_form final {
         val_idx = std::move(new_val_idx);
     }
 
-    void invalidate_sorting_flag() { csc_sorted = csr_sorted = false; }
+    void invalidate_sorting_flag() {
+        csc_sorted = csr_sorted = condensed = false;
+        cmp_ptr.clear();
+    }
+
+    void condense(bool = false, bool = false);
+
+    void compress();
 
-    void condense(bool = false);
+    Mat<data_t> csr_multiply(const Mat<data_t>&) const;
+    Mat<data_t> csc_multiply(const Mat<data_t>&) const;
 
     void populate_diagonal() {
         const auto t_elem = std::min(n_rows, n_cols);
@@ -166,6 +180,8 @@ public:
 
     [[nodiscard]] bool is_csc_sorted() const { return csc_sorted; }
 
+    [[nodiscard]] bool is_condensed() const { return condensed; }
+
     [[nodiscard]] bool is_empty() const { return 0 == n_elem; }
 
     [[nodiscard]] data_t max() const {
@@ -189,6 +205,19 @@ public:
         init(in_elem);
     }
 
+    /**
+     * \brief Check if the sparsity pattern, including the storage order, is identical to the given one, values are not compared.
+     */
+    [[nodiscard]] bool has_same_pattern(const triplet_form& in_mat) const {
+        if(n_rows != in_mat.n_rows || n_cols != in_mat.n_cols || n_elem != in_mat.n_elem) return false;
+        return std::equal(row_idx.get(), row_idx.get() + n_elem, in_mat.row_idx.get()) && std::equal(col_idx.get(), col_idx.get() + n_elem, in_mat.col_idx.get());
+    }
+
+    /**
+     * \brief Set all values to zero while keeping the sparsity pattern.
+     */
+    void zeros_val() { suanpan::for_each(n_elem, [&](const index_t I) { val_idx[I] = data_t(0); }); }
+
     data_t operator()(const index_t row, const index_t col) const {
         for(index_t I = 0; I < n_elem; ++I) if(row == row_idx[I] && col == col_idx[I]) return val_idx[I];
         return access::rw(bin) = 0.;
@@ -203,12 +232,20 @@ public:
 
     void csr_condense() {
         csr_sort();
-        condense(false);
+        if(!condensed) condense(false);
     }
 
     void csc_condense() {
         csc_sort();
-        condense(false);
+        if(!condensed) condense(false);
+    }
+
+    /**
+     * \brief Sum duplicates but keep zero-valued entries so that the resulting pattern only depends on the structure.
+     */
+    void csc_structure_condense() {
+        csc_sort();
+        if(!condensed) condense(false, true);
     }
 
     void full_csr_condense() {
@@ -235,6 +272,8 @@ public:
     }
 
     Mat<data_t> operator*(const Col<data_t>& in_mat) const {
+        if(!cmp_ptr.empty()) return csr_sorted ? csr_multiply(in_mat) : csc_multiply(in_mat);
+
         Mat<data_t> out_mat(in_mat.n_rows, in_mat.n_cols, fill::zeros);
 
         for(index_t I = 0; I < n_elem; ++I) out_mat(row_idx[I]) += val_idx[I] * in_mat(col_idx[I]);
@@ -243,6 +282,8 @@ public:
     }
 
     Mat<data_t> operator*(const Mat<data_t>& in_mat) const {
+        if(!cmp_ptr.empty()) return csr_sorted ? csr_multiply(in_mat) : csc_multiply(in_mat);
+
         Mat<data_t> out_mat(in_mat.n_rows, in_mat.n_cols, fill::zeros);
 
         for(index_t I = 0; I < n_elem; ++I) out_mat.row(row_idx[I]) += val_idx[I] * in_mat.row(col_idx[I]);
@@ -268,6 +309,8 @@ public:
     triplet_form& operator+=(const triplet_form&);
     triplet_form& operator-=(const triplet_form&);
 
+    [[nodiscard]] Col<uword> locate(const Col<uword>&) const;
+
     [[nodiscard]] Col<data_t> diag() const;
     [[nodiscard]] triplet_form diagonal() const;
     [[nodiscard]] triplet_form strictly_upper() const;
@@ -276,8 +319,10 @@ public:
     [[nodiscard]] triplet_form lower() const;
 };
 
-template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::condense(const bool full) {
-    if(n_elem < 2) return;
+template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::condense(const bool full, const bool structural) {
+    condensed = true;
+
+    if(n_elem < 2) return compress();
 
     auto last_row = row_idx[0], last_col = col_idx[0];
 
@@ -285,7 +330,7 @@ template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::condense
     sp_d auto last_sum = data_t(0);
 
     auto populate = [&] {
-        if(suanpan::approx_equal(last_sum, data_t(0)) && (!full || last_row != last_col)) return;
+        if(!structural && suanpan::approx_equal(last_sum, data_t(0)) && (!full || last_row != last_col)) return;
         row_idx[current_pos] = last_row;
         col_idx[current_pos] = last_col;
         val_idx[current_pos] = last_sum;
@@ -305,16 +350,118 @@ template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::condense
     populate();
 
     access::rw(n_elem) = current_pos;
+
+    compress();
+}
+
+/**
+ * \brief Build the compressed pointer of a condensed pattern so that products can be computed row/column-wise.
+ */
+template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::compress() {
+    cmp_ptr.clear();
+
+    if(!condensed || (!csr_sorted && !csc_sorted)) return;
+
+    const auto& major_idx = csr_sorted ? row_idx : col_idx;
+    const auto n_major = csr_sorted ? n_rows : n_cols;
+
+    cmp_ptr.assign(n_major + 1, index_t(0));
+    for(index_t I = 0; I < n_elem; ++I) ++cmp_ptr[major_idx[I] + 1];
+    for(index_t I = 0; I < n_major; ++I) cmp_ptr[I + 1] += cmp_ptr[I];
+}
+
+/**
+ * \brief Row-wise product of a CSR sorted pattern. Each row is independent and thus computed in parallel.
+ * For multiple right hand sides, the operand is transposed so that all columns of the same row are contiguous in memory.
+ */
+template<sp_d data_t, sp_i index_t> Mat<data_t> triplet_form<data_t, index_t>::csr_multiply(const Mat<data_t>& in_mat) const {
+    if(1 == in_mat.n_cols) {
+        Mat<data_t> out_mat(n_rows, 1);
+
+        const auto t_in = in_mat.memptr();
+        const auto t_out = out_mat.memptr();
+
+        suanpan::for_each(n_rows, [&](const index_t I) {
+            data_t t_sum = data_t(0);
+            for(auto J = cmp_ptr[I]; J < cmp_ptr[I + 1]; ++J) t_sum += val_idx[J] * t_in[col_idx[J]];
+            t_out[I] = t_sum;
+        });
+
+        return out_mat;
+    }
+
+    const Mat<data_t> t_in = in_mat.t();
+    Mat<data_t> out_mat(in_mat.n_cols, n_rows);
+
+    suanpan::for_each(n_rows, [&](const index_t I) {
+        const auto t_out = out_mat.colptr(I);
+        for(uword K = 0; K < in_mat.n_cols; ++K) t_out[K] = data_t(0);
+        for(auto J = cmp_ptr[I]; J < cmp_ptr[I + 1]; ++J) {
+            const auto t_val = val_idx[J];
+            const auto t_ptr = t_in.colptr(col_idx[J]);
+            for(uword K = 0; K < in_mat.n_cols; ++K) t_out[K] += t_val * t_ptr[K];
+        }
+    });
+
+    return out_mat.t();
+}
+
+/**
+ * \brief Column-wise product of a CSC sorted pattern.
+ * Columns are split into contiguous chunks, each chunk accumulates into its own buffer, buffers are reduced afterwards so that no locking is required.
+ * For multiple right hand sides, the same transposed layout as the CSR product is used.
+ */
+template<sp_d data_t, sp_i index_t> Mat<data_t> triplet_form<data_t, index_t>::csc_multiply(const Mat<data_t>& in_mat) const {
+#ifdef SUANPAN_MT
+    // keep each chunk reasonably large to amortise the cost of buffers
+    const auto n_chunk = std::max(index_t(1), std::min(index_t(SUANPAN_NUM_THREADS), n_cols / index_t(512)));
+#else
+    constexpr auto n_chunk = index_t(1);
+#endif
+
+    const auto n_rhs = in_mat.n_cols;
+    const Mat<data_t> t_in = 1 == n_rhs ? Mat<data_t>(const_cast<data_t*>(in_mat.memptr()), 1, in_mat.n_rows, false, true) : Mat<data_t>(in_mat.t());
+
+    Mat<data_t> out_mat(n_rhs, n_rows, fill::zeros);
+    std::vector<Mat<data_t>> partial(n_chunk - 1);
+
+    suanpan::for_each(n_chunk, [&](const index_t C) {
+        if(0 != C) partial[C - 1].zeros(n_rhs, n_rows);
+        auto& t_mat = 0 == C ? out_mat : partial[C - 1];
+        const auto t_begin = index_t(uword(n_cols) * C / n_chunk), t_end = index_t(uword(n_cols) * (C + 1) / n_chunk);
+        if(1 == n_rhs) {
+            const auto t_out = t_mat.memptr();
+            for(auto I = t_begin; I < t_end; ++I) {
+                const auto t_val = t_in(I);
+                for(auto J = cmp_ptr[I]; J < cmp_ptr[I + 1]; ++J) t_out[row_idx[J]] += val_idx[J] * t_val;
+            }
+        }
+        else
+            for(auto I = t_begin; I < t_end; ++I) {
+                const auto t_ptr = t_in.colptr(I);
+                for(auto J = cmp_ptr[I]; J < cmp_ptr[I + 1]; ++J) {
+                    const auto t_val = val_idx[J];
+                    const auto t_out = t_mat.colptr(row_idx[J]);
+                    for(uword K = 0; K < n_rhs; ++K) t_out[K] += t_val * t_ptr[K];
+                }
+            }
+    });
+
+    if(!partial.empty()) suanpan::for_each(out_mat.n_elem, [&](const uword I) { for(const auto& t_mat : partial) out_mat(I) += t_mat(I); });
+
+    return out_mat.t();
 }
 
 template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>::triplet_form(const triplet_form& in_mat)
-    : csc_sorted{in_mat.csc_sorted}
-    , csr_sorted{in_mat.csr_sorted}
-    , n_rows{in_mat.n_rows}
+    : n_rows{in_mat.n_rows}
     , n_cols{in_mat.n_cols} {
     init(in_mat.n_alloc);
     in_mat.copy_to(row_idx, col_idx, val_idx, 0, 0, 0, 1);
     access::rw(n_elem) = in_mat.n_elem;
+    csc_sorted = in_mat.csc_sorted;
+    csr_sorted = in_mat.csr_sorted;
+    condensed = in_mat.condensed;
+    cmp_ptr = in_mat.cmp_ptr;
 }
 
 template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>::triplet_form(triplet_form&& in_mat) noexcept
@@ -323,6 +470,8 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>::triplet_form(
     , val_idx{std::move(in_mat.val_idx)}
     , csc_sorted{in_mat.csc_sorted}
     , csr_sorted{in_mat.csr_sorted}
+    , condensed{in_mat.condensed}
+    , cmp_ptr{std::move(in_mat.cmp_ptr)}
     , n_rows{in_mat.n_rows}
     , n_cols{in_mat.n_cols}
     , n_elem{in_mat.n_elem}
@@ -330,13 +479,15 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>::triplet_form(
 
 template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>& triplet_form<data_t, index_t>::operator=(const triplet_form& in_mat) {
     if(this == &in_mat) return *this;
-    csc_sorted = in_mat.csc_sorted;
-    csr_sorted = in_mat.csr_sorted;
     access::rw(n_rows) = in_mat.n_rows;
     access::rw(n_cols) = in_mat.n_cols;
     init(in_mat.n_alloc);
     in_mat.copy_to(row_idx, col_idx, val_idx, 0, 0, 0, 1);
     access::rw(n_elem) = in_mat.n_elem;
+    csc_sorted = in_mat.csc_sorted;
+    csr_sorted = in_mat.csr_sorted;
+    condensed = in_mat.condensed;
+    cmp_ptr = in_mat.cmp_ptr;
     return *this;
 }
 
@@ -344,6 +495,8 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>& triplet_form<
     if(this == &in_mat) return *this;
     csc_sorted = in_mat.csc_sorted;
     csr_sorted = in_mat.csr_sorted;
+    condensed = in_mat.condensed;
+    cmp_ptr = std::move(in_mat.cmp_ptr);
     access::rw(n_rows) = in_mat.n_rows;
     access::rw(n_cols) = in_mat.n_cols;
     access::rw(n_elem) = in_mat.n_elem;
@@ -425,6 +578,8 @@ template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::csr_sort
 
     csr_sorted = true;
     csc_sorted = false;
+
+    compress();
 }
 
 template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::csc_sort() {
@@ -451,6 +606,8 @@ template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::csc_sort
 
     csc_sorted = true;
     csr_sorted = false;
+
+    compress();
 }
 
 template<sp_d data_t, sp_i index_t> void triplet_form<data_t, index_t>::assemble(const Mat<data_t>& in_mat, const Col<uword>& in_dof) {
@@ -568,6 +725,33 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t>& triplet_form<
     return *this;
 }
 
+/**
+ * \brief Locate the storage position of each entry of a dense block in a condensed CSC pattern.
+ * The block is assumed to be stored in column-major order with the given DoF encoding.
+ */
+template<sp_d data_t, sp_i index_t> Col<uword> triplet_form<data_t, index_t>::locate(const Col<uword>& in_dof) const {
+    if(!csc_sorted || !condensed) throw invalid_argument("pattern needs to be csc condensed");
+
+    Col<uword> position(in_dof.n_elem * in_dof.n_elem);
+
+    suanpan::for_each(position.n_elem, [&](const uword I) {
+        const auto t_row = index_t(in_dof(I % in_dof.n_elem)), t_col = index_t(in_dof(I / in_dof.n_elem));
+
+        index_t low = 0, high = n_elem;
+        while(low < high) {
+            const auto mid = low + (high - low) / 2;
+            if(col_idx[mid] < t_col || (col_idx[mid] == t_col && row_idx[mid] < t_row)) low = mid + 1;
+            else high = mid;
+        }
+
+        if(low == n_elem || row_idx[low] != t_row || col_idx[low] != t_col) throw invalid_argument("entry not found in pattern");
+
+        position(I) = uword(low);
+    });
+
+    return position;
+}
+
 template<sp_d data_t, sp_i index_t> Col<data_t> triplet_form<data_t, index_t>::diag() const {
     Col<data_t> diag_vec(std::min(n_rows, n_cols), fill::zeros);
     for(index_t I = 0; I < n_elem; ++I) if(row(I) == col(I)) diag_vec(row(I)) += val(I);
@@ -601,7 +785,18 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t> triplet_form<d
 template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t> triplet_form<data_t, index_t>::upper() const {
     auto out_mat = *this;
 
-    suanpan::for_each(out_mat.n_elem, [&](const index_t I) { out_mat.val_idx[I] *= out_mat.row(I) <= out_mat.col(I); });
+    // entries are removed rather than zeroed so that the pattern of the triangle does not depend on values
+    index_t current_pos = 0;
+    for(index_t I = 0; I < n_elem; ++I)
+        if(row_idx[I] <= col_idx[I]) {
+            out_mat.row_idx[current_pos] = row_idx[I];
+            out_mat.col_idx[current_pos] = col_idx[I];
+            out_mat.val_idx[current_pos] = val_idx[I];
+            ++current_pos;
+        }
+
+    access::rw(out_mat.n_elem) = current_pos;
+    out_mat.compress();
 
     return out_mat;
 }
@@ -609,7 +804,17 @@ template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t> triplet_form<d
 template<sp_d data_t, sp_i index_t> triplet_form<data_t, index_t> triplet_form<data_t, index_t>::lower() const {
     auto out_mat = *this;
 
-    suanpan::for_each(out_mat.n_elem, [&](const index_t I) { out_mat.val_idx[I] *= out_mat.col(I) <= out_mat.row(I); });
+    index_t current_pos = 0;
+    for(index_t I = 0; I < n_elem; ++I)
+        if(col_idx[I] <= row_idx[I]) {
+            out_mat.row_idx[current_pos] = row_idx[I];
+            out_mat.col_idx[current_pos] = col_idx[I];
+            out_mat.val_idx[current_pos] = val_idx[I];
+            ++current_pos;
+        }
+
+    access::rw(out_mat.n_elem) = current_pos;
+    out_mat.compress();
 
     return out_mat;
 }
@@ -19,6 +19,7 @@
 #include <Domain/DOF.h>
 #include <Domain/DomainBase.h>
 #include <Recorder/OutputType.h>
+#include <Toolbox/state_archive.h>
 #include <Toolbox/utility.h>
 
 Node::Node(const unsigned T)
@@ -526,6 +527,12 @@ void Node::clear_status() {
     set_initialized(false);
 }
 
+void Node::archive(state_archive& A) {
+    A(current_resistance, current_damping_force, current_nonviscous_force, current_inertial_force, current_displacement, current_velocity, current_acceleration);
+    A(incre_resistance, incre_damping_force, incre_nonviscous_force, incre_inertial_force, incre_displacement, incre_velocity, incre_acceleration);
+    A(trial_resistance, trial_damping_force, trial_nonviscous_force, trial_inertial_force, trial_displacement, trial_velocity, trial_acceleration);
+}
+
 std::vector<vec> Node::record(const OutputType L) const {
     std::vector<vec> data;
 
@@ -41,6 +41,7 @@
 #include <Domain/Tag.h>
 
 class DomainBase;
+class state_archive;
 enum class OutputType;
 enum class DOF : unsigned short;
 
@@ -206,6 +207,8 @@ public:
 
     [[nodiscard]] std::vector<vec> record(OutputType) const;
 
+    void archive(state_archive&);
+
     void print() override;
 };
 
@@ -108,6 +108,11 @@ int B21::reset_status() {
     return code;
 }
 
+void B21::archive(state_archive& A) {
+    SectionElement2D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> B21::record(const OutputType P) {
     vector<vec> data;
     for(const auto& I : int_pt) append_to(data, I.b_section->record(P));
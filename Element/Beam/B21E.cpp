@@ -89,3 +89,8 @@ int B21E::reset_status() {
     trial_rotation = current_rotation;
     return B21::reset_status();
 }
+
+void B21E::archive(state_archive& A) {
+    B21::archive(A);
+    A(trial_rotation, current_rotation);
+}
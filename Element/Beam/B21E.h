@@ -55,6 +55,8 @@ public:
     int commit_status() override;
     int clear_status() override;
     int reset_status() override;
+
+    void archive(state_archive&) override;
 };
 
 #endif
@@ -118,6 +118,11 @@ int B21H::reset_status() {
     return code;
 }
 
+void B21H::archive(state_archive& A) {
+    SectionElement2D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> B21H::record(const OutputType P) {
     vector<vec> data;
     append_to(data, int_pt[0].b_section->record(P));
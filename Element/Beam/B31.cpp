@@ -128,6 +128,11 @@ int B31::reset_status() {
     return code;
 }
 
+void B31::archive(state_archive& A) {
+    SectionElement3D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> B31::record(const OutputType P) {
     vector<vec> data;
     for(const auto& I : int_pt) append_to(data, I.b_section->record(P));
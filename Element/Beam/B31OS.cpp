@@ -189,6 +189,11 @@ int B31OS::reset_status() {
     return code;
 }
 
+void B31OS::archive(state_archive& A) {
+    SectionOSElement3D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> B31OS::record(const OutputType P) {
     vector<vec> data;
     for(const auto& I : int_pt) append_to(data, I.b_section->record(P));
@@ -76,6 +76,11 @@ int EB21::reset_status() {
     return b_material->reset_status();
 }
 
+void EB21::archive(state_archive& A) {
+    MaterialElement1D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> EB21::record(const OutputType P) {
     if(P == OutputType::BEAME) return {b_trans->to_local_vec(get_current_displacement())};
     if(P == OutputType::BEAMS) return {vec{local_stiff * b_trans->to_local_vec(get_current_displacement())}};
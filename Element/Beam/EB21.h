@@ -60,6 +60,8 @@ public:
     int clear_status() override;
     int reset_status() override;
 
+    void archive(state_archive&) override;
+
     vector<vec> record(OutputType) override;
 
     void print() override;
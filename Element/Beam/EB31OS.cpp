@@ -127,6 +127,11 @@ int EB31OS::reset_status() {
     return SUANPAN_SUCCESS;
 }
 
+void EB31OS::archive(state_archive& A) {
+    SectionOSElement3D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> EB31OS::record(const OutputType P) {
     if(P == OutputType::BEAME) return {b_trans->to_local_vec(get_current_displacement())};
     if(P == OutputType::BEAMS) return {vec{local_stiff * b_trans->to_local_vec(get_current_displacement())}};
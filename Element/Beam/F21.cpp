@@ -136,6 +136,12 @@ int F21::reset_status() {
     return code;
 }
 
+void F21::archive(state_archive& A) {
+    SectionElement2D::archive(A);
+    b_trans->archive(A);
+    A(current_local_flexibility, trial_local_flexibility, current_local_deformation, trial_local_deformation, current_local_resistance, trial_local_resistance);
+}
+
 vector<vec> F21::record(const OutputType P) {
     if(P == OutputType::BEAME) return {current_local_deformation};
     if(P == OutputType::BEAMS) return {current_local_resistance};
@@ -166,6 +166,12 @@ int F21H::reset_status() {
     return code;
 }
 
+void F21H::archive(state_archive& A) {
+    SectionElement2D::archive(A);
+    b_trans->archive(A);
+    A(current_local_flexibility, trial_local_flexibility, current_local_deformation, trial_local_deformation, current_local_resistance, trial_local_resistance);
+}
+
 vector<vec> F21H::record(const OutputType P) {
     if(P == OutputType::BEAME) return {current_local_deformation};
     if(P == OutputType::BEAMS) return {current_local_resistance};
@@ -156,6 +156,12 @@ int F31::reset_status() {
     return code;
 }
 
+void F31::archive(state_archive& A) {
+    SectionElement3D::archive(A);
+    b_trans->archive(A);
+    A(current_local_flexibility, trial_local_flexibility, current_local_deformation, trial_local_deformation, current_local_resistance, trial_local_resistance);
+}
+
 vector<vec> F31::record(const OutputType P) {
     if(P == OutputType::BEAME) return {current_local_deformation};
     if(P == OutputType::BEAMS) return {current_local_resistance};
@@ -67,6 +67,11 @@ int NMB21::reset_status() {
     return b_section->reset_status();
 }
 
+void NMB21::archive(state_archive& A) {
+    SectionNMElement2D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> NMB21::record(const OutputType P) {
     if(P == OutputType::BEAME) return {b_section->get_current_deformation() * length};
     if(P == OutputType::BEAMS) return {b_section->get_current_resistance()};
@@ -74,3 +74,8 @@ int NMB21E::reset_status() {
     trial_local_deformation = current_local_deformation;
     return NMB21::reset_status();
 }
+
+void NMB21E::archive(state_archive& A) {
+    NMB21::archive(A);
+    A(trial_local_deformation, current_local_deformation);
+}
@@ -83,6 +83,11 @@ int NMB31::reset_status() {
     return b_section->reset_status();
 }
 
+void NMB31::archive(state_archive& A) {
+    SectionNMElement3D::archive(A);
+    b_trans->archive(A);
+}
+
 vector<vec> NMB31::record(const OutputType P) {
     if(P == OutputType::BEAME) return {b_section->get_current_deformation() * length};
     if(P == OutputType::BEAMS) return {b_section->get_current_resistance()};
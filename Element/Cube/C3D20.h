@@ -32,17 +32,17 @@
 #include <Element/MaterialElement.h>
 
 class C3D20 final : public MaterialElement3D {
+    static constexpr unsigned c_node = 20, c_dof = 3, c_size = c_dof * c_node;
+
     struct IntegrationPoint final {
         vec coor;
         double weight;
         unique_ptr<Material> c_material;
         mat pn_pxyz;
-        sp_mat strain_mat;
+        mat::fixed<6, c_size> strain_mat;
         IntegrationPoint(vec&&, double, unique_ptr<Material>&&, mat&&);
     };
 
-    static constexpr unsigned c_node = 20, c_dof = 3, c_size = c_dof * c_node;
-
     const bool reduced_scheme;
 
     vector<IntegrationPoint> int_pt;
@@ -17,6 +17,7 @@
 
 #include "C3D8.h"
 #include <Domain/DomainBase.h>
+#include <Element/Utility/FixedKernel.hpp>
 #include <Material/Material3D/Material3D.h>
 #include <Recorder/OutputType.h>
 #include <Toolbox/IntegrationPlan.h>
@@ -30,7 +31,7 @@ C3D8::IntegrationPoint::IntegrationPoint(vec&& C, const double W, unique_ptr<Mat
     , weight(W)
     , c_material(std::move(M))
     , pn_pxyz(std::move(P))
-    , strain_mat(6, c_size) {
+    , strain_mat(fill::zeros) {
     for(auto I = 0u, J = 0u, K = 1u, L = 2u; I < c_node; ++I, J += c_dof, K += c_dof, L += c_dof) {
         strain_mat(0, J) = strain_mat(3, K) = strain_mat(5, L) = pn_pxyz(0, I);
         strain_mat(3, J) = strain_mat(1, K) = strain_mat(4, L) = pn_pxyz(1, I);
@@ -108,67 +109,34 @@ int C3D8::update_status() {
     trial_resistance.zeros(c_size);
 
     if(nlgeom) {
-        const mat ele_disp = reshape(t_disp, c_dof, c_node);
-
         trial_geometry.zeros(c_size, c_size);
 
-        mat BN(6, c_size);
+        mat::fixed<c_dof, c_dof> gradient;
+        vec::fixed<6> t_strain;
+        mat::fixed<6, c_size> BN;
         for(const auto& I : int_pt) {
-            const mat gradient = ele_disp * I.pn_pxyz.t() + eye(c_dof, c_dof);
-            for(unsigned J = 0, K = 0, L = 1, M = 2; J < c_node; ++J, K += c_dof, L += c_dof, M += c_dof) {
-                BN(0, K) = I.pn_pxyz(0, J) * gradient(0, 0);
-                BN(1, K) = I.pn_pxyz(1, J) * gradient(0, 1);
-                BN(2, K) = I.pn_pxyz(2, J) * gradient(0, 2);
-                BN(0, L) = I.pn_pxyz(0, J) * gradient(1, 0);
-                BN(1, L) = I.pn_pxyz(1, J) * gradient(1, 1);
-                BN(2, L) = I.pn_pxyz(2, J) * gradient(1, 2);
-                BN(0, M) = I.pn_pxyz(0, J) * gradient(2, 0);
-                BN(1, M) = I.pn_pxyz(1, J) * gradient(2, 1);
-                BN(2, M) = I.pn_pxyz(2, J) * gradient(2, 2);
-                BN(3, K) = I.pn_pxyz(0, J) * gradient(0, 1) + I.pn_pxyz(1, J) * gradient(0, 0);
-                BN(4, K) = I.pn_pxyz(1, J) * gradient(0, 2) + I.pn_pxyz(2, J) * gradient(0, 1);
-                BN(5, K) = I.pn_pxyz(2, J) * gradient(0, 0) + I.pn_pxyz(0, J) * gradient(0, 2);
-                BN(3, L) = I.pn_pxyz(0, J) * gradient(1, 1) + I.pn_pxyz(1, J) * gradient(1, 0);
-                BN(4, L) = I.pn_pxyz(1, J) * gradient(1, 2) + I.pn_pxyz(2, J) * gradient(1, 1);
-                BN(5, L) = I.pn_pxyz(2, J) * gradient(1, 0) + I.pn_pxyz(0, J) * gradient(1, 2);
-                BN(3, M) = I.pn_pxyz(0, J) * gradient(2, 1) + I.pn_pxyz(1, J) * gradient(2, 0);
-                BN(4, M) = I.pn_pxyz(1, J) * gradient(2, 2) + I.pn_pxyz(2, J) * gradient(2, 1);
-                BN(5, M) = I.pn_pxyz(2, J) * gradient(2, 0) + I.pn_pxyz(0, J) * gradient(2, 2);
-            }
-
-            if(I.c_material->update_trial_status(tensor::strain::to_voigt(tensor::strain::to_green(gradient))) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
+            suanpan::kernel::deformation_gradient<c_dof, c_node>(gradient, t_disp, I.pn_pxyz);
+            suanpan::kernel::nonlinear_strain_mat<c_dof, c_node>(BN, I.pn_pxyz, gradient);
+            suanpan::kernel::green_strain<c_dof>(t_strain, gradient);
+
+            if(I.c_material->update_trial_status(t_strain) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
 
             auto& t_stress = I.c_material->get_trial_stress();
 
-            const auto sigma = tensor::stress::to_tensor(t_stress);
-
-            for(unsigned J = 0, K = 0, L = 1, M = 2; J < c_node; ++J, K += c_dof, L += c_dof, M += c_dof) {
-                const vec t_vec = I.weight * sigma * I.pn_pxyz.col(J);
-                auto t_factor = dot(I.pn_pxyz.col(J), t_vec);
-                trial_geometry(K, K) += t_factor;
-                trial_geometry(L, L) += t_factor;
-                trial_geometry(M, M) += t_factor;
-                for(auto N = J + 1, O = c_dof * N, P = O + 1, Q = P + 1; N < c_node; ++N, O += c_dof, P += c_dof, Q += c_dof) {
-                    t_factor = dot(I.pn_pxyz.col(N), t_vec);
-                    trial_geometry(O, K) += t_factor;
-                    trial_geometry(P, L) += t_factor;
-                    trial_geometry(Q, M) += t_factor;
-                    trial_geometry(K, O) += t_factor;
-                    trial_geometry(L, P) += t_factor;
-                    trial_geometry(M, Q) += t_factor;
-                }
-            }
-
-            trial_stiffness += I.weight * BN.t() * I.c_material->get_trial_stiffness() * BN;
-            trial_resistance += I.weight * BN.t() * t_stress;
+            suanpan::kernel::geometric_stiffness<c_dof, c_node>(trial_geometry, I.pn_pxyz, t_stress, I.weight);
+            suanpan::kernel::btdb(trial_stiffness, BN, I.c_material->get_trial_stiffness(), I.weight);
+            suanpan::kernel::bts(trial_resistance, BN, t_stress, I.weight);
         }
     }
-    else
+    else {
+        vec::fixed<6> t_strain;
         for(const auto& I : int_pt) {
-            if(I.c_material->update_trial_status(I.strain_mat * t_disp) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
-            trial_stiffness += I.weight * I.strain_mat.t() * I.c_material->get_trial_stiffness() * I.strain_mat;
-            trial_resistance += I.weight * I.strain_mat.t() * I.c_material->get_trial_stress();
+            suanpan::kernel::bu(t_strain, I.strain_mat, t_disp);
+            if(I.c_material->update_trial_status(t_strain) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
+            suanpan::kernel::btdb(trial_stiffness, I.strain_mat, I.c_material->get_trial_stiffness(), I.weight);
+            suanpan::kernel::bts(trial_resistance, I.strain_mat, I.c_material->get_trial_stress(), I.weight);
         }
+    }
 
     if(hourglass_control) {
         trial_stiffness += hourglass;
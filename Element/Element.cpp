@@ -16,6 +16,7 @@
  ******************************************************************************/
 
 #include "Element.h"
+#include "ElementArena.h"
 #include <Domain/DOF.h>
 #include <Domain/DomainBase.h>
 #include <Domain/Group/Group.h>
@@ -404,6 +405,9 @@ void Element::update_dof_encoding() {
     for(auto I = 0llu; I < dof_index.n_elem; ++I) for(auto J = I; J < dof_index.n_elem; ++J) dof_mapping.emplace_back(MappingDOF{dof_reordered(J), dof_reordered(I), dof_index(J), dof_index(I)});
     std::sort(dof_mapping.begin(), dof_mapping.end(), [](const MappingDOF& A, const MappingDOF& B) { return A.l_col == B.l_col ? A.l_row < B.l_row : A.l_col < B.l_col; });
 
+    // any existing pattern is invalidated by the new encoding
+    sparse_mapping.reset();
+
     if(!dof_identifier.empty()) for(const auto& t_ptr : node_ptr) t_ptr.lock()->set_dof_identifier(dof_identifier);
 }
 
@@ -429,6 +433,10 @@ const uvec& Element::get_node_encoding() const { return node_encoding; }
 
 const std::vector<MappingDOF>& Element::get_dof_mapping() const { return dof_mapping; }
 
+void Element::set_sparse_mapping(uvec&& M) { sparse_mapping = std::move(M); }
+
+const uvec& Element::get_sparse_mapping() const { return sparse_mapping; }
+
 const uvec& Element::get_material_tag() const { return material_tag; }
 
 const uvec& Element::get_section_tag() const { return section_tag; }
@@ -552,28 +560,28 @@ int Element::commit_status() {
     update_complementary_energy();
     update_momentum();
 
-    if(update_mass && !trial_mass.is_empty()) current_mass = trial_mass;
-    if(update_viscous && !trial_viscous.is_empty()) current_viscous = trial_viscous;
-    if(update_stiffness && !trial_stiffness.is_empty()) current_stiffness = trial_stiffness;
-    if(update_geometry && !trial_geometry.is_empty()) current_geometry = trial_geometry;
-    if(!trial_resistance.is_empty()) current_resistance = trial_resistance;
-    if(!trial_viscous_force.is_empty()) current_viscous_force = trial_viscous_force;
+    if(update_mass && !trial_mass.is_empty() && !ElementArena::is_hosted(trial_mass, current_mass)) current_mass = trial_mass;
+    if(update_viscous && !trial_viscous.is_empty() && !ElementArena::is_hosted(trial_viscous, current_viscous)) current_viscous = trial_viscous;
+    if(update_stiffness && !trial_stiffness.is_empty() && !ElementArena::is_hosted(trial_stiffness, current_stiffness)) current_stiffness = trial_stiffness;
+    if(update_geometry && !trial_geometry.is_empty() && !ElementArena::is_hosted(trial_geometry, current_geometry)) current_geometry = trial_geometry;
+    if(!trial_resistance.is_empty() && !ElementArena::is_hosted(trial_resistance, current_resistance)) current_resistance = trial_resistance;
+    if(!trial_viscous_force.is_empty() && !ElementArena::is_hosted(trial_viscous_force, current_viscous_force)) current_viscous_force = trial_viscous_force;
     if(!trial_nonviscous_force.is_empty()) current_nonviscous_force = trial_nonviscous_force;
-    if(!trial_inertial_force.is_empty()) current_inertial_force = trial_inertial_force;
+    if(!trial_inertial_force.is_empty() && !ElementArena::is_hosted(trial_inertial_force, current_inertial_force)) current_inertial_force = trial_inertial_force;
 
     return SUANPAN_SUCCESS;
 }
 
 int Element::reset_status() {
-    if(update_mass && !trial_mass.is_empty()) trial_mass = current_mass;
-    if(update_viscous && !trial_viscous.is_empty()) trial_viscous = current_viscous;
+    if(update_mass && !trial_mass.is_empty() && !ElementArena::is_hosted(trial_mass, current_mass)) trial_mass = current_mass;
+    if(update_viscous && !trial_viscous.is_empty() && !ElementArena::is_hosted(trial_viscous, current_viscous)) trial_viscous = current_viscous;
     if(update_nonviscous && !trial_nonviscous.is_empty()) trial_nonviscous = current_nonviscous;
-    if(update_stiffness && !trial_stiffness.is_empty()) trial_stiffness = current_stiffness;
-    if(update_geometry && !trial_geometry.is_empty()) trial_geometry = current_geometry;
-    if(!trial_resistance.is_empty()) trial_resistance = current_resistance;
-    if(!trial_viscous_force.is_empty()) trial_viscous_force = current_viscous_force;
+    if(update_stiffness && !trial_stiffness.is_empty() && !ElementArena::is_hosted(trial_stiffness, current_stiffness)) trial_stiffness = current_stiffness;
+    if(update_geometry && !trial_geometry.is_empty() && !ElementArena::is_hosted(trial_geometry, current_geometry)) trial_geometry = current_geometry;
+    if(!trial_resistance.is_empty() && !ElementArena::is_hosted(trial_resistance, current_resistance)) trial_resistance = current_resistance;
+    if(!trial_viscous_force.is_empty() && !ElementArena::is_hosted(trial_viscous_force, current_viscous_force)) trial_viscous_force = current_viscous_force;
     if(!trial_nonviscous_force.is_empty()) trial_nonviscous_force = current_nonviscous_force;
-    if(!trial_inertial_force.is_empty()) trial_inertial_force = current_inertial_force;
+    if(!trial_inertial_force.is_empty() && !ElementArena::is_hosted(trial_inertial_force, current_inertial_force)) trial_inertial_force = current_inertial_force;
 
     return SUANPAN_SUCCESS;
 }
@@ -584,6 +592,19 @@ const vec& Element::update_traction(const vec& load_factor) { return traction.is
 
 std::vector<vec> Element::record(const OutputType) { return {}; }
 
+void Element::archive(state_archive& A) {
+    A(trial_mass, trial_viscous, trial_nonviscous, trial_stiffness, trial_geometry);
+    A(current_mass, current_viscous, current_nonviscous, current_stiffness, current_geometry);
+    A(trial_resistance, trial_viscous_force, trial_nonviscous_force, trial_inertial_force);
+    A(current_resistance, current_viscous_force, current_nonviscous_force, current_inertial_force);
+    A(trial_body_force, current_body_force, trial_traction, current_traction);
+    A(strain_energy, kinetic_energy, viscous_energy, nonviscous_energy, complementary_energy, momentum);
+
+    registry.archive(A);
+}
+
+state_registry& Element::get_registry() { return registry; }
+
 double Element::get_strain_energy() const { return strain_energy; }
 
 double Element::get_complementary_energy() const { return complementary_energy; }
@@ -29,6 +29,7 @@
 #define ELEMENT_H
 
 #include <Element/ElementBase.h>
+#include <Toolbox/state_archive.h>
 
 enum class MaterialType : unsigned;
 enum class SectionType : unsigned;
@@ -131,6 +132,12 @@ class Element : protected DataElement, public ElementBase {
 
     std::vector<MappingDOF> dof_mapping;
 
+    uvec sparse_mapping; // storage position of each local entry in the frozen global sparse pattern
+
+    state_registry registry; // materials and sections owned by this element
+
+    friend class ElementArena;
+
     friend void ConstantMass(DataElement*);
     friend void ConstantDamping(DataElement*);
     friend void ConstantStiffness(DataElement*);
@@ -226,6 +233,9 @@ public:
 
     [[nodiscard]] const std::vector<MappingDOF>& get_dof_mapping() const override;
 
+    void set_sparse_mapping(uvec&&) override;
+    [[nodiscard]] const uvec& get_sparse_mapping() const override;
+
     [[nodiscard]] const uvec& get_material_tag() const override;
     [[nodiscard]] const uvec& get_section_tag() const override;
 
@@ -293,6 +303,18 @@ public:
 
     std::vector<vec> record(OutputType) override;
 
+    /**
+     * \brief Archive the common state and the state of owned materials and sections.
+     * Elements with additional history variables shall override this method and call the base version.
+     * The same applies to orientations and to materials and sections not copied in `initialize()`, which are not enrolled.
+     */
+    void archive(state_archive&) override;
+
+    /**
+     * \brief Materials and sections copied within the scope of the registry are owned by this element.
+     */
+    state_registry& get_registry();
+
     [[nodiscard]] double get_strain_energy() const override;
     [[nodiscard]] double get_complementary_energy() const override;
     [[nodiscard]] double get_kinetic_energy() const override;
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "ElementArena.h"
+#include <Element/Element.h>
+
+/**
+ * \brief Copy between the two pools, containers detached from the pools are skipped.
+ * \param commit `true` to copy trial to current, `false` to copy current to trial
+ */
+void ElementArena::Field::sync(const bool commit) {
+    const auto& source = commit ? trial_pool : current_pool;
+    auto& target = commit ? current_pool : trial_pool;
+
+    auto bulk_copy = [&](const uword start, const uword end) { if(end > start) std::copy(source.data() + start, source.data() + end, target.data() + start); };
+
+    // merge consecutive hosted slots into a single copy
+    uword start = 0, end = 0;
+    for(const auto& [trial, current, offset, size] : slot) {
+        if(trial->memptr() == trial_pool.data() + offset && current->memptr() == current_pool.data() + offset && trial->n_elem == size && current->n_elem == size) {
+            if(offset != end) {
+                bulk_copy(start, end);
+                start = offset;
+            }
+            end = offset + size;
+        }
+    }
+    bulk_copy(start, end);
+}
+
+std::array<std::pair<mat*, mat*>, ElementArena::num_field> ElementArena::get_state(Element& E) {
+    // matrices that are not updated are constant and not hosted
+    return {
+        E.update_mass ? std::pair<mat*, mat*>{&E.trial_mass, &E.current_mass} : std::pair<mat*, mat*>{nullptr, nullptr},
+        E.update_viscous ? std::pair<mat*, mat*>{&E.trial_viscous, &E.current_viscous} : std::pair<mat*, mat*>{nullptr, nullptr},
+        E.update_stiffness ? std::pair<mat*, mat*>{&E.trial_stiffness, &E.current_stiffness} : std::pair<mat*, mat*>{nullptr, nullptr},
+        E.update_geometry ? std::pair<mat*, mat*>{&E.trial_geometry, &E.current_geometry} : std::pair<mat*, mat*>{nullptr, nullptr},
+        std::pair<mat*, mat*>{&E.trial_resistance, &E.current_resistance},
+        std::pair<mat*, mat*>{&E.trial_viscous_force, &E.current_viscous_force},
+        std::pair<mat*, mat*>{&E.trial_inertial_force, &E.current_inertial_force},
+    };
+}
+
+ElementArena::ElementArena(const std::vector<shared_ptr<Element>>& in_pool)
+    : element_pool(in_pool) {
+    for(const auto& I : element_pool) {
+        const auto state = get_state(*I);
+        for(auto J = 0llu; J < num_field; ++J) {
+            const auto [trial, current] = state[J];
+            if(nullptr == trial || trial->is_empty() || trial->n_elem != current->n_elem) continue;
+            auto& field = field_pool[J];
+            field.slot.emplace_back(Slot{trial, current, field.size, trial->n_elem});
+            field.size += trial->n_elem;
+        }
+    }
+
+    // pools are fully allocated before any container is bound so that no reallocation happens afterwards
+    suanpan::for_all(field_pool, [](Field& field) {
+        field.trial_pool.resize(field.size);
+        field.current_pool.resize(field.size);
+        for(const auto& [trial, current, offset, size] : field.slot) {
+            std::copy(trial->memptr(), trial->memptr() + size, field.trial_pool.data() + offset);
+            std::copy(current->memptr(), current->memptr() + size, field.current_pool.data() + offset);
+
+            mat trial_view(field.trial_pool.data() + offset, trial->n_rows, trial->n_cols, false, false);
+            mat current_view(field.current_pool.data() + offset, current->n_rows, current->n_cols, false, false);
+
+            trial->steal_mem(trial_view);
+            current->steal_mem(current_view);
+        }
+    });
+}
+
+ElementArena::~ElementArena() {
+    // hand memory back to elements before pools are released
+    suanpan::for_all(field_pool, [](Field& field) {
+        for(const auto& [trial, current, offset, size] : field.slot) {
+            if(trial->memptr() == field.trial_pool.data() + offset) {
+                const mat copy = *trial;
+                trial->reset();
+                *trial = copy;
+            }
+            if(current->memptr() == field.current_pool.data() + offset) {
+                const mat copy = *current;
+                current->reset();
+                *current = copy;
+            }
+        }
+    });
+}
+
+/**
+ * \brief Check if a pair of trial and current containers is managed by an arena.
+ * Only auxiliary memory (mem_state 1) is used to bind containers to pools.
+ */
+bool ElementArena::is_hosted(const mat& trial, const mat& current) { return 1 == trial.mem_state && 1 == current.mem_state; }
+
+void ElementArena::commit_status() {
+    suanpan::for_all(field_pool, [](Field& field) { field.sync(true); });
+}
+
+void ElementArena::reset_status() {
+    suanpan::for_all(field_pool, [](Field& field) { field.sync(false); });
+}
+
+uword ElementArena::get_size() const { return std::transform_reduce(field_pool.cbegin(), field_pool.cend(), uword{0}, std::plus(), [](const Field& field) { return 2 * field.size; }); }
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class ElementArena
+ * @brief An ElementArena class hosts trial and current state containers of elements in contiguous pools.
+ *
+ * For each state field (mass, stiffness, resistance, etc.), the trial and current containers of all elements
+ * are placed in two contiguous pools, element containers become non-owning views into the pools.
+ * Committing and resetting status thus become bulk copies between two pools.
+ *
+ * If an element resizes a hosted container, Armadillo allocates new memory and the container is detached from the pool.
+ * Such a container is skipped by the arena and synchronised by the element as usual.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file ElementArena.h
+ * @addtogroup Element
+ * @{
+ */
+
+#ifndef ELEMENTARENA_H
+#define ELEMENTARENA_H
+
+#include <suanPan.h>
+
+class Element;
+
+class ElementArena final {
+    static constexpr uword num_field = 7;
+
+    struct Slot {
+        mat* trial;
+        mat* current;
+        uword offset;
+        uword size;
+    };
+
+    struct Field {
+        std::vector<Slot> slot;
+        std::vector<double> trial_pool, current_pool;
+        uword size = 0;
+
+        void sync(bool);
+    };
+
+    std::vector<shared_ptr<Element>> element_pool;
+
+    std::array<Field, num_field> field_pool;
+
+    static std::array<std::pair<mat*, mat*>, num_field> get_state(Element&);
+
+public:
+    explicit ElementArena(const std::vector<shared_ptr<Element>>&);
+    ElementArena(const ElementArena&) = delete;
+    ElementArena(ElementArena&&) noexcept = delete;
+    ElementArena& operator=(const ElementArena&) = delete;
+    ElementArena& operator=(ElementArena&&) noexcept = delete;
+    ~ElementArena();
+
+    static bool is_hosted(const mat&, const mat&);
+
+    void commit_status();
+    void reset_status();
+
+    [[nodiscard]] uword get_size() const;
+};
+
+#endif
+
+//! @}
@@ -36,6 +36,7 @@ class Node;
 class DomainBase;
 class Material;
 class Section;
+class state_archive;
 enum class OutputType;
 enum class DOF : unsigned short;
 
@@ -106,6 +107,9 @@ public:
 
     [[nodiscard]] virtual const std::vector<MappingDOF>& get_dof_mapping() const = 0;
 
+    virtual void set_sparse_mapping(uvec&&) = 0;
+    [[nodiscard]] virtual const uvec& get_sparse_mapping() const = 0;
+
     [[nodiscard]] virtual const uvec& get_material_tag() const = 0;
     [[nodiscard]] virtual const uvec& get_section_tag() const = 0;
 
@@ -174,6 +178,8 @@ public:
 
     virtual std::vector<vec> record(OutputType) = 0;
 
+    virtual void archive(state_archive&) = 0;
+
     [[nodiscard]] virtual double get_strain_energy() const = 0;
     [[nodiscard]] virtual double get_complementary_energy() const = 0;
     [[nodiscard]] virtual double get_kinetic_energy() const = 0;
@@ -199,6 +199,12 @@ int GCMQ::reset_status() {
     return SGCMQ::reset_status();
 }
 
+void GCMQ::archive(state_archive& A) {
+    SGCMQ::archive(A);
+    A(trial_viwt, current_viwt, trial_vif, current_vif, trial_zeta, current_zeta);
+    A(trial_beta, current_beta, trial_alpha, current_alpha, trial_q, current_q);
+}
+
 mat GCMQ::compute_shape_function(const mat& coordinate, const unsigned order) const { return shape::quad(coordinate, order, m_node); }
 
 vector<vec> GCMQ::record(const OutputType P) {
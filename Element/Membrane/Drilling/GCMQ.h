@@ -68,6 +68,8 @@ public:
     int clear_status() override;
     int reset_status() override;
 
+    void archive(state_archive&) override;
+
     [[nodiscard]] mat compute_shape_function(const mat&, unsigned) const override;
 
     vector<vec> record(OutputType) override;
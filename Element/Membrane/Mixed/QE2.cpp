@@ -202,6 +202,12 @@ int QE2::reset_status() {
     return code;
 }
 
+void QE2::archive(state_archive& A) {
+    MaterialElement2D::archive(A);
+    A(trial_qtitt, current_qtitt, trial_qtifi, current_qtifi, trial_lambda, current_lambda);
+    A(trial_alpha, current_alpha, trial_beta, current_beta);
+}
+
 mat QE2::compute_shape_function(const mat& coordinate, const unsigned order) const { return shape::quad(coordinate, order, m_node); }
 
 vector<vec> QE2::record(const OutputType P) {
@@ -17,6 +17,7 @@
 
 #include "CP4.h"
 #include <Domain/DomainBase.h>
+#include <Element/Utility/FixedKernel.hpp>
 #include <Material/Material2D/Material2D.h>
 #include <Recorder/OutputType.h>
 #include <Toolbox/IntegrationPlan.h>
@@ -31,14 +32,14 @@ CP4::IntegrationPoint::IntegrationPoint(vec&& C, const double W, unique_ptr<Mate
     , weight(W)
     , m_material(std::move(M))
     , pn_pxy(std::move(P))
-    , strain_mat(3, m_size) {
+    , strain_mat(fill::zeros) {
     for(auto I = 0u, J = 0u, K = 1u; I < m_node; ++I, J += m_dof, K += m_dof) {
         strain_mat(0, J) = strain_mat(2, K) = pn_pxy(0, I);
         strain_mat(2, J) = strain_mat(1, K) = pn_pxy(1, I);
     }
 }
 
-void CP4::stack_stiffness(mat& K, const mat& D, const sp_mat& N, const double F) {
+void CP4::stack_stiffness(mat& K, const mat& D, const mat& N, const double F) {
     const auto D11 = F * D(0, 0);
     const auto D12 = F * D(0, 1);
     const auto D13 = F * D(0, 2);
@@ -288,44 +289,23 @@ int CP4::update_status() {
     if(nlgeom) {
         trial_geometry.zeros(m_size, m_size);
 
-        const mat ele_disp = reshape(t_disp, m_dof, m_node);
-
-        mat BN(3, m_size);
+        mat::fixed<m_dof, m_dof> gradient;
+        vec::fixed<3> t_strain;
+        mat::fixed<3, m_size> BN;
         for(const auto& I : int_pt) {
-            const mat gradient = ele_disp * I.pn_pxy.t() + eye(m_dof, m_dof);
-            for(unsigned J = 0, K = 0, L = 1; J < m_node; ++J, K += m_dof, L += m_dof) {
-                BN(0, K) = I.pn_pxy(0, J) * gradient(0, 0);
-                BN(1, K) = I.pn_pxy(1, J) * gradient(0, 1);
-                BN(0, L) = I.pn_pxy(0, J) * gradient(1, 0);
-                BN(1, L) = I.pn_pxy(1, J) * gradient(1, 1);
-                BN(2, K) = I.pn_pxy(0, J) * gradient(0, 1) + I.pn_pxy(1, J) * gradient(0, 0);
-                BN(2, L) = I.pn_pxy(0, J) * gradient(1, 1) + I.pn_pxy(1, J) * gradient(1, 0);
-            }
+            suanpan::kernel::deformation_gradient<m_dof, m_node>(gradient, t_disp, I.pn_pxy);
+            suanpan::kernel::nonlinear_strain_mat<m_dof, m_node>(BN, I.pn_pxy, gradient);
+            suanpan::kernel::green_strain<m_dof>(t_strain, gradient);
 
-            if(I.m_material->update_trial_status(tensor::strain::to_voigt(tensor::strain::to_green(gradient))) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
+            if(I.m_material->update_trial_status(t_strain) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
 
             const auto t_weight = I.weight * thickness;
 
             auto& t_stress = I.m_material->get_trial_stress();
 
-            const auto sigma = tensor::stress::to_tensor(t_stress);
-
-            for(unsigned J = 0, L = 0, M = 1; J < m_node; ++J, L += m_dof, M += m_dof) {
-                const vec t_vec = sigma * I.pn_pxy.col(J);
-                auto t_factor = t_weight * dot(I.pn_pxy.col(J), t_vec);
-                trial_geometry(L, L) += t_factor;
-                trial_geometry(M, M) += t_factor;
-                for(auto K = J + 1, N = L + m_dof, P = N + 1; K < m_node; ++K, N += m_dof, P += m_dof) {
-                    t_factor = t_weight * dot(I.pn_pxy.col(K), t_vec);
-                    trial_geometry(N, L) += t_factor;
-                    trial_geometry(P, M) += t_factor;
-                    trial_geometry(L, N) += t_factor;
-                    trial_geometry(M, P) += t_factor;
-                }
-            }
-
-            trial_stiffness += t_weight * BN.t() * I.m_material->get_trial_stiffness() * BN;
-            trial_resistance += t_weight * BN.t() * t_stress;
+            suanpan::kernel::geometric_stiffness<m_dof, m_node>(trial_geometry, I.pn_pxy, t_stress, t_weight);
+            suanpan::kernel::btdb(trial_stiffness, BN, I.m_material->get_trial_stiffness(), t_weight);
+            suanpan::kernel::bts(trial_resistance, BN, t_stress, t_weight);
         }
     }
     else
@@ -342,7 +322,7 @@ int CP4::update_status() {
             const auto t_factor = I.weight * thickness;
 
             stack_stiffness(trial_stiffness, I.m_material->get_trial_stiffness(), I.strain_mat, t_factor);
-            trial_resistance += t_factor * I.strain_mat.t() * I.m_material->get_trial_stress();
+            suanpan::kernel::bts(trial_resistance, I.strain_mat, I.m_material->get_trial_stress(), t_factor);
         }
 
     if(reduced_scheme) {
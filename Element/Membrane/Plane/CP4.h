@@ -36,17 +36,17 @@
 #include <Element/MaterialElement.h>
 
 class CP4 final : public MaterialElement2D {
+    static constexpr unsigned m_node = 4, m_dof = 2, m_size = m_dof * m_node;
+
     struct IntegrationPoint final {
         vec coor;
         double weight;
         unique_ptr<Material> m_material;
         mat pn_pxy;
-        sp_mat strain_mat;
+        mat::fixed<3, m_size> strain_mat;
         IntegrationPoint(vec&&, double, unique_ptr<Material>&&, mat&&);
     };
 
-    static constexpr unsigned m_node = 4, m_dof = 2, m_size = m_dof * m_node;
-
     static const vec h_mode;
 
     const double thickness;
@@ -57,7 +57,7 @@ class CP4 final : public MaterialElement2D {
 
     mat hourglassing;
 
-    static void stack_stiffness(mat&, const mat&, const sp_mat&, double);
+    static void stack_stiffness(mat&, const mat&, const mat&, double);
 
 public:
     CP4(
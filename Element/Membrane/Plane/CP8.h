@@ -34,17 +34,17 @@
 #include <Element/MaterialElement.h>
 
 class CP8 final : public MaterialElement2D {
+    static constexpr unsigned m_node = 8, m_dof = 2, m_size = m_dof * m_node;
+
     struct IntegrationPoint final {
         vec coor;
         double weight;
         unique_ptr<Material> m_material;
         mat pn_pxy;
-        sp_mat strain_mat;
+        mat::fixed<3, m_size> strain_mat;
         IntegrationPoint(vec&&, double, unique_ptr<Material>&&, mat&&);
     };
 
-    static constexpr unsigned m_node = 8, m_dof = 2, m_size = m_dof * m_node;
-
     const double thickness;
 
     const bool reduced_scheme;
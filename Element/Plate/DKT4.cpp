@@ -17,6 +17,7 @@
 
 #include "DKT4.h"
 #include <Domain/DomainBase.h>
+#include <Element/Utility/FixedKernel.hpp>
 #include <Material/Material.h>
 #include <Toolbox/IntegrationPlan.h>
 #include <Toolbox/shape.h>
@@ -33,7 +34,7 @@ DKT4::IntegrationPoint::SectionIntegrationPoint::SectionIntegrationPoint(const S
 
 DKT4::IntegrationPoint::IntegrationPoint(vec&& C)
     : coor(std::move(C))
-    , strain_mat(3, p_size) {}
+    , strain_mat(fill::zeros) {}
 
 field<mat> DKT4::form_transform(const mat& C) {
     const auto &X1 = C(0, 0), &X2 = C(1, 0), &X3 = C(2, 0), &X4 = C(3, 0);
@@ -155,12 +156,14 @@ int DKT4::update_status() {
 
     trial_resistance.zeros(p_size);
     trial_stiffness.zeros(p_size, p_size);
+    vec::fixed<3> p_strain, t_strain;
     for(const auto& I : int_pt) {
-        const vec p_strain = I.strain_mat * trial_disp;
+        suanpan::kernel::bu(p_strain, I.strain_mat, trial_disp);
         for(const auto& J : I.sec_int_pt) {
-            if(J.p_material->update_trial_status(J.eccentricity * p_strain) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
-            trial_stiffness += J.eccentricity * J.eccentricity * J.factor * I.strain_mat.t() * J.p_material->get_trial_stiffness() * I.strain_mat;
-            trial_resistance += J.eccentricity * J.factor * I.strain_mat.t() * J.p_material->get_trial_stress();
+            t_strain = J.eccentricity * p_strain;
+            if(J.p_material->update_trial_status(t_strain) != SUANPAN_SUCCESS) return SUANPAN_FAIL;
+            suanpan::kernel::btdb(trial_stiffness, I.strain_mat, J.p_material->get_trial_stiffness(), J.eccentricity * J.eccentricity * J.factor);
+            suanpan::kernel::bts(trial_resistance, I.strain_mat, J.p_material->get_trial_stress(), J.eccentricity * J.factor);
         }
     }
 
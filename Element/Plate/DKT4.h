@@ -33,6 +33,8 @@
 #include <Element/MaterialElement.h>
 
 class DKT4 final : public MaterialElement2D {
+    static constexpr unsigned p_node = 4, p_dof = 3, p_size = p_dof * p_node;
+
     struct IntegrationPoint final {
         struct SectionIntegrationPoint final {
             const double eccentricity, factor;
@@ -46,13 +48,11 @@ class DKT4 final : public MaterialElement2D {
         };
 
         vec coor;
-        mat strain_mat;
+        mat::fixed<3, p_size> strain_mat;
         vector<SectionIntegrationPoint> sec_int_pt;
         explicit IntegrationPoint(vec&&);
     };
 
-    static constexpr unsigned p_node = 4, p_dof = 3, p_size = p_dof * p_node;
-
     const double thickness;
     const unsigned num_section_ip;
 
@@ -90,3 +90,9 @@ vector<vec> Damper02::record(const OutputType P) { return device->record(P); }
 void Damper02::print() {
     suanpan_info("A viscous damper element using displacement and velocity as basic quantities.\n");
 }
+
+void Damper02::archive(state_archive& A) {
+    MaterialElement1D::archive(A);
+    // the device is created by the constructor thus not enrolled
+    device->archive(A);
+}
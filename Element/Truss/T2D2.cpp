@@ -97,6 +97,11 @@ int T2D2::reset_status() {
     return t_material->reset_status();
 }
 
+void T2D2::archive(state_archive& A) {
+    MaterialElement1D::archive(A);
+    t_trans->archive(A);
+}
+
 vector<vec> T2D2::record(const OutputType P) { return t_material->record(P); }
 
 void T2D2::print() {
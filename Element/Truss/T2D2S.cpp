@@ -81,6 +81,11 @@ int T2D2S::reset_status() {
     return t_section->reset_status();
 }
 
+void T2D2S::archive(state_archive& A) {
+    SectionElement1D::archive(A);
+    t_trans->archive(A);
+}
+
 vector<vec> T2D2S::record(const OutputType P) { return t_section->record(P); }
 
 void T2D2S::print() {
@@ -86,6 +86,11 @@ int T3D2::reset_status() {
     return t_material->reset_status();
 }
 
+void T3D2::archive(state_archive& A) {
+    MaterialElement1D::archive(A);
+    t_trans->archive(A);
+}
+
 vector<vec> T3D2::record(const OutputType P) { return t_material->record(P); }
 
 void T3D2::print() {
@@ -81,6 +81,11 @@ int T3D2S::reset_status() {
     return t_section->reset_status();
 }
 
+void T3D2S::archive(state_archive& A) {
+    SectionElement1D::archive(A);
+    t_trans->archive(A);
+}
+
 vector<vec> T3D2S::record(const OutputType P) { return t_section->record(P); }
 
 void T3D2S::print() {
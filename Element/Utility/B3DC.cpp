@@ -227,6 +227,8 @@ void B3DC::clear_status() {
     trial_rotation = current_rotation.zeros();
 }
 
+void B3DC::archive(state_archive& A) { A(trial_n, current_n, trial_ref, current_ref, trial_rotation, current_rotation); }
+
 vec B3DC::to_local_vec(const vec&) const { return {elongation, theta(2), theta(5), theta(1), theta(4), theta(3) - theta(0)}; }
 
 vec B3DC::to_global_vec(const vec& l_resistance) const { return transformation.t() * l_resistance; }
@@ -89,6 +89,8 @@ public:
     void reset_status() override;
     void clear_status() override;
 
+    void archive(state_archive&) override;
+
     [[nodiscard]] vec to_local_vec(const vec&) const override;
     [[nodiscard]] vec to_global_vec(const vec&) const override;
     [[nodiscard]] mat to_global_geometry_mat(const mat&) const override;
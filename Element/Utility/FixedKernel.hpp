@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @fn FixedKernel
+ * @brief A collection of compile-time sized kernels for continuum elements.
+ *
+ * The kernels operate on `mat::fixed`/`vec::fixed` so that elements with a
+ * fixed number of nodes can form strain-displacement matrices, deformation
+ * gradients and stiffness contributions without any heap allocation.
+ *
+ * The Voigt notation follows the rest of the code base, that is,
+ * \f$[11,22,12]\f$ in 2D and \f$[11,22,33,12,23,31]\f$ in 3D, with
+ * engineering shear strain.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file FixedKernel.hpp
+ * @addtogroup Utility
+ * @ingroup Element
+ * @{
+ */
+
+#ifndef FIXEDKERNEL_HPP
+#define FIXEDKERNEL_HPP
+
+#include <suanPan.h>
+
+namespace suanpan::kernel {
+    template<uword D> constexpr uword voigt_size = D * (D + 1) / 2;
+
+    /**
+     * \brief the pair of tensor indices of each Voigt component
+     */
+    template<uword D> constexpr std::array<std::pair<uword, uword>, voigt_size<D>> voigt_index() {
+        static_assert(2 == D || 3 == D, "only 2D and 3D are supported");
+        if constexpr(2 == D) return {{{0, 0}, {1, 1}, {0, 1}}};
+        else return {{{0, 0}, {1, 1}, {2, 2}, {0, 1}, {1, 2}, {2, 0}}};
+    }
+
+    /**
+     * \brief compute the deformation gradient \f$F=I+\dfrac{\partial{}u}{\partial{}X}\f$
+     * \param F deformation gradient
+     * \param disp nodal displacement arranged in node-major order
+     * \param pn derivatives of shape functions in global coordinates, each column for one node
+     */
+    template<uword D, uword N> void deformation_gradient(mat::fixed<D, D>& F, const vec& disp, const mat& pn) {
+        F.eye();
+        for(uword J = 0; J < N; ++J)
+            for(uword K = 0; K < D; ++K)
+                for(uword I = 0; I < D; ++I) F.at(I, K) += disp(J * D + I) * pn.at(K, J);
+    }
+
+    /**
+     * \brief compute the Green-Lagrange strain in Voigt notation from the deformation gradient
+     */
+    template<uword D> void green_strain(vec::fixed<voigt_size<D>>& E, const mat::fixed<D, D>& F) {
+        constexpr auto index = voigt_index<D>();
+        for(uword I = 0; I < voigt_size<D>; ++I) {
+            const auto [A, B] = index[I];
+            auto t_value = 0.;
+            for(uword K = 0; K < D; ++K) t_value += F.at(K, A) * F.at(K, B);
+            E(I) = A == B ? .5 * (t_value - 1.) : t_value;
+        }
+    }
+
+    /**
+     * \brief form the nonlinear strain-displacement matrix
+     * \f$\delta{}E=B_N\delta{}u\f$ from the deformation gradient
+     */
+    template<uword D, uword N> void nonlinear_strain_mat(mat::fixed<voigt_size<D>, D * N>& BN, const mat& pn, const mat::fixed<D, D>& F) {
+        constexpr auto index = voigt_index<D>();
+        for(uword J = 0; J < N; ++J)
+            for(uword K = 0; K < D; ++K)
+                for(uword I = 0; I < voigt_size<D>; ++I) {
+                    const auto [A, B] = index[I];
+                    BN.at(I, J * D + K) = A == B ? pn.at(A, J) * F.at(K, A) : pn.at(A, J) * F.at(K, B) + pn.at(B, J) * F.at(K, A);
+                }
+    }
+
+    /**
+     * \brief form the small strain strain-displacement matrix
+     */
+    template<uword D, uword N> void linear_strain_mat(mat::fixed<voigt_size<D>, D * N>& B, const mat& pn) {
+        constexpr auto index = voigt_index<D>();
+        B.zeros();
+        for(uword J = 0; J < N; ++J)
+            for(uword I = 0; I < voigt_size<D>; ++I) {
+                const auto [P, Q] = index[I];
+                B.at(I, J * D + P) = pn.at(Q, J);
+                if(P != Q) B.at(I, J * D + Q) = pn.at(P, J);
+            }
+    }
+
+    /**
+     * \brief compute \f$B\cdot{}u\f$
+     */
+    template<uword V, uword S> void bu(vec::fixed<V>& E, const mat::fixed<V, S>& B, const vec& u) { E = B * u; }
+
+    /**
+     * \brief accumulate \f$K\leftarrow{}K+wB^TDB\f$
+     */
+    template<uword V, uword S> void btdb(mat& K, const mat::fixed<V, S>& B, const mat& D, const double w) {
+        mat::fixed<V, S> DB;
+        DB = w * D * B;
+        K += B.t() * DB;
+    }
+
+    /**
+     * \brief accumulate \f$R\leftarrow{}R+wB^T\sigma\f$
+     */
+    template<uword V, uword S> void bts(vec& R, const mat::fixed<V, S>& B, const vec& stress, const double w) { R += w * B.t() * stress; }
+
+    /**
+     * \brief accumulate the geometric stiffness \f$K_G\leftarrow{}K_G+w\nabla{}N^T\sigma\nabla{}N\otimes{}I\f$
+     * \param K geometric stiffness
+     * \param pn derivatives of shape functions in global coordinates
+     * \param stress stress in Voigt notation
+     * \param w weight
+     */
+    template<uword D, uword N> void geometric_stiffness(mat& K, const mat& pn, const vec& stress, const double w) {
+        constexpr auto index = voigt_index<D>();
+        mat::fixed<D, D> sigma;
+        for(uword I = 0; I < voigt_size<D>; ++I) {
+            const auto [A, B] = index[I];
+            sigma.at(A, B) = sigma.at(B, A) = w * stress(I);
+        }
+
+        vec::fixed<D> t_vec;
+        for(uword J = 0; J < N; ++J) {
+            for(uword A = 0; A < D; ++A) {
+                t_vec(A) = 0.;
+                for(uword B = 0; B < D; ++B) t_vec(A) += sigma.at(A, B) * pn.at(B, J);
+            }
+            for(uword L = 0; L < N; ++L) {
+                auto t_factor = 0.;
+                for(uword A = 0; A < D; ++A) t_factor += pn.at(A, L) * t_vec(A);
+                for(uword A = 0; A < D; ++A) K.at(L * D + A, J * D + A) += t_factor;
+            }
+        }
+    }
+} // namespace suanpan::kernel
+
+#endif
+
+//! @}
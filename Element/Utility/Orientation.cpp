@@ -50,6 +50,8 @@ void Orientation::reset_status() {}
 
 void Orientation::clear_status() {}
 
+void Orientation::archive(state_archive&) {}
+
 vec Orientation::to_local_vec(const double g) const { return to_local_vec(vec{g}); }
 
 vec Orientation::to_global_vec(const double l) const { return to_global_vec(vec{l}); }
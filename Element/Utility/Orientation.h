@@ -44,6 +44,7 @@ enum class OrientationType {
 };
 
 class Element;
+class state_archive;
 
 class Orientation : public Tag {
 protected:
@@ -86,6 +87,11 @@ public:
     virtual void reset_status();
     virtual void clear_status();
 
+    /**
+     * \brief Archive history variables of corotational formulations, the owning element shall call this in its `archive()`.
+     */
+    virtual void archive(state_archive&);
+
     [[nodiscard]] virtual vec to_local_vec(double) const;
     [[nodiscard]] virtual vec to_global_vec(double) const;
     [[nodiscard]] virtual mat to_global_mass_mat(double) const;
@@ -23,6 +23,7 @@
 #include <Domain/Node.h>
 #include <Element/Element.h>
 #include <Toolbox/utility.h>
+#include <Toolbox/writer_queue.hpp>
 
 #include <vtkAutoInit.h>
 VTK_MODULE_INIT(vtkRenderingOpenGL2)  // NOLINT(cppcoreguidelines-special-member-functions, hicpp-special-member-functions)
@@ -185,7 +186,8 @@ void vtk_plot_node_quantity(const shared_ptr<DomainBase>& domain, vtkInfo config
     else if(config.save_file) {
         grid->GetPointData()->SetScalars(data);
         grid->GetPointData()->SetActiveScalars(to_category(config.type));
-        domain->insert(make_unique<std::future<void>>(std::async(std::launch::async, vtk_save, std::move(grid), std::move(config))));
+        // grids are written one after another by the output thread
+        suanpan::output_queue().push([grid, config]() mutable { vtk_save(std::move(grid), std::move(config)); }, domain.get());
     }
     else {
         const auto sub_data = vtkSmartPointer<vtkDoubleArray>::New();
@@ -258,7 +260,8 @@ void vtk_plot_element_quantity(const shared_ptr<DomainBase>& domain, vtkInfo con
     else if(config.save_file) {
         grid->GetPointData()->SetScalars(data);
         grid->GetPointData()->SetActiveScalars(to_category(config.type));
-        domain->insert(make_unique<std::future<void>>(std::async(std::launch::async, vtk_save, std::move(grid), std::move(config))));
+        // grids are written one after another by the output thread
+        suanpan::output_queue().push([grid, config]() mutable { vtk_save(std::move(grid), std::move(config)); }, domain.get());
     }
     else {
         const auto sub_data = vtkSmartPointer<vtkDoubleArray>::New();
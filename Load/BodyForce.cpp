@@ -30,7 +30,7 @@ BodyForce::BodyForce(const unsigned T, const unsigned S, const double L, uvec&&
 int BodyForce::process(const shared_ptr<DomainBase>& D) {
     auto& W = D->get_factory();
 
-    trial_load.zeros(W->get_size());
+    trial_load.reset();
 
     const auto final_load = pattern * magnitude->get_amplitude(W->get_trial_time());
 
@@ -38,7 +38,7 @@ int BodyForce::process(const shared_ptr<DomainBase>& D) {
         if(auto& t_element = D->get<Element>(I); nullptr != t_element && t_element->is_active()) {
             vec t_body_load(t_element->get_dof_number(), fill::zeros);
             for(const auto J : dof_reference) if(J < t_element->get_dof_number()) t_body_load(J) = final_load;
-            if(const auto& t_body_force = t_element->update_body_force(t_body_load); !t_body_force.empty()) trial_load(t_element->get_dof_encoding()) += t_body_force;
+            if(const auto& t_body_force = t_element->update_body_force(t_body_load); !t_body_force.empty()) trial_load.insert(t_element->get_dof_encoding(), t_body_force);
         }
 
     return SUANPAN_SUCCESS;
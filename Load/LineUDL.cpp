@@ -39,10 +39,11 @@ LineUDL2D::LineUDL2D(const unsigned T, const unsigned S, const double L, uvec&&
 int LineUDL2D::process(const shared_ptr<DomainBase>& D) {
     const auto& W = D->get_factory();
 
-    trial_load.zeros(W->get_size());
+    trial_load.reset();
 
     const auto ref_load = pattern * magnitude->get_amplitude(W->get_trial_time());
 
+    // each shared node takes the value of the segment it starts
     for(auto I = 0llu, J = 1llu; J < node_encoding.n_elem; ++I, ++J) {
         const auto& node_i = D->get<Node>(node_encoding(I));
         const auto& node_j = D->get<Node>(node_encoding(J));
@@ -52,12 +53,16 @@ int LineUDL2D::process(const shared_ptr<DomainBase>& D) {
         const vec diff_coor = node_j->get_coordinate().head(dimension) - node_i->get_coordinate().head(dimension);
 
         if(0llu == dof_reference(0)) {
-            trial_load(dof_i(0)) = trial_load(dof_j(0)) = -.5 * diff_coor(1) * ref_load;
+            const auto t_load = -.5 * diff_coor(1) * ref_load;
+            trial_load.insert(dof_i(0), t_load);
+            if(J + 1llu == node_encoding.n_elem) trial_load.insert(dof_j(0), t_load);
             D->insert_loaded_dof(dof_i(0));
             D->insert_loaded_dof(dof_j(0));
         }
         else if(1llu == dof_reference(0)) {
-            trial_load(dof_i(1)) = trial_load(dof_j(1)) = -.5 * diff_coor(0) * ref_load;
+            const auto t_load = -.5 * diff_coor(0) * ref_load;
+            trial_load.insert(dof_i(1), t_load);
+            if(J + 1llu == node_encoding.n_elem) trial_load.insert(dof_j(1), t_load);
             D->insert_loaded_dof(dof_i(1));
             D->insert_loaded_dof(dof_j(1));
         }
@@ -72,10 +77,11 @@ LineUDL3D::LineUDL3D(const unsigned T, const unsigned S, const double L, uvec&&
 int LineUDL3D::process(const shared_ptr<DomainBase>& D) {
     const auto& W = D->get_factory();
 
-    trial_load.zeros(W->get_size());
+    trial_load.reset();
 
     const auto ref_load = pattern * magnitude->get_amplitude(W->get_trial_time());
 
+    // each shared node takes the value of the segment it starts
     for(auto I = 0llu, J = 1llu; J < node_encoding.n_elem; ++I, ++J) {
         const auto& node_i = D->get<Node>(node_encoding(I));
         const auto& node_j = D->get<Node>(node_encoding(J));
@@ -85,17 +91,23 @@ int LineUDL3D::process(const shared_ptr<DomainBase>& D) {
         const vec diff_coor = node_j->get_coordinate().head(dimension) - node_i->get_coordinate().head(dimension);
 
         if(0llu == dof_reference(0)) {
-            trial_load(dof_i(0)) = trial_load(dof_j(0)) = -.5 * norm(diff_coor(uvec{1, 2})) * ref_load;
+            const auto t_load = -.5 * norm(diff_coor(uvec{1, 2})) * ref_load;
+            trial_load.insert(dof_i(0), t_load);
+            if(J + 1llu == node_encoding.n_elem) trial_load.insert(dof_j(0), t_load);
             D->insert_loaded_dof(dof_i(0));
             D->insert_loaded_dof(dof_j(0));
         }
         else if(1llu == dof_reference(0)) {
-            trial_load(dof_i(1)) = trial_load(dof_j(1)) = -.5 * norm(diff_coor(uvec{0, 2})) * ref_load;
+            const auto t_load = -.5 * norm(diff_coor(uvec{0, 2})) * ref_load;
+            trial_load.insert(dof_i(1), t_load);
+            if(J + 1llu == node_encoding.n_elem) trial_load.insert(dof_j(1), t_load);
             D->insert_loaded_dof(dof_i(1));
             D->insert_loaded_dof(dof_j(1));
         }
         else if(2llu == dof_reference(0)) {
-            trial_load(dof_i(2)) = trial_load(dof_j(2)) = -.5 * norm(diff_coor(uvec{0, 1})) * ref_load;
+            const auto t_load = -.5 * norm(diff_coor(uvec{0, 1})) * ref_load;
+            trial_load.insert(dof_i(2), t_load);
+            if(J + 1llu == node_encoding.n_elem) trial_load.insert(dof_j(2), t_load);
             D->insert_loaded_dof(dof_i(2));
             D->insert_loaded_dof(dof_j(2));
         }
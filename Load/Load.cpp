@@ -17,7 +17,76 @@
 
 #include "Load.h"
 #include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
 #include <Domain/Group/Group.h>
+#include <Load/Amplitude/Constant.h>
+
+void LoadContribution::reset() {
+    index.clear();
+    value.clear();
+}
+
+void LoadContribution::insert(const uword I, const double V) {
+    index.emplace_back(I);
+    value.emplace_back(V);
+}
+
+void LoadContribution::insert(const uvec& I, const double V) {
+    index.insert(index.end(), I.cbegin(), I.cend());
+    value.insert(value.end(), I.n_elem, V);
+}
+
+void LoadContribution::insert(const uvec& I, const vec& V) {
+    suanpan_assert([&] { if(I.n_elem != V.n_elem) throw invalid_argument("size mismatch"); });
+
+    index.insert(index.end(), I.cbegin(), I.cend());
+    value.insert(value.end(), V.cbegin(), V.cend());
+}
+
+void LoadContribution::insert(const vec& V) {
+    for(auto I = 0llu; I < V.n_elem; ++I)
+        if(0. != V(I)) insert(I, V(I));
+}
+
+bool LoadContribution::empty() const { return index.empty(); }
+
+uword LoadContribution::size() const { return index.size(); }
+
+void LoadContribution::scatter(vec& target, const uword begin, const uword end) const {
+    for(size_t I = 0; I < index.size(); ++I)
+        if(index[I] >= begin && index[I] < end) target(index[I]) += value[I];
+}
+
+void LoadContribution::group(const uword width, const uword n_group) const {
+    group_ptr.assign(n_group + 1, 0);
+    group_order.clear();
+
+    // a single group is the identity
+    if(1 == n_group) {
+        group_ptr[1] = index.size();
+        return;
+    }
+
+    // stable counting sort
+    for(const auto I : index) ++group_ptr[I / width + 1];
+    for(uword I = 0; I < n_group; ++I) group_ptr[I + 1] += group_ptr[I];
+
+    group_order.resize(index.size());
+    std::vector position(group_ptr.cbegin(), group_ptr.cend() - 1);
+    for(size_t I = 0; I < index.size(); ++I) group_order[position[index[I] / width]++] = I;
+}
+
+void LoadContribution::scatter_group(vec& target, const uword G) const {
+    if(group_order.empty()) {
+        for(auto I = group_ptr[G]; I < group_ptr[G + 1]; ++I) target(index[I]) += value[I];
+        return;
+    }
+
+    for(auto I = group_ptr[G]; I < group_ptr[G + 1]; ++I) {
+        const auto J = group_order[I];
+        target(index[J]) += value[J];
+    }
+}
 
 double Load::multiplier = 1E8;
 
@@ -29,11 +98,29 @@ void Load::enable_displacement_control() const { access::rw(mpdc_flag) = true; }
 
 bool Load::if_displacement_control() const { return mpdc_flag; }
 
-const vec& Load::get_trial_load() const { return trial_load; }
+const LoadContribution& Load::get_trial_load() const { return trial_load; }
+
+const LoadContribution& Load::get_trial_settlement() const { return trial_settlement; }
+
+const LoadContribution& Load::get_reference_load() const { return reference_load; }
+
+vec Load::get_spatial_pattern(const shared_ptr<DomainBase>& D) {
+    if(if_displacement_control()) return {};
 
-const vec& Load::get_trial_settlement() const { return trial_settlement; }
+    const auto t_magnitude = magnitude;
+    magnitude = make_shared<Constant>();
+    const auto code = process(D);
+    magnitude = t_magnitude;
+
+    if(SUANPAN_SUCCESS != code) return {};
+
+    vec t_pattern(D->get_factory()->get_size(), fill::zeros);
+    trial_load.scatter(t_pattern, 0, t_pattern.n_elem);
+
+    return t_pattern;
+}
 
-const sp_vec& Load::get_reference_load() const { return reference_load; }
+double Load::get_time_history(const double T) const { return magnitude->get_amplitude(T); }
 
 void set_load_multiplier(const double M) { Load::multiplier = M; }
 
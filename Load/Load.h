@@ -34,6 +34,45 @@
 
 #include <Domain/ConditionalModifier.h>
 
+/**
+ * \brief A sparse load contribution stored as (index, value) pairs.
+ *
+ * Duplicated indices are allowed and are summed up when scattered.
+ * The storage is kept between iterations so that no reallocation is required.
+ */
+class LoadContribution final {
+    std::vector<uword> index;
+    std::vector<double> value;
+
+    // entries grouped by contiguous DoF ranges, the grouping does not alter the entries themselves
+    mutable std::vector<uword> group_ptr, group_order;
+
+public:
+    void reset();
+
+    void insert(uword, double);
+    void insert(const uvec&, double);
+    void insert(const uvec&, const vec&);
+    void insert(const vec&);
+
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] uword size() const;
+
+    /**
+     * \brief add contributions with indices in [begin, end) to the target vector
+     */
+    void scatter(vec&, uword, uword) const;
+
+    /**
+     * \brief group entries into DoF ranges of the given width, entries in each range keep the insertion order
+     */
+    void group(uword, uword) const;
+    /**
+     * \brief add contributions in the given range to the target vector, `group()` shall be called beforehand
+     */
+    void scatter_group(vec&, uword) const;
+};
+
 class Load : public ConditionalModifier {
 protected:
     static double multiplier;
@@ -42,9 +81,9 @@ protected:
 
     const double pattern;
 
-    vec trial_load;
-    vec trial_settlement;
-    sp_vec reference_load;
+    LoadContribution trial_load;
+    LoadContribution trial_settlement;
+    LoadContribution reference_load;
 
     friend void set_load_multiplier(double);
 
@@ -67,9 +106,20 @@ public:
     void enable_displacement_control() const;
     [[nodiscard]] bool if_displacement_control() const;
 
-    [[nodiscard]] const vec& get_trial_load() const;
-    [[nodiscard]] const vec& get_trial_settlement() const;
-    [[nodiscard]] const sp_vec& get_reference_load() const;
+    [[nodiscard]] const LoadContribution& get_trial_load() const;
+    [[nodiscard]] const LoadContribution& get_trial_settlement() const;
+    [[nodiscard]] const LoadContribution& get_reference_load() const;
+
+    /**
+     * \brief Loads in linear analyses can be decomposed into a constant spatial pattern and a time history.
+     * By default, the spatial pattern is obtained by processing the load with a unit amplitude.
+     * \return spatial pattern, empty if the decomposition is not available
+     */
+    [[nodiscard]] virtual vec get_spatial_pattern(const shared_ptr<DomainBase>&);
+    /**
+     * \return time history that scales the spatial pattern
+     */
+    [[nodiscard]] double get_time_history(double) const;
 };
 
 void set_load_multiplier(double);
@@ -36,11 +36,11 @@ int NodalAcceleration::process(const shared_ptr<DomainBase>& D) {
 
     if(nullptr == W->get_mass()) return SUANPAN_SUCCESS;
 
-    trial_load.zeros(W->get_size());
+    vec t_load(W->get_size(), fill::zeros);
 
-    trial_load(node_encoding.is_empty() ? get_all_nodal_active_dof(D) : get_nodal_active_dof(D)).fill(1.);
+    t_load(node_encoding.is_empty() ? get_all_nodal_active_dof(D) : get_nodal_active_dof(D)).fill(1.);
 
-    trial_load = W->get_mass() * trial_load * pattern * magnitude->get_amplitude(W->get_trial_time());
+    trial_load.insert(W->get_mass() * t_load * pattern * magnitude->get_amplitude(W->get_trial_time()));
 
     return SUANPAN_SUCCESS;
 }
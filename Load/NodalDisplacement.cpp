@@ -38,9 +38,8 @@ int NodalDisplacement::process(const shared_ptr<DomainBase>& D) {
     if(!encoding.empty()) {
         const auto& W = D->get_factory();
 
-        trial_settlement.zeros(W->get_size());
-
-        trial_settlement(encoding).fill(pattern * magnitude->get_amplitude(W->get_trial_time()));
+        trial_settlement.reset();
+        trial_settlement.insert(encoding, pattern * magnitude->get_amplitude(W->get_trial_time()));
     }
 
     return SUANPAN_SUCCESS;
@@ -33,9 +33,8 @@ int NodalForce::process(const shared_ptr<DomainBase>& D) {
 
     D->insert_loaded_dof(active_dof);
 
-    trial_load.zeros(W->get_size());
-
-    trial_load(active_dof).fill(pattern * magnitude->get_amplitude(W->get_trial_time()));
+    trial_load.reset();
+    trial_load.insert(active_dof, pattern * magnitude->get_amplitude(W->get_trial_time()));
 
     return SUANPAN_SUCCESS;
 }
@@ -23,11 +23,8 @@ ReferenceForce::ReferenceForce(const unsigned T, const unsigned S, const double
     : Load(T, S, 0, std::move(N), uvec{D}, L) {}
 
 int ReferenceForce::process(const shared_ptr<DomainBase>& D) {
-    const auto& W = D->get_factory();
-
-    reference_load.zeros(W->get_size());
-
-    for(const auto I : get_nodal_active_dof(D)) reference_load(I) = pattern;
+    reference_load.reset();
+    reference_load.insert(get_nodal_active_dof(D), pattern);
 
     return SUANPAN_SUCCESS;
 }
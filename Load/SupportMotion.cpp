@@ -36,12 +36,23 @@ int SupportMotion::initialize(const shared_ptr<DomainBase>& D) {
     return Load::initialize(D);
 }
 
-int SupportDisplacement::process(const shared_ptr<DomainBase>& D) {
+vec SupportMotion::get_spatial_pattern(const shared_ptr<DomainBase>& D) {
     const auto& W = D->get_factory();
 
-    trial_settlement.zeros(W->get_size());
+    if(nullptr == W->get_mass()) return {};
+
+    vec t_pattern(W->get_size(), fill::zeros);
+
+    t_pattern(get_all_nodal_active_dof(D)).fill(-pattern);
+
+    return W->get_mass() * t_pattern;
+}
+
+int SupportDisplacement::process(const shared_ptr<DomainBase>& D) {
+    const auto& W = D->get_factory();
 
-    trial_settlement(encoding).fill(pattern * magnitude->get_amplitude(W->get_trial_time()));
+    trial_settlement.reset();
+    trial_settlement.insert(encoding, pattern * magnitude->get_amplitude(W->get_trial_time()));
 
     return SUANPAN_SUCCESS;
 }
@@ -50,9 +61,8 @@ int SupportVelocity::process(const shared_ptr<DomainBase>& D) {
     const auto& W = D->get_factory();
     const auto& G = D->get_current_step()->get_integrator();
 
-    trial_settlement.zeros(W->get_size());
-
-    trial_settlement(encoding) = G->from_total_velocity(pattern * magnitude->get_amplitude(W->get_trial_time()), encoding);
+    trial_settlement.reset();
+    trial_settlement.insert(encoding, G->from_total_velocity(pattern * magnitude->get_amplitude(W->get_trial_time()), encoding));
 
     return SUANPAN_SUCCESS;
 }
@@ -61,9 +71,8 @@ int SupportAcceleration::process(const shared_ptr<DomainBase>& D) {
     const auto& W = D->get_factory();
     const auto& G = D->get_current_step()->get_integrator();
 
-    trial_settlement.zeros(W->get_size());
-
-    trial_settlement(encoding) = G->from_total_acceleration(pattern * magnitude->get_amplitude(W->get_trial_time()), encoding);
+    trial_settlement.reset();
+    trial_settlement.insert(encoding, G->from_total_acceleration(pattern * magnitude->get_amplitude(W->get_trial_time()), encoding));
 
     return SUANPAN_SUCCESS;
 }
@@ -56,6 +56,12 @@ public:
     );
 
     int initialize(const shared_ptr<DomainBase>&) override;
+
+    /**
+     * \brief The motion is treated as a uniform base excitation in the relative frame.
+     * The spatial pattern is the inertial force \f$-M\iota\f$ due to a unit base acceleration.
+     */
+    [[nodiscard]] vec get_spatial_pattern(const shared_ptr<DomainBase>&) override;
 };
 
 class SupportDisplacement final : public SupportMotion {
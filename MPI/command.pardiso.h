@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#ifndef COMMAND_PARDISO_H
+#define COMMAND_PARDISO_H
+
+/**
+ * \brief Commands understood by the persistent `solver.pardiso` worker group.
+ *
+ * Each command is broadcast by the parent (rank 0 of the merged communicator) to all workers.
+ * Payloads are exchanged between the parent and the worker root via the intercommunicator.
+ *
+ * - `ANALYSE`: broadcast config, then send iparm, CSR matrix, the worker group performs reordering and symbolic factorisation, replies error code
+ * - `UPDATE`: send new values of the analysed pattern, no reply
+ * - `FACTORISE`: the worker group performs numeric factorisation, replies error code
+ * - `SOLVE`: broadcast nrhs, then send rhs, replies error code and, if successful, the solution
+ * - `SHUTDOWN`: release memory and terminate the worker group
+ */
+enum class PardisoCommand : int {
+    SHUTDOWN = 0,
+    ANALYSE = 1,
+    UPDATE = 2,
+    FACTORISE = 3,
+    SOLVE = 4
+};
+
+#endif
@@ -21,11 +21,24 @@
 #include <mpi.h>
 #include <mkl_cluster_sparse_solver.h>
 #include <memory>
+#include "command.pardiso.h"
 
 int main(int argc, char** argv) {
+    if(MPI_SUCCESS != MPI_Init(&argc, &argv)) return 1;
+
     int error = 0, rank = -1;
     MPI_Comm parent, remote;
-    int config[8];
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_get_parent(&parent);
+
+    // the worker group is only meaningful when spawned
+    if(MPI_COMM_NULL == parent) return MPI_Finalize();
+
+    // workers are ordered after the parent so that the parent is always rank 0
+    MPI_Intercomm_merge(parent, 1, &remote);
+
+    int config[8]{};
 
     const auto mtype = &config[0];
     const auto nrhs = &config[1];
@@ -36,83 +49,105 @@ int main(int argc, char** argv) {
     const auto nnz = &config[6];
     const auto float_type = &config[7];
 
+    int iparm[64]{};
+    int64_t pt[64]{};
+
+    // ReSharper disable once CppVariableCanBeMadeConstexpr
+    const int comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+
     std::unique_ptr<int[]> ia, ja;
     std::unique_ptr<double[]> a, b, x;
 
-    auto finalise = [&] {
-        if(0 == rank) MPI_Send(&error, 1, MPI_INT, 0, 0, parent);
+    auto analysed = false;
 
-        if(0 != error) MPI_Finalize();
-        else {
-            if(0 == rank) MPI_Send(x.get(), *n * *nrhs, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent);
-            error = MPI_Finalize();
-        }
+    auto reply = [&] { if(0 == rank) MPI_Send(&error, 1, MPI_INT, 0, 0, parent); };
 
-        return error;
+    auto release = [&] {
+        if(!analysed) return;
+        int phase = -1, t_error = 0;
+        cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, nullptr, ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, nullptr, nullptr, &comm, &t_error);
+        analysed = false;
     };
 
-    error = MPI_Init(&argc, &argv);
-    if(MPI_SUCCESS != error) return finalise();
-
-    error = MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if(MPI_SUCCESS != error) return finalise();
-
-    error = MPI_Comm_get_parent(&parent);
-    if(MPI_SUCCESS != error) return finalise();
-
-    error = MPI_Intercomm_merge(parent, 0, &remote);
-    if(MPI_SUCCESS != error) return finalise();
-
-    error = MPI_Bcast(&config, 8, MPI_INT, 0, remote);
-    if(MPI_SUCCESS != error) return finalise();
-
-    const auto np = *n + 1;
-    const auto nb = *n * *nrhs;
-
-    int iparm[64];
-
-    ia = std::make_unique<int[]>(np);
-    ja = std::make_unique<int[]>(*nnz);
-    a = std::make_unique<double[]>(*nnz);
-    b = std::make_unique<double[]>(nb);
-    x = std::make_unique<double[]>(nb);
-
-    if(0 == rank) {
-        MPI_Request requests[5];
-        MPI_Irecv(&iparm, 64, MPI_INT, 0, 0, parent, &requests[0]);
-        MPI_Irecv(ia.get(), np, MPI_INT, 0, 0, parent, &requests[1]);
-        MPI_Irecv(ja.get(), *nnz, MPI_INT, 0, 0, parent, &requests[2]);
-        MPI_Irecv(a.get(), *nnz, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent, &requests[3]);
-        MPI_Irecv(b.get(), nb, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent, &requests[4]);
-        MPI_Waitall(5, requests, MPI_STATUSES_IGNORE);
-
-        iparm[0] = 1;                      /* Solver default parameters overriden with provided by iparm */
-        iparm[1] = 2;                      /* Use METIS for fill-in reordering */
-        iparm[5] = 0;                      /* Write solution into x */
-        iparm[7] = 2;                      /* Max number of iterative refinement steps */
-        iparm[9] = 13;                     /* Perturb the pivot elements with 1E-13 */
-        iparm[10] = 1;                     /* Use nonsymmetric permutation and scaling MPS */
-        iparm[12] = 1;                     /* Switch on Maximum Weighted Matching algorithm (default for non-symmetric) */
-        iparm[17] = -1;                    /* Output: Number of nonzeros in the factor LU */
-        iparm[18] = -1;                    /* Output: Mflops for LU factorization */
-        iparm[26] = 0;                     /* Check input data for correctness */
-        if(*float_type < 0) iparm[27] = 1; /* Single precision */
-        iparm[39] = 0;                     /* Input: matrix/rhs/solution stored on master */
-    }
+    auto command = PardisoCommand::SHUTDOWN;
+
+    do {
+        MPI_Bcast(&command, 1, MPI_INT, 0, remote);
+
+        if(PardisoCommand::ANALYSE == command) {
+            release();
+
+            MPI_Bcast(&config, 8, MPI_INT, 0, remote);
+
+            ia = std::make_unique<int[]>(*n + 1);
+            ja = std::make_unique<int[]>(*nnz);
+            a = std::make_unique<double[]>(*nnz);
+
+            if(0 == rank) {
+                MPI_Request requests[4];
+                MPI_Irecv(&iparm, 64, MPI_INT, 0, 0, parent, &requests[0]);
+                MPI_Irecv(ia.get(), *n + 1, MPI_INT, 0, 0, parent, &requests[1]);
+                MPI_Irecv(ja.get(), *nnz, MPI_INT, 0, 0, parent, &requests[2]);
+                MPI_Irecv(a.get(), *nnz, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent, &requests[3]);
+                MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+
+                iparm[0] = 1;                      /* Solver default parameters overriden with provided by iparm */
+                iparm[1] = 2;                      /* Use METIS for fill-in reordering */
+                iparm[5] = 0;                      /* Write solution into x */
+                iparm[7] = 2;                      /* Max number of iterative refinement steps */
+                iparm[9] = 13;                     /* Perturb the pivot elements with 1E-13 */
+                iparm[10] = 1;                     /* Use nonsymmetric permutation and scaling MPS */
+                iparm[12] = 1;                     /* Switch on Maximum Weighted Matching algorithm (default for non-symmetric) */
+                iparm[17] = -1;                    /* Output: Number of nonzeros in the factor LU */
+                iparm[18] = -1;                    /* Output: Mflops for LU factorization */
+                iparm[26] = 0;                     /* Check input data for correctness */
+                if(*float_type < 0) iparm[27] = 1; /* Single precision */
+                iparm[39] = 0;                     /* Input: matrix/rhs/solution stored on master */
+            }
+
+            int phase = 11;
+            cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, a.get(), ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, nullptr, nullptr, &comm, &error);
+            analysed = 0 == error;
+
+            reply();
+        }
+        else if(PardisoCommand::UPDATE == command) {
+            if(0 == rank) MPI_Recv(a.get(), *nnz, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent, MPI_STATUS_IGNORE);
+        }
+        else if(PardisoCommand::FACTORISE == command) {
+            int phase = 22;
+            if(analysed) cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, a.get(), ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, nullptr, nullptr, &comm, &error);
+            else error = -1;
 
-    int64_t pt[64] = {0};
+            reply();
+        }
+        else if(PardisoCommand::SOLVE == command) {
+            MPI_Bcast(nrhs, 1, MPI_INT, 0, remote);
 
-    // ReSharper disable once CppVariableCanBeMadeConstexpr
-    const int comm = MPI_Comm_c2f(MPI_COMM_WORLD);
+            const auto nb = *n * *nrhs;
+
+            b = std::make_unique<double[]>(nb);
+            x = std::make_unique<double[]>(nb);
+
+            if(0 == rank) MPI_Recv(b.get(), nb, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent, MPI_STATUS_IGNORE);
+
+            int phase = 33;
+            if(analysed) cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, a.get(), ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, b.get(), x.get(), &comm, &error);
+            else error = -1;
+
+            reply();
+
+            if(0 == error && 0 == rank) MPI_Send(x.get(), nb, *float_type > 0 ? MPI_DOUBLE : MPI_FLOAT, 0, 0, parent);
+        }
+    }
+    while(PardisoCommand::SHUTDOWN != command);
 
-    int phase = 13;
-    cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, a.get(), ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, b.get(), x.get(), &comm, &error);
-    if(0 != error) return finalise();
+    release();
 
-    phase = -1;
-    cluster_sparse_solver(&pt, maxfct, mnum, mtype, &phase, n, nullptr, ia.get(), ja.get(), nullptr, nrhs, iparm, msglvl, nullptr, nullptr, &comm, &error);
+    MPI_Comm_free(&remote);
+    MPI_Comm_disconnect(&parent);
 
-    return finalise();
+    return MPI_Finalize();
 }
 
 #else
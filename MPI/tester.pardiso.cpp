@@ -21,6 +21,15 @@
 #include <mpi.h>
 #include <memory>
 #include <iostream>
+#include "command.pardiso.h"
+
+void send_command(PardisoCommand command, const MPI_Comm& remote) { MPI_Bcast(&command, 1, MPI_INT, 0, remote); }
+
+int receive_error(const MPI_Comm& worker) {
+    int error = -1;
+    MPI_Recv(&error, 1, MPI_INT, 0, 0, worker, MPI_STATUS_IGNORE);
+    return error;
+}
 
 void run() {
     constexpr int NUM_NODE = 6;
@@ -28,6 +37,9 @@ void run() {
     MPI_Comm worker;
     MPI_Comm_spawn("solver.pardiso", MPI_ARGV_NULL, NUM_NODE, MPI_INFO_NULL, 0, MPI_COMM_SELF, &worker, MPI_ERRCODES_IGNORE);
 
+    MPI_Comm remote;
+    MPI_Intercomm_merge(worker, 0, &remote);
+
     int iparm[64] = {0};
     int config[8];
 
@@ -81,25 +93,45 @@ void run() {
     a[11] = 8.0;
     a[12] = -5.0;
 
-    for(int i = 0; i < n; i++) b[i] = 1.0;
-
-    MPI_Comm remote;
-    MPI_Intercomm_merge(worker, 0, &remote);
+    // analyse once
+    send_command(PardisoCommand::ANALYSE, remote);
     MPI_Bcast(&config, 8, MPI_INT, 0, remote);
 
-    MPI_Request requests[5];
+    MPI_Request requests[4];
     MPI_Isend(&iparm, 64, MPI_INT, 0, 0, worker, &requests[0]);
     MPI_Isend(ia.get(), n + 1, MPI_INT, 0, 0, worker, &requests[1]);
     MPI_Isend(ja.get(), nnz, MPI_INT, 0, 0, worker, &requests[2]);
     MPI_Isend(a.get(), nnz, MPI_DOUBLE, 0, 0, worker, &requests[3]);
-    MPI_Isend(b.get(), n, MPI_DOUBLE, 0, 0, worker, &requests[4]);
-    MPI_Waitall(5, requests, MPI_STATUSES_IGNORE);
+    MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
 
-    int error = -1;
-    MPI_Recv(&error, 1, MPI_INT, 0, 0, worker, MPI_STATUS_IGNORE);
-    if(0 == error) MPI_Recv(b.get(), n, MPI_DOUBLE, 0, 0, worker, MPI_STATUS_IGNORE);
+    if(0 == receive_error(worker)) {
+        for(auto I = 0; I < 3; ++I) {
+            // scale values and refactorise with the existing analysis
+            for(int i = 0; i < nnz; i++) a[i] *= 2.;
+
+            send_command(PardisoCommand::UPDATE, remote);
+            MPI_Send(a.get(), nnz, MPI_DOUBLE, 0, 0, worker);
+
+            send_command(PardisoCommand::FACTORISE, remote);
+            if(0 != receive_error(worker)) break;
+
+            for(int i = 0; i < n; i++) b[i] = 1.0;
+
+            send_command(PardisoCommand::SOLVE, remote);
+            auto nrhs = 1;
+            MPI_Bcast(&nrhs, 1, MPI_INT, 0, remote);
+            MPI_Send(b.get(), n, MPI_DOUBLE, 0, 0, worker);
+
+            if(0 == receive_error(worker)) MPI_Recv(b.get(), n, MPI_DOUBLE, 0, 0, worker, MPI_STATUS_IGNORE);
+
+            for(int i = 0; i < n; i++) printf("x[%d] = %f\n", i, b[i]);
+        }
+    }
+
+    send_command(PardisoCommand::SHUTDOWN, remote);
 
-    for(int i = 0; i < n; i++) printf("x[%d] = %f\n", i, b[i]);
+    MPI_Comm_free(&remote);
+    MPI_Comm_disconnect(&worker);
 }
 
 int main(int argc, char* argv[]) {
@@ -18,12 +18,29 @@
 #include "Material.h"
 #include <Domain/DomainBase.h>
 #include <Recorder/OutputType.h>
+#include <Toolbox/state_archive.h>
 
 Material::Material(const unsigned T, const MaterialType MT, const double D)
     : DataMaterial{fabs(D), MT}
     , DataCoupleMaterial{}
     , Tag(T) {}
 
+/**
+ * \brief Copies made during the initialisation of an element are enrolled to the element for checkpoints.
+ */
+Material::Material(const Material& old_obj)
+    : DataMaterial(old_obj)
+    , DataCoupleMaterial(old_obj)
+    , Tag(old_obj)
+    , initialized(old_obj.initialized)
+    , symmetric(old_obj.symmetric)
+    , support_couple(old_obj.support_couple)
+    , registry(state_registry::enrol(this)) {}
+
+Material::~Material() {
+    if(nullptr != registry) registry->withdraw(this);
+}
+
 double Material::get_density() const { return density; }
 
 MaterialType Material::get_material_type() const { return material_type; }
@@ -301,6 +318,12 @@ std::vector<vec> Material::record(const OutputType P) {
     return {};
 }
 
+void Material::archive(state_archive& A) {
+    A(current_strain, current_strain_rate, current_strain_acc, current_stress, current_history, current_stiffness, current_damping, current_inertial);
+    A(trial_strain, trial_strain_rate, trial_strain_acc, trial_stress, trial_history, trial_stiffness, trial_damping, trial_inertial);
+    A(current_curvature, current_couple_stress, current_couple_stiffness, trial_curvature, trial_couple_stress, trial_couple_stiffness);
+}
+
 void ConstantStiffness(DataMaterial* M) {
     M->current_stiffness = mat(M->initial_stiffness.memptr(), M->initial_stiffness.n_rows, M->initial_stiffness.n_cols, false, true);
     M->trial_stiffness = mat(M->initial_stiffness.memptr(), M->initial_stiffness.n_rows, M->initial_stiffness.n_cols, false, true);
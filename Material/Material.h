@@ -48,6 +48,8 @@ enum class PlaneType : unsigned {
 };
 
 class DomainBase;
+class state_archive;
+class state_registry;
 enum class OutputType;
 
 struct DataCoupleMaterial {
@@ -119,18 +121,22 @@ class Material : protected DataMaterial, protected DataCoupleMaterial, public Ta
     friend void ConstantCoupleStiffness(DataCoupleMaterial*);
     friend void PureWrapper(Material*);
 
+    friend class state_registry;
+
+    state_registry* registry = nullptr; // the element owning this copy, if any
+
 public:
     explicit Material(
         unsigned = 0,                    // tag
         MaterialType = MaterialType::D0, // material type
         double = 0.                      // density
     );
-    Material(const Material&) = default;
+    Material(const Material&);
     Material(Material&&) = delete;                 // move forbidden
     Material& operator=(const Material&) = delete; // assign forbidden
     Material& operator=(Material&&) = delete;      // assign forbidden
 
-    ~Material() override = default;
+    ~Material() override;
 
     [[nodiscard]] double get_density() const;
     [[nodiscard]] MaterialType get_material_type() const;
@@ -228,6 +234,11 @@ public:
     virtual int reset_couple_status();
 
     virtual std::vector<vec> record(OutputType);
+
+    /**
+     * \brief Archive the state for checkpoints, materials storing state outside the history vector need to override this.
+     */
+    virtual void archive(state_archive&);
 };
 
 namespace suanpan {
@@ -0,0 +1,33 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "CheckpointRecorder.h"
+#include <Domain/DomainBase.h>
+
+CheckpointRecorder::CheckpointRecorder(const unsigned T, string N, const unsigned I)
+    : Recorder(T, {}, OutputType::NL, I, false, true)
+    , file_name(std::move(N)) {}
+
+void CheckpointRecorder::record(const shared_ptr<DomainBase>& D) {
+    if(if_perform_record()) D->save(file_name);
+}
+
+void CheckpointRecorder::save() {}
+
+void CheckpointRecorder::print() {
+    suanpan_info("A checkpoint recorder writing to {} every {} converged increments.\n", file_name, interval);
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class CheckpointRecorder
+ * @brief A CheckpointRecorder class periodically writes checkpoints of the complete state.
+ *
+ * The same file is overwritten by each checkpoint, the analysis can be resumed from the latest one via the
+ * `restore` command. Files are written by the output thread so that the analysis does not stall.
+ *
+ * @author tlc
+ * @date 18/10/2026
+ * @version 0.1.0
+ * @file CheckpointRecorder.h
+ * @addtogroup Recorder
+ * @{
+ */
+
+#ifndef CHECKPOINTRECORDER_H
+#define CHECKPOINTRECORDER_H
+
+#include <Recorder/Recorder.h>
+
+class CheckpointRecorder final : public Recorder {
+    const string file_name;
+
+public:
+    CheckpointRecorder(
+        unsigned, // tag
+        string,   // file name
+        unsigned  // interval
+    );
+
+    void record(const shared_ptr<DomainBase>&) override;
+
+    void save() override;
+
+    void print() override;
+};
+
+#endif
+
+//! @}
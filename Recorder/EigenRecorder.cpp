@@ -25,8 +25,6 @@
 #include <hdf5_hl.h>
 #endif
 
-extern fs::path SUANPAN_OUTPUT;
-
 EigenRecorder::EigenRecorder(const unsigned T, const bool H)
     : Recorder(T, {}, OutputType::NL, 1, false, H) {}
 
@@ -48,6 +46,8 @@ void EigenRecorder::record(const shared_ptr<DomainBase>& D) {
     }
 }
 
+bool EigenRecorder::if_record_next() const { return false; }
+
 void EigenRecorder::save() {
     if(eigen_value.is_empty()) return;
 
@@ -55,26 +55,28 @@ void EigenRecorder::save() {
     if(if_hdf5()) {
         const string file_name = "Eigenvalue.h5";
 
-        const auto file_id = H5Fcreate((SUANPAN_OUTPUT / file_name).generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        queue_output([file_path = (get_output_path() / file_name).generic_string(), eigen_value = eigen_value, eigen_pool = eigen_pool] {
+            const auto file_id = H5Fcreate(file_path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
 
-        hsize_t dimension[2] = {eigen_value.n_elem, 1};
-        H5LTmake_dataset(file_id, "Eigenvalue", 2, dimension, H5T_NATIVE_DOUBLE, eigen_value.mem);
+            hsize_t dimension[2] = {eigen_value.n_elem, 1};
+            H5LTmake_dataset(file_id, "Eigenvalue", 2, dimension, H5T_NATIVE_DOUBLE, eigen_value.mem);
 
-        for(uword I = 0; I < eigen_value.n_elem; ++I) {
-            const auto group_name = "Eigenvalue " + std::to_string(I + 1);
-            const auto group_id = H5Gcreate(file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            for(uword I = 0; I < eigen_value.n_elem; ++I) {
+                const auto group_name = "Eigenvalue " + std::to_string(I + 1);
+                const auto group_id = H5Gcreate(file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
-            for(const auto& [e_val, e_vec] : eigen_pool[I]) {
-                const auto dataset_name = "N" + std::to_string(e_val);
-                dimension[0] = e_vec.n_cols;
-                dimension[1] = e_vec.n_rows;
-                H5LTmake_dataset(group_id, dataset_name.c_str(), 2, dimension, H5T_NATIVE_DOUBLE, e_vec.mem);
-            }
+                for(const auto& [e_val, e_vec] : eigen_pool[I]) {
+                    const auto dataset_name = "N" + std::to_string(e_val);
+                    dimension[0] = e_vec.n_cols;
+                    dimension[1] = e_vec.n_rows;
+                    H5LTmake_dataset(group_id, dataset_name.c_str(), 2, dimension, H5T_NATIVE_DOUBLE, e_vec.mem);
+                }
 
-            H5Gclose(group_id);
-        }
+                H5Gclose(group_id);
+            }
 
-        H5Fclose(file_id);
+            H5Fclose(file_id);
+        });
     }
 #endif
 }
@@ -40,6 +40,11 @@ public:
 
     void record(const shared_ptr<DomainBase>&) override;
 
+    /**
+     * \brief Eigen results are taken from the factory directly, no state is sampled.
+     */
+    [[nodiscard]] bool if_record_next() const override;
+
     void save() override;
 
     void print() override;
@@ -25,20 +25,26 @@
 #include <hdf5_hl.h>
 #endif
 
-extern fs::path SUANPAN_OUTPUT;
-
 FrameRecorder::FrameRecorder(const unsigned T, const OutputType L, const unsigned I)
-    : Recorder(T, {}, L, I, false, true) {
+    : Recorder(T, {}, L, I, false, true) {}
+
+FrameRecorder::~FrameRecorder() {
 #ifdef SUANPAN_HDF5
-    ostringstream file_name;
-    file_name << 'R' << get_tag() << '-' << to_name(get_variable_type()) << ".h5";
-    file_id = H5Fcreate((SUANPAN_OUTPUT / file_name.str()).generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if(!file_created) return;
+    // pending writes refer to the file
+    flush_output();
+    H5Fclose(file_id);
 #endif
 }
 
-FrameRecorder::~FrameRecorder() {
+void FrameRecorder::initialize(const shared_ptr<DomainBase>&) {
 #ifdef SUANPAN_HDF5
-    H5Fclose(file_id);
+    // the output folder is known once assigned to a domain, the file is kept across restarts
+    if(std::exchange(file_created, true)) return;
+
+    ostringstream file_name;
+    file_name << 'R' << get_tag() << '-' << to_name(get_variable_type()) << ".h5";
+    queue_output([this, file_path = (get_output_path() / file_name.str()).generic_string()] { file_id = H5Fcreate(file_path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT); });
 #endif
 }
 
@@ -50,8 +56,8 @@ void FrameRecorder::record([[maybe_unused]] const shared_ptr<DomainBase>& D) {
     group_name << "/";
     group_name << D->get_factory()->get_current_time();
 
-    const auto group_id = H5Gcreate(file_id, group_name.str().c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-
+    // snapshot the current frame, the file is written by the output thread
+    std::vector<std::pair<unsigned, mat>> frame;
     for(const auto& I : D->get_element_pool()) {
         if(const auto data = I->record(get_variable_type()); !data.empty()) {
             mat data_to_write(data[0].n_elem, data.size());
@@ -59,13 +65,21 @@ void FrameRecorder::record([[maybe_unused]] const shared_ptr<DomainBase>& D) {
             uword idx = 0;
             for(const auto& J : data) data_to_write.col(idx++) = J;
 
+            frame.emplace_back(I->get_tag(), std::move(data_to_write));
+        }
+    }
+
+    queue_output([this, group_name = group_name.str(), frame = std::move(frame)] {
+        const auto group_id = H5Gcreate(file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+        for(const auto& [tag, data_to_write] : frame) {
             const hsize_t dimension[2] = {data_to_write.n_cols, data_to_write.n_rows};
 
-            H5LTmake_dataset(group_id, std::to_string(I->get_tag()).c_str(), 2, dimension, H5T_NATIVE_DOUBLE, data_to_write.mem);
+            H5LTmake_dataset(group_id, std::to_string(tag).c_str(), 2, dimension, H5T_NATIVE_DOUBLE, data_to_write.mem);
         }
-    }
 
-    H5Gclose(group_id);
+        H5Gclose(group_id);
+    });
 #endif
 }
 
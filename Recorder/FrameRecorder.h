@@ -34,6 +34,7 @@
 class FrameRecorder final : public Recorder {
 #ifdef SUANPAN_HDF5
     hid_t file_id = 0;
+    bool file_created = false;
 #endif
 
 public:
@@ -48,6 +49,8 @@ public:
     FrameRecorder& operator=(FrameRecorder&&) noexcept = delete;
     ~FrameRecorder() override;
 
+    void initialize(const shared_ptr<DomainBase>&) override;
+
     void record(const shared_ptr<DomainBase>&) override;
 
     void save() override;
@@ -16,41 +16,17 @@
  ******************************************************************************/
 
 #include "GlobalMassRecorder.h"
-#include <Domain/DomainBase.h>
-#include <Domain/Factory.hpp>
 #include <Element/Element.h>
 
-void GlobalMassRecorder::assemble_mass(const mat& EM, const uvec& EC, mat& GM) {
-    if(EM.is_empty()) return;
-
-    for(unsigned I = 0; I < EC.n_elem; ++I) for(unsigned J = 0; J < EC.n_elem; ++J) GM(EC(J), EC(I)) += EM(J, I);
-}
-
 GlobalMassRecorder::GlobalMassRecorder(const unsigned T, const unsigned I, const bool R, const bool H)
-    : GlobalRecorder(T, OutputType::M, I, R, H) {}
+    : GlobalRecorder(T, OutputType::M, I, R, H) {
+    if(H) set_stream(sparse_chunk);
+}
 
 void GlobalMassRecorder::record(const shared_ptr<DomainBase>& D) {
     if(!if_perform_record()) return;
 
-    auto& W = D->get_factory();
-    auto& C = D->get_color_map();
-
-    const uword S = W->get_size();
-
-    vec mass(S * S, fill::zeros);
-
-    if(mat g_mass(mass.memptr(), S, S, false, true); C.empty()) for(const auto& I : D->get_element_pool()) assemble_mass(I->get_current_mass(), I->get_dof_encoding(), g_mass);
-    else
-        std::ranges::for_each(C, [&](const std::vector<unsigned>& color) {
-            suanpan::for_all(color, [&](const unsigned tag) {
-                const auto& I = D->get<Element>(tag);
-                assemble_mass(I->get_current_mass(), I->get_dof_encoding(), g_mass);
-            });
-        });
-
-    insert({mass}, 0);
-
-    if(if_record_time()) insert(D->get_factory()->get_current_time());
+    record_sparse(D, &Element::get_current_mass);
 }
 
 void GlobalMassRecorder::print() {
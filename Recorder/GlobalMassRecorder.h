@@ -32,8 +32,6 @@
 #include "GlobalRecorder.h"
 
 class GlobalMassRecorder final : public GlobalRecorder {
-    static void assemble_mass(const mat&, const uvec&, mat&);
-
 public:
     GlobalMassRecorder(
         unsigned, // tag
@@ -21,9 +21,85 @@
 #include <Domain/Factory.hpp>
 #include <Element/Element.h>
 
+void GlobalRecorder::initialize_pattern(const shared_ptr<DomainBase>& D) {
+    auto& W = D->get_factory();
+
+    const auto n_size = W->get_size();
+
+    sparse_mapping.clear();
+
+    // reuse the frozen pattern and the scatter maps of elements
+    triplet_form<double, uword> t_pattern;
+    if(!W->has_sparse_pattern()) {
+        t_pattern = triplet_form<double, uword>(n_size, n_size, W->get_entry());
+        for(const auto& I : D->get_element_pool()) {
+            auto& t_encoding = I->get_dof_encoding();
+            t_pattern.assemble(mat(t_encoding.n_elem, t_encoding.n_elem, fill::ones), t_encoding);
+        }
+        t_pattern.csc_condense();
+        for(const auto& I : D->get_element_pool()) sparse_mapping[I->get_tag()] = t_pattern.locate(I->get_dof_encoding());
+    }
+
+    const auto& pattern = W->has_sparse_pattern() ? W->get_sparse_pattern() : t_pattern;
+
+    n_nonzero = pattern.n_elem;
+
+    uvec row_index(n_nonzero), column_pointer(n_size + 1, fill::zeros);
+    for(uword I = 0; I < n_nonzero; ++I) {
+        row_index(I) = pattern.row(I);
+        ++column_pointer(pattern.col(I) + 1);
+    }
+
+    column_pointer = cumsum(column_pointer);
+
+    // samples of a different pattern cannot be appended to the existing datasets
+    auto changed = [&](const string& name, const uvec& current) {
+        const auto previous = get_attachment(name);
+        return nullptr != previous && (previous->n_elem != current.n_elem || any(*previous != current));
+    };
+    if(changed("RowIndex", row_index) || changed("ColumnPointer", column_pointer)) {
+        if(if_stream()) split_stream();
+        else suanpan_warning("The sparse pattern changes, samples of recorder {} recorded before the change do not follow the saved pattern.\n", get_tag());
+    }
+
+    attach("RowIndex", std::move(row_index));
+    attach("ColumnPointer", std::move(column_pointer));
+
+    set_column_layout({0, n_nonzero});
+}
+
+void GlobalRecorder::record_sparse(const shared_ptr<DomainBase>& D, const mat& (Element::*get_matrix)() const) {
+    if(!pattern_ready) {
+        initialize_pattern(D);
+        pattern_ready = true;
+    }
+
+    vec value(n_nonzero, fill::zeros);
+
+    auto assemble = [&](const shared_ptr<Element>& t_element) {
+        const auto& t_matrix = (*t_element.*get_matrix)();
+        if(t_matrix.is_empty()) return;
+        const auto& t_mapping = sparse_mapping.empty() ? t_element->get_sparse_mapping() : sparse_mapping.at(t_element->get_tag());
+        for(uword I = 0; I < t_mapping.n_elem; ++I) value(t_mapping(I)) += t_matrix(I);
+    };
+
+    // elements of the same colour do not share dofs
+    if(auto& C = D->get_color_map(); C.empty()) for(const auto& I : D->get_element_pool()) assemble(I);
+    else std::ranges::for_each(C, [&](const std::vector<unsigned>& color) { suanpan::for_all(color, [&](const unsigned tag) { assemble(D->get<Element>(tag)); }); });
+
+    insert(std::move(value));
+
+    if(if_record_time()) insert(D->get_factory()->get_current_time());
+}
+
 GlobalRecorder::GlobalRecorder(const unsigned T, const OutputType L, const unsigned I, const bool R, const bool H)
     : Recorder(T, {0}, L, I, R, H) {}
 
+void GlobalRecorder::initialize(const shared_ptr<DomainBase>&) {
+    // the pattern is resolved on the first record as the domain assigns the frozen pattern after recorders are initialised
+    pattern_ready = false;
+}
+
 void GlobalRecorder::record(const shared_ptr<DomainBase>& D) {
     if(!if_perform_record()) return;
 
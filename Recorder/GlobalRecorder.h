@@ -31,7 +31,26 @@
 
 #include <Recorder/Recorder.h>
 
+class Element;
+
 class GlobalRecorder : public Recorder {
+    bool pattern_ready = false;
+    uword n_nonzero = 0;
+
+    std::unordered_map<unsigned, uvec> sparse_mapping; // storage position of element entries if the domain does not freeze the pattern
+
+    void initialize_pattern(const shared_ptr<DomainBase>&);
+
+protected:
+    static constexpr unsigned sparse_chunk = 16; // matrices of large models are streamed to file by this number of samples
+
+    /**
+     * \brief Record the global matrix assembled from the given element matrices in the csc format.
+     * The pattern is built from element connectivity, or taken from the domain if frozen, and written once.
+     * Only values are recorded per sample. If the pattern changes, streamed samples continue in a new group.
+     */
+    void record_sparse(const shared_ptr<DomainBase>&, const mat& (Element::*)() const);
+
 public:
     GlobalRecorder(
         unsigned,   // tag
@@ -41,6 +60,8 @@ public:
         bool        // if to use hdf5
     );
 
+    void initialize(const shared_ptr<DomainBase>&) override;
+
     void record(const shared_ptr<DomainBase>&) override;
 
     void print() override;
@@ -16,41 +16,17 @@
  ******************************************************************************/
 
 #include "GlobalStiffnessRecorder.h"
-#include <Domain/DomainBase.h>
-#include <Domain/Factory.hpp>
 #include <Element/Element.h>
 
-void GlobalStiffnessRecorder::assemble_stiffness(const mat& EK, const uvec& EC, mat& GK) {
-    if(EK.is_empty()) return;
-
-    for(unsigned I = 0; I < EC.n_elem; ++I) for(unsigned J = 0; J < EC.n_elem; ++J) GK(EC(J), EC(I)) += EK(J, I);
-}
-
 GlobalStiffnessRecorder::GlobalStiffnessRecorder(const unsigned T, const unsigned I, const bool R, const bool H)
-    : GlobalRecorder(T, OutputType::K, I, R, H) {}
+    : GlobalRecorder(T, OutputType::K, I, R, H) {
+    if(H) set_stream(sparse_chunk);
+}
 
 void GlobalStiffnessRecorder::record(const shared_ptr<DomainBase>& D) {
     if(!if_perform_record()) return;
 
-    auto& W = D->get_factory();
-    auto& C = D->get_color_map();
-
-    const uword S = W->get_size();
-
-    vec stiffness(S * S, fill::zeros);
-
-    if(mat g_stiffness(stiffness.memptr(), S, S, false, true); C.empty()) for(const auto& I : D->get_element_pool()) assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), g_stiffness);
-    else
-        std::ranges::for_each(C, [&](const std::vector<unsigned>& color) {
-            suanpan::for_all(color, [&](const unsigned tag) {
-                const auto& I = D->get<Element>(tag);
-                assemble_stiffness(I->get_current_stiffness(), I->get_dof_encoding(), g_stiffness);
-            });
-        });
-
-    insert({stiffness}, 0);
-
-    if(if_record_time()) insert(D->get_factory()->get_current_time());
+    record_sparse(D, &Element::get_current_stiffness);
 }
 
 void GlobalStiffnessRecorder::print() {
@@ -32,8 +32,6 @@
 #include "GlobalRecorder.h"
 
 class GlobalStiffnessRecorder final : public GlobalRecorder {
-    static void assemble_stiffness(const mat&, const uvec&, mat&);
-
 public:
     GlobalStiffnessRecorder(
         unsigned, // tag
@@ -32,11 +32,24 @@ void NodeRecorder::initialize(const shared_ptr<DomainBase>& D) {
     set_object_tag(pool);
 
     access::rw(get_data_pool()).resize(get_object_tag().n_elem);
+
+    // dofs are resolved once so that each sample is gathered without looking up nodes
+    set_column_layout(initialize_gather(D, get_object_tag()));
 }
 
 void NodeRecorder::record(const shared_ptr<DomainBase>& D) {
     if(!if_perform_record()) return;
 
+    if(if_column()) {
+        if(auto column = gather(D); !column.empty()) {
+            insert(std::move(column));
+            if(if_record_time()) insert(D->get_factory()->get_current_time());
+            return;
+        }
+        // some nodes are deactivated, samples are taken by looking up nodes until the next initialisation
+        set_column_layout({});
+    }
+
     auto& obj_tag = get_object_tag();
 
     auto insert_damping_force = [&](const uword J) {
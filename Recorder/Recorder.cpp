@@ -16,12 +16,18 @@
  ******************************************************************************/
 
 #include "Recorder.h"
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Domain/Node.h>
+#include <Toolbox/writer_queue.hpp>
 
 extern fs::path SUANPAN_OUTPUT;
 
 #ifdef SUANPAN_HDF5
 #include <hdf5.h>
 #include <hdf5_hl.h>
+
+static_assert(std::is_same_v<hid_t, int64_t>);
 #endif
 
 /**
@@ -42,9 +48,295 @@ Recorder::Recorder(const unsigned T, uvec&& B, const OutputType L, const unsigne
     , use_hdf5(H)
     , interval(I) {}
 
+Recorder::~Recorder() {
+    // write remaining samples
+    if(stream_chunk > 0u) flush_stream();
+    close_stream();
+}
+
+/**
+ * \brief Map the variable type to the global quantity and the component to gather.
+ * Nodal damping and inertial forces (DF, IF) are held by nodes and differ from the global vectors, they are not gathered.
+ * \return source type and component index, a negative index denotes all dofs
+ */
+static std::pair<OutputType, int> to_gather(const OutputType L) {
+    switch(L) {
+    case OutputType::U:
+    case OutputType::V:
+    case OutputType::A:
+    case OutputType::RF:
+        return {L, -1};
+    case OutputType::U1:
+        return {OutputType::U, 0};
+    case OutputType::U2:
+        return {OutputType::U, 1};
+    case OutputType::U3:
+        return {OutputType::U, 2};
+    case OutputType::U4:
+    case OutputType::UR1:
+        return {OutputType::U, 3};
+    case OutputType::U5:
+    case OutputType::UR2:
+        return {OutputType::U, 4};
+    case OutputType::U6:
+    case OutputType::UR3:
+        return {OutputType::U, 5};
+    case OutputType::V1:
+        return {OutputType::V, 0};
+    case OutputType::V2:
+        return {OutputType::V, 1};
+    case OutputType::V3:
+        return {OutputType::V, 2};
+    case OutputType::V4:
+    case OutputType::VR1:
+        return {OutputType::V, 3};
+    case OutputType::V5:
+    case OutputType::VR2:
+        return {OutputType::V, 4};
+    case OutputType::V6:
+    case OutputType::VR3:
+        return {OutputType::V, 5};
+    case OutputType::A1:
+        return {OutputType::A, 0};
+    case OutputType::A2:
+        return {OutputType::A, 1};
+    case OutputType::A3:
+        return {OutputType::A, 2};
+    case OutputType::A4:
+    case OutputType::AR1:
+        return {OutputType::A, 3};
+    case OutputType::A5:
+    case OutputType::AR2:
+        return {OutputType::A, 4};
+    case OutputType::A6:
+    case OutputType::AR3:
+        return {OutputType::A, 5};
+    case OutputType::RF1:
+        return {OutputType::RF, 0};
+    case OutputType::RF2:
+        return {OutputType::RF, 1};
+    case OutputType::RF3:
+        return {OutputType::RF, 2};
+    case OutputType::RF4:
+    case OutputType::RM1:
+        return {OutputType::RF, 3};
+    case OutputType::RF5:
+    case OutputType::RM2:
+        return {OutputType::RF, 4};
+    case OutputType::RF6:
+    case OutputType::RM3:
+        return {OutputType::RF, 5};
+    case OutputType::GDF1:
+        return {OutputType::DF, 0};
+    case OutputType::GDF2:
+        return {OutputType::DF, 1};
+    case OutputType::GDF3:
+        return {OutputType::DF, 2};
+    case OutputType::GDF4:
+    case OutputType::GDM1:
+        return {OutputType::DF, 3};
+    case OutputType::GDF5:
+    case OutputType::GDM2:
+        return {OutputType::DF, 4};
+    case OutputType::GDF6:
+    case OutputType::GDM3:
+        return {OutputType::DF, 5};
+    case OutputType::GIF1:
+        return {OutputType::IF, 0};
+    case OutputType::GIF2:
+        return {OutputType::IF, 1};
+    case OutputType::GIF3:
+        return {OutputType::IF, 2};
+    case OutputType::GIF4:
+    case OutputType::GIM1:
+        return {OutputType::IF, 3};
+    case OutputType::GIF5:
+    case OutputType::GIM2:
+        return {OutputType::IF, 4};
+    case OutputType::GIF6:
+    case OutputType::GIM3:
+        return {OutputType::IF, 5};
+    default:
+        return {OutputType::NL, 0};
+    }
+}
+
+/**
+ * \brief Move gathered columns into the per object storage, called before the layout changes.
+ */
+void Recorder::spill_column() {
+    if(column_pool.empty()) return;
+
+    const auto n_object = column_offset.n_elem - 1;
+    if(data_pool.size() < n_object) data_pool.resize(n_object);
+
+    for(const auto& I : column_pool)
+        for(uword J = 0; J < n_object; ++J) data_pool[J].emplace_back(std::vector<vec>{I.subvec(column_offset(J), arma::size(column_offset(J + 1) - column_offset(J), 1))});
+
+    column_pool.clear();
+}
+
+/**
+ * \brief Arrange samples of each object into a matrix with one sample per column and the time stamp in the first row.
+ * Samples stored per object precede gathered columns. Objects without any sample are left empty.
+ */
+std::vector<mat> Recorder::arrange(const std::vector<double>& t_time_pool, const std::vector<std::vector<std::vector<vec>>>& t_data_pool, const std::vector<vec>& t_column_pool) const {
+    const auto n_column = t_column_pool.empty() ? 0llu : column_offset.n_elem - 1;
+
+    std::vector<mat> arranged(std::max<size_t>(t_data_pool.size(), n_column));
+
+    for(size_t I = 0; I < arranged.size(); ++I) {
+        const auto n_sample = I < t_data_pool.size() ? t_data_pool[I].size() : 0llu;
+        if(0 == n_sample && I >= n_column) continue;
+
+        auto width = I < n_column ? column_offset(I + 1) - column_offset(I) : 0llu;
+        if(n_sample > 0) {
+            auto max_size = 0llu;
+            for(const auto& J : t_data_pool[I][0]) if(J.n_elem > max_size) max_size = J.n_elem;
+            width = std::max<uword>(width, t_data_pool[I][0].size() * max_size);
+        }
+
+        auto& data_to_write = arranged[I];
+        data_to_write.zeros(width + 1, t_time_pool.size());
+        data_to_write.row(0) = rowvec(t_time_pool);
+
+        uword J = 0;
+        for(; J < n_sample && J < t_time_pool.size(); ++J) {
+            uword L = 1;
+            for(const auto& K : t_data_pool[I][J]) for(uword M = 0; M < K.n_elem && L <= width; ++M) data_to_write(L++, J) = K[M];
+        }
+        if(I < n_column)
+            for(const auto& K : t_column_pool) {
+                if(J >= t_time_pool.size()) break;
+                if(column_offset(I + 1) > column_offset(I)) data_to_write.col(J).subvec(1, column_offset(I + 1) - column_offset(I)) = K.subvec(column_offset(I), column_offset(I + 1) - 1);
+                ++J;
+            }
+    }
+
+    return arranged;
+}
+
+fs::path Recorder::get_output_path() const { return output_path.empty() ? SUANPAN_OUTPUT : output_path; }
+
+void Recorder::queue_output(std::function<void()>&& task) const { suanpan::output_queue().push(std::move(task), output_owner); }
+
+void Recorder::flush_output() const { suanpan::output_queue().flush(output_owner); }
+
+void Recorder::set_output(const fs::path& P, const DomainBase* D) {
+    output_path = P;
+    output_owner = D;
+}
+
 void Recorder::initialize(const shared_ptr<DomainBase>&) {}
 
-void Recorder::set_object_tag(uvec&& T) { object_tag = std::move(T); }
+uvec Recorder::initialize_gather(const shared_ptr<DomainBase>& D, const uvec& node_tag, const bool global_force) {
+    gather_type = OutputType::NL;
+    gather_source.reset();
+    gather_target.reset();
+    gather_node.clear();
+    gather_width = 0;
+
+    const auto [type, component] = to_gather(variable_type);
+    if(OutputType::NL == type) return {};
+    if(!global_force && (OutputType::DF == type || OutputType::IF == type)) return {};
+
+    uvec offset(node_tag.n_elem + 1);
+    offset(0) = 0;
+
+    std::vector<uword> source, target;
+    std::vector<shared_ptr<Node>> node_pool;
+    node_pool.reserve(node_tag.n_elem);
+    for(uword I = 0; I < node_tag.n_elem; ++I) {
+        const auto t_node = D->find<Node>(node_tag(I)) ? D->get<Node>(node_tag(I)) : nullptr;
+        // inactive nodes are skipped by the lookup path
+        if(nullptr == t_node || !t_node->is_active()) return {};
+        node_pool.emplace_back(t_node);
+        const auto& t_dof = t_node->get_reordered_dof();
+        if(component < 0) {
+            for(uword J = 0; J < t_dof.n_elem; ++J) {
+                source.emplace_back(t_dof(J));
+                target.emplace_back(offset(I) + J);
+            }
+            offset(I + 1) = offset(I) + t_dof.n_elem;
+        }
+        else {
+            // missing components are recorded as zeros
+            if(static_cast<uword>(component) < t_dof.n_elem) {
+                source.emplace_back(t_dof(component));
+                target.emplace_back(offset(I));
+            }
+            offset(I + 1) = offset(I) + 1;
+        }
+    }
+
+    gather_type = type;
+    gather_source = source;
+    gather_target = target;
+    gather_node = std::move(node_pool);
+    gather_width = offset.back();
+
+    return offset;
+}
+
+/**
+ * \brief Gather the current state of resolved dofs into one column.
+ * \return empty if any node is deactivated since the dofs are resolved, the caller shall fall back to the lookup path
+ */
+vec Recorder::gather(const shared_ptr<DomainBase>& D) const {
+    if(std::ranges::any_of(gather_node, [](const shared_ptr<Node>& N) { return !N->is_active(); })) return {};
+
+    const auto& W = D->get_factory();
+
+    const auto& t_source = [&]() -> const vec& {
+        if(OutputType::U == gather_type) return W->get_current_displacement();
+        if(OutputType::V == gather_type) return W->get_current_velocity();
+        if(OutputType::A == gather_type) return W->get_current_acceleration();
+        if(OutputType::RF == gather_type) return W->get_current_resistance();
+        if(OutputType::DF == gather_type) return W->get_current_damping_force();
+        return W->get_current_inertial_force();
+    }();
+
+    vec column(gather_width, fill::zeros);
+    // forces that are not formed are recorded as zeros
+    if(!t_source.empty()) column(gather_target) = t_source(gather_source);
+
+    return column;
+}
+
+void Recorder::set_column_layout(uvec&& O) {
+    if(!column_pool.empty() && (O.n_elem != column_offset.n_elem || any(O != column_offset))) spill_column();
+    column_offset = std::move(O);
+}
+
+bool Recorder::if_column() const { return !column_offset.empty(); }
+
+void Recorder::insert(vec&& D) { column_pool.emplace_back(std::move(D)); }
+
+void Recorder::attach(string&& N, uvec&& D) {
+    if(const auto I = std::ranges::find_if(attachment, [&](const std::pair<string, uvec>& A) { return A.first == N; }); I != attachment.end()) I->second = std::move(D);
+    else attachment.emplace_back(std::move(N), std::move(D));
+    attachment_pending = true;
+}
+
+const uvec* Recorder::get_attachment(const string& N) const {
+    const auto I = std::ranges::find_if(attachment, [&](const std::pair<string, uvec>& A) { return A.first == N; });
+    return I == attachment.end() ? nullptr : &I->second;
+}
+
+void Recorder::split_stream() {
+    if(0u == stream_chunk) return;
+
+    flush_stream();
+    ++stream_segment;
+    // the new group needs attachments again
+    attachment_pending = !attachment.empty();
+}
+
+void Recorder::set_object_tag(uvec&& T) {
+    // gathered columns refer to the current objects
+    spill_column();
+    object_tag = std::move(T);
+}
 
 const uvec& Recorder::get_object_tag() const { return object_tag; }
 
@@ -56,9 +348,25 @@ bool Recorder::if_hdf5() const { return use_hdf5; }
 
 bool Recorder::if_record_time() const { return record_time; }
 
+void Recorder::set_stream(const unsigned C) {
+#ifdef SUANPAN_HDF5
+    if(use_hdf5) stream_chunk = std::max(1u, C);
+#else
+    suanpan_warning("Streaming requires hdf5 support, recorder {} keeps all samples in memory.\n", get_tag());
+#endif
+}
+
+bool Recorder::if_stream() const { return stream_chunk > 0u; }
+
+bool Recorder::if_record_next() const { return 1 == interval || 0 == counter % interval; }
+
 bool Recorder::if_perform_record() { return 1 == interval || 0 == counter++ % interval; }
 
-void Recorder::insert(const double T) { time_pool.emplace_back(T); }
+void Recorder::insert(const double T) {
+    time_pool.emplace_back(T);
+    // time stamp is inserted after all objects, the sample is complete
+    if(stream_chunk > 0u && time_pool.size() >= stream_chunk) flush_stream();
+}
 
 void Recorder::insert(const std::vector<vec>& D, const unsigned I) { data_pool[I].emplace_back(D); }
 
@@ -66,13 +374,156 @@ const std::vector<std::vector<std::vector<vec>>>& Recorder::get_data_pool() cons
 
 const std::vector<double>& Recorder::get_time_pool() const { return time_pool; }
 
+std::vector<mat> Recorder::get_sample() const { return arrange(time_pool, data_pool, column_pool); }
+
 void Recorder::clear_status() {
     time_pool.clear();
-    data_pool.clear();
+    // keep one pool per object
+    for(auto& I : data_pool) I.clear();
+    column_pool.clear();
+    close_stream();
 }
 
+/**
+ * \brief Hand staged samples over to the output queue and release them.
+ */
+void Recorder::flush_stream() {
+#ifdef SUANPAN_HDF5
+    if(time_pool.empty()) return;
+
+    auto arranged = arrange(time_pool, data_pool, column_pool);
+
+    time_pool.clear();
+    for(auto& I : data_pool) I.clear();
+    column_pool.clear();
+
+    // attachments are only handed over when changed
+    auto t_attachment = std::exchange(attachment_pending, false) ? attachment : std::vector<std::pair<string, uvec>>{};
+
+    // the recorder outlives the task as closing the stream flushes the queue
+    queue_output([this, output = get_output_path(), arranged = std::move(arranged), tag = object_tag, t_attachment = std::move(t_attachment), segment = stream_segment] { write_stream(output, arranged, tag, t_attachment, segment); });
+#endif
+}
+
+/**
+ * \brief Append samples to the file, only called by the output thread.
+ * Each dataset is created with an unlimited number of rows on the first write, when its width is known from the samples.
+ * Rows of objects without any sample are left as the fill value (zero).
+ */
+void Recorder::write_stream([[maybe_unused]] const fs::path& output, [[maybe_unused]] const std::vector<mat>& arranged, [[maybe_unused]] const uvec& tag, [[maybe_unused]] const std::vector<std::pair<string, uvec>>& t_attachment, [[maybe_unused]] const unsigned segment) {
+#ifdef SUANPAN_HDF5
+    const auto origin_name = fmt::format("R{}-{}", get_tag(), to_name(variable_type));
+
+    if(stream_file < 0) {
+        stream_file = H5Fcreate((output / (origin_name + ".h5")).generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        if(stream_file < 0) {
+            suanpan_error("Fail to create file for recorder {}, samples are discarded.\n", get_tag());
+            return;
+        }
+    }
+
+    if(stream_group < 0 || segment != stream_group_segment) {
+        for(const auto I : stream_dataset)
+            if(I >= 0) H5Dclose(I);
+        if(stream_group >= 0) H5Gclose(stream_group);
+
+        const auto group_name = 0u == segment ? origin_name : fmt::format("{}-{}", origin_name, segment);
+        stream_group = H5Gcreate(stream_file, ('/' + group_name).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        stream_group_segment = segment;
+        stream_dataset.assign(arranged.size(), -1);
+        stream_width.assign(arranged.size(), 0);
+        stream_size = 0;
+    }
+
+    for(const auto& [name, data] : t_attachment) {
+        const auto dataset_name = fmt::format("{}-{}", origin_name, name);
+        if(H5Lexists(stream_group, dataset_name.c_str(), H5P_DEFAULT) > 0) H5Ldelete(stream_group, dataset_name.c_str(), H5P_DEFAULT);
+        const hsize_t dimension[1] = {data.n_elem};
+        H5LTmake_dataset(stream_group, dataset_name.c_str(), 1, dimension, H5T_NATIVE_UINT64, data.memptr());
+    }
+
+    auto n_sample = 0llu;
+
+    for(size_t I = 0; I < arranged.size() && I < stream_dataset.size(); ++I) {
+        if(arranged[I].empty()) continue;
+
+        if(stream_dataset[I] < 0) {
+            stream_width[I] = arranged[I].n_rows;
+
+            const hsize_t dimension[2] = {0, stream_width[I]}, max_dimension[2] = {H5S_UNLIMITED, stream_width[I]}, chunk[2] = {stream_chunk, stream_width[I]};
+
+            const auto space_id = H5Screate_simple(2, dimension, max_dimension);
+            const auto property_id = H5Pcreate(H5P_DATASET_CREATE);
+            H5Pset_chunk(property_id, 2, chunk);
+            stream_dataset[I] = H5Dcreate(stream_group, fmt::format("{}{}", origin_name, tag(I)).c_str(), H5T_NATIVE_DOUBLE, space_id, H5P_DEFAULT, property_id, H5P_DEFAULT);
+            H5Pclose(property_id);
+            H5Sclose(space_id);
+        }
+
+        const auto width = stream_width[I];
+        n_sample = arranged[I].n_cols;
+
+        mat data_to_write = arranged[I];
+        data_to_write.resize(width, n_sample);
+
+        const hsize_t extent[2] = {stream_size + n_sample, width}, offset[2] = {stream_size, 0}, count[2] = {n_sample, width};
+        H5Dset_extent(stream_dataset[I], extent);
+
+        const auto file_space_id = H5Dget_space(stream_dataset[I]);
+        H5Sselect_hyperslab(file_space_id, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+        const auto memory_space_id = H5Screate_simple(2, count, nullptr);
+        H5Dwrite(stream_dataset[I], H5T_NATIVE_DOUBLE, memory_space_id, file_space_id, H5P_DEFAULT, data_to_write.memptr());
+        H5Sclose(memory_space_id);
+        H5Sclose(file_space_id);
+    }
+
+    // partial results remain readable if the analysis is aborted
+    H5Fflush(stream_file, H5F_SCOPE_LOCAL);
+
+    stream_size += n_sample;
+#endif
+}
+
+void Recorder::close_stream() {
+#ifdef SUANPAN_HDF5
+    if(0u == stream_chunk) return;
+
+    // pending writes refer to the handles
+    flush_output();
+
+    stream_segment = 0;
+
+    if(stream_file < 0) return;
+
+    for(const auto I : stream_dataset)
+        if(I >= 0) H5Dclose(I);
+    if(stream_group >= 0) H5Gclose(stream_group);
+    H5Fclose(stream_file);
+
+    stream_file = stream_group = -1;
+    stream_dataset.clear();
+    stream_width.clear();
+    stream_size = 0;
+    stream_group_segment = 0;
+
+    // a new file needs attachments again
+    attachment_pending = !attachment.empty();
+#endif
+}
+
+/**
+ * \brief Format the recorded data and queue the writing, files are complete once the output queue is flushed.
+ */
 void Recorder::save() {
-    if(time_pool.empty() || data_pool.empty() || data_pool.cbegin()->empty() || data_pool.cbegin()->cbegin()->empty() || data_pool.cbegin()->cbegin()->cbegin()->is_empty()) return;
+    if(stream_chunk > 0u) {
+        flush_stream();
+        return;
+    }
+
+    if(time_pool.empty()) return;
+
+    auto arranged = arrange(time_pool, data_pool, column_pool);
+    if(std::ranges::all_of(arranged, [](const mat& I) { return I.n_rows < 2; })) return;
 
     ostringstream file_name;
     file_name << 'R' << get_tag() << '-' << to_name(variable_type);
@@ -80,66 +531,58 @@ void Recorder::save() {
 
     unsigned idx = 0;
 
+    std::vector<std::pair<string, mat>> dataset;
+
 #ifdef SUANPAN_HDF5
     if(use_hdf5) {
         file_name << ".h5";
 
-        const auto file_id = H5Fcreate((SUANPAN_OUTPUT / file_name.str()).generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-
-        string group_name = "/";
-        group_name += origin_name;
+        for(auto& data_to_write : arranged) {
+            if(data_to_write.empty()) continue;
 
-        const auto group_id = H5Gcreate(file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            ostringstream dataset_name;
+            dataset_name << origin_name.c_str();
+            dataset_name << object_tag(idx++);
 
-        for(const auto& s_data_pool : data_pool) {
-            if(s_data_pool.empty()) continue;
+            dataset.emplace_back(dataset_name.str(), std::move(data_to_write));
+        }
 
-            auto max_size = 0llu;
-            for(const auto& I : s_data_pool[0]) if(I.n_elem > max_size) max_size = I.n_elem;
+        queue_output([file_path = (get_output_path() / file_name.str()).generic_string(), group_name = '/' + origin_name, dataset = std::move(dataset), t_attachment = attachment] {
+            const auto file_id = H5Fcreate(file_path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
 
-            mat data_to_write(s_data_pool.cbegin()->size() * max_size + 1, time_pool.size(), fill::zeros);
+            const auto group_id = H5Gcreate(file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
-            for(size_t I = 0; I < time_pool.size(); ++I) {
-                data_to_write(0, I) = time_pool[I];
-                unsigned L = 1;
-                for(const auto& J : s_data_pool[I]) for(unsigned K = 0; K < J.n_elem; ++K) data_to_write(L++, I) = J[K];
+            for(const auto& [dataset_name, data_to_write] : dataset) {
+                const hsize_t dimension[2] = {data_to_write.n_cols, data_to_write.n_rows};
+                H5LTmake_dataset(group_id, dataset_name.c_str(), 2, dimension, H5T_NATIVE_DOUBLE, data_to_write.mem);
             }
 
-            hsize_t dimension[2] = {data_to_write.n_cols, data_to_write.n_rows};
-
-            ostringstream dataset_name;
-            dataset_name << origin_name.c_str();
-            dataset_name << object_tag(idx++);
-
-            H5LTmake_dataset(group_id, dataset_name.str().c_str(), 2, dimension, H5T_NATIVE_DOUBLE, data_to_write.mem);
-        }
+            for(const auto& [name, data] : t_attachment) {
+                const hsize_t dimension[1] = {data.n_elem};
+                H5LTmake_dataset(group_id, (group_name.substr(1) + '-' + name).c_str(), 1, dimension, H5T_NATIVE_UINT64, data.memptr());
+            }
 
-        H5Gclose(group_id);
-        H5Fclose(file_id);
+            H5Gclose(group_id);
+            H5Fclose(file_id);
+        });
     }
     else
 #endif
     {
-        for(const auto& s_data_pool : data_pool) {
-            if(s_data_pool.empty()) continue;
-
-            auto max_size = 0llu;
-            for(const auto& I : s_data_pool[0]) if(I.n_elem > max_size) max_size = I.n_elem;
-
-            mat data_to_write(time_pool.size(), s_data_pool.cbegin()->size() * max_size + 1, fill::zeros);
-
-            for(size_t I = 0; I < time_pool.size(); ++I) {
-                data_to_write(I, 0) = time_pool[I];
-                auto L = 1u;
-                for(const auto& J : s_data_pool[I]) for(unsigned K = 0; K < J.n_elem; ++K) data_to_write(I, L++) = J[K];
-            }
+        for(const auto& data_to_write : arranged) {
+            if(data_to_write.empty()) continue;
 
             ostringstream dataset_name;
-            dataset_name << (SUANPAN_OUTPUT / origin_name).generic_string();
+            dataset_name << (get_output_path() / origin_name).generic_string();
             dataset_name << object_tag(idx++);
 
-            data_to_write.save(dataset_name.str() + ".txt", raw_ascii);
+            dataset.emplace_back(dataset_name.str() + ".txt", data_to_write.t());
         }
+
+        queue_output([dataset = std::move(dataset), prefix = (get_output_path() / origin_name).generic_string(), t_attachment = attachment] {
+            for(const auto& [dataset_name, data_to_write] : dataset) data_to_write.save(dataset_name, raw_ascii);
+            for(const auto& [name, data] : t_attachment) data.save(prefix + '-' + name + ".txt", raw_ascii);
+        });
     }
 }
 
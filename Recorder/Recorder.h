@@ -31,6 +31,7 @@
 #include <Recorder/OutputType.h>
 
 class DomainBase;
+class Node;
 
 class Recorder : public Tag {
     uvec object_tag;
@@ -38,15 +39,85 @@ class Recorder : public Tag {
     std::vector<double> time_pool;                        // recorded data
     std::vector<std::vector<std::vector<vec>>> data_pool; // recorded data
 
+    std::vector<vec> column_pool; // samples gathered as one contiguous column each
+    uvec column_offset;           // object I occupies rows [column_offset(I), column_offset(I + 1)) of each column
+
+    OutputType gather_type = OutputType::NL;   // global quantity to gather from
+    uvec gather_source;                        // reordered dofs in the global vector
+    uvec gather_target;                        // positions in the column
+    std::vector<shared_ptr<Node>> gather_node; // nodes whose dofs are resolved
+    uword gather_width = 0;
+
+    std::vector<std::pair<string, uvec>> attachment; // index arrays written once alongside samples
+    bool attachment_pending = false;
+
     const bool record_time;
     const bool use_hdf5;
 
+    fs::path output_path;                     // empty to use the global output folder
+    const DomainBase* output_owner = nullptr; // domain owning the queued output
+
+    unsigned stream_chunk = 0;            // number of samples per write in streaming mode, zero disables streaming
+    unsigned stream_segment = 0;          // group that staged samples are written to
+    uword stream_size = 0;                // number of samples already written to file
+    int64_t stream_file = -1;             // hdf5 file handle
+    int64_t stream_group = -1;            // hdf5 group handle
+    unsigned stream_group_segment = 0;    // segment of the open group
+    std::vector<int64_t> stream_dataset;  // hdf5 dataset handle of each object
+    std::vector<uword> stream_width;      // number of columns of each dataset
+
+    void spill_column();
+    [[nodiscard]] std::vector<mat> arrange(const std::vector<double>&, const std::vector<std::vector<std::vector<vec>>>&, const std::vector<vec>&) const;
+
+    void flush_stream();
+    void write_stream(const fs::path&, const std::vector<mat>&, const uvec&, const std::vector<std::pair<string, uvec>>&, unsigned);
+    void close_stream();
+
 protected:
     const unsigned interval;
     unsigned counter = 0;
 
     bool if_perform_record();
 
+    [[nodiscard]] fs::path get_output_path() const;
+    /**
+     * \brief Hand a writing task over to the output queue on behalf of the owning domain.
+     */
+    void queue_output(std::function<void()>&&) const;
+    /**
+     * \brief Wait until the output of the owning domain is written.
+     */
+    void flush_output() const;
+
+    /**
+     * \brief Resolve the global dofs of the given nodes once so that each sample can be gathered by a single indexed copy.
+     * Only displacement, velocity, acceleration and resistance, as well as their components, can be gathered.
+     * Components of global damping and inertial forces are gathered unless disabled.
+     * \return offsets of nodes in the gathered column, empty if the variable type cannot be gathered
+     */
+    uvec initialize_gather(const shared_ptr<DomainBase>&, const uvec&, bool = true);
+    [[nodiscard]] vec gather(const shared_ptr<DomainBase>&) const;
+
+    /**
+     * \brief Store samples as contiguous columns with the given offsets of objects, an empty layout restores the per object storage.
+     */
+    void set_column_layout(uvec&&);
+    [[nodiscard]] bool if_column() const;
+    void insert(vec&&);
+
+    /**
+     * \brief Attach an index array, such as the pattern of sparse samples, that is written once alongside the samples.
+     */
+    void attach(string&&, uvec&&);
+    [[nodiscard]] const uvec* get_attachment(const string&) const;
+
+    /**
+     * \brief Write staged samples and stream the following ones into a new group of the same file.
+     * Used when samples can no longer be appended to the existing datasets, such as a change of the sparse pattern.
+     * The group of the N-th split is named with the suffix `-N`.
+     */
+    void split_stream();
+
 public:
     Recorder(
         unsigned,   // tag
@@ -60,7 +131,12 @@ public:
     Recorder(Recorder&&) = delete;                 // move forbidden
     Recorder& operator=(const Recorder&) = delete; // assign forbidden
     Recorder& operator=(Recorder&&) = delete;      // assign forbidden
-    ~Recorder() override = default;
+    ~Recorder() override;
+
+    /**
+     * \brief Assign the output folder and the owning domain, called by the domain prior to `initialize()`.
+     */
+    void set_output(const fs::path&, const DomainBase*);
 
     virtual void initialize(const shared_ptr<DomainBase>&);
 
@@ -73,12 +149,30 @@ public:
     [[nodiscard]] bool if_hdf5() const;
     [[nodiscard]] bool if_record_time() const;
 
+    /**
+     * \brief Write samples to file every given number of records instead of keeping all of them in memory.
+     * Only applies to recorders using the hdf5 format, the file is kept open and extended until the recorder is destroyed.
+     */
+    void set_stream(unsigned);
+    [[nodiscard]] bool if_stream() const;
+
+    /**
+     * \brief Check if the next call of `record()` samples the state.
+     * Callers may skip preparing the state if no recorder samples it.
+     */
+    [[nodiscard]] virtual bool if_record_next() const;
+
     void insert(double);
     void insert(const std::vector<vec>&, unsigned);
 
     [[nodiscard]] const std::vector<std::vector<std::vector<vec>>>& get_data_pool() const;
     [[nodiscard]] const std::vector<double>& get_time_pool() const;
 
+    /**
+     * \brief Samples in memory arranged as written to file, one matrix per object with the time stamp in the first row.
+     */
+    [[nodiscard]] std::vector<mat> get_sample() const;
+
     virtual void record(const shared_ptr<DomainBase>&) = 0;
 
     void clear_status();
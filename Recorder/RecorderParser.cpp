@@ -50,6 +50,12 @@ int process_recorder_command(const shared_ptr<DomainBase>& domain, istringstream
         if(!get_input(command, interval)) return SUANPAN_SUCCESS;
     }
 
+    if(is_equal(object_type, "Checkpoint")) {
+        // the file name takes the place of the variable type
+        if(!domain->insert(make_shared<CheckpointRecorder>(tag, variable_type, interval)))
+            suanpan_error("Fail to create new checkpoint recorder.\n");
+        return SUANPAN_SUCCESS;
+    }
     if(is_equal(object_type, "Frame")) {
         if(!domain->insert(make_shared<FrameRecorder>(tag, to_token(variable_type), interval)))
             suanpan_error("Fail to create new frame recorder.\n");
@@ -132,3 +138,28 @@ int create_new_recorder(const shared_ptr<DomainBase>& domain, istringstream& com
 
     return process_recorder_command(domain, command, tag, use_hdf5);
 }
+
+int create_new_stream_recorder(const shared_ptr<DomainBase>& domain, istringstream& command) {
+    unsigned tag;
+    if(!get_input(command, tag)) {
+        suanpan_error("A valid tag is required.\n");
+        return SUANPAN_SUCCESS;
+    }
+
+    unsigned chunk;
+    if(!get_input(command, chunk) || 0u == chunk) {
+        suanpan_error("A valid chunk size is required.\n");
+        return SUANPAN_SUCCESS;
+    }
+
+    if(domain->find_recorder(tag)) {
+        suanpan_error("Recorder {} already exists.\n", tag);
+        return SUANPAN_SUCCESS;
+    }
+
+    process_recorder_command(domain, command, tag, true);
+
+    if(domain->find_recorder(tag)) domain->get_recorder(tag)->set_stream(chunk);
+
+    return SUANPAN_SUCCESS;
+}
@@ -24,5 +24,6 @@ class DomainBase;
 
 int create_new_recorder(const std::shared_ptr<DomainBase>&, std::istringstream&);
 int create_new_recorder(const std::shared_ptr<DomainBase>&, std::istringstream&, bool);
+int create_new_stream_recorder(const std::shared_ptr<DomainBase>&, std::istringstream&);
 
 #endif
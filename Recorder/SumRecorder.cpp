@@ -29,11 +29,25 @@ void SumRecorder::initialize(const shared_ptr<DomainBase>& D) {
             D->disable_recorder(get_tag());
             return;
         }
+
+    // only scalar quantities are summed, global forces are not available to nodes
+    const auto offset = initialize_gather(D, get_object_tag(), false);
+    set_column_layout(!offset.empty() && offset.back() == get_object_tag().n_elem ? uvec{0, 1} : uvec{});
 }
 
 void SumRecorder::record(const shared_ptr<DomainBase>& D) {
     if(!if_perform_record()) return;
 
+    if(if_column()) {
+        if(const auto column = gather(D); !column.empty()) {
+            insert(vec{accu(column)});
+            if(if_record_time()) insert(D->get_factory()->get_current_time());
+            return;
+        }
+        // some nodes are deactivated, samples are taken by looking up nodes until the next initialisation
+        set_column_layout({});
+    }
+
     auto data = 0.;
     for(const auto I : get_object_tag()) {
         const auto& t_node = D->get<Node>(I);
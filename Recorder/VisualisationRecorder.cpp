@@ -18,8 +18,6 @@
 #include "VisualisationRecorder.h"
 #include <Domain/DomainBase.h>
 
-extern fs::path SUANPAN_OUTPUT;
-
 VisualisationRecorder::VisualisationRecorder(const unsigned T, const OutputType L, const unsigned I, const unsigned W, [[maybe_unused]] const double S)
     : Recorder(T, {}, L, I, false, false)
     , width(W) {
@@ -42,7 +40,7 @@ void VisualisationRecorder::record([[maybe_unused]] const shared_ptr<DomainBase>
 
     file_name << 'R' << get_tag() << '-' << to_name(get_variable_type()) << '-' << std::setw(static_cast<int>(width)) << std::setfill('0') << ++total_counter << ".vtk";
 
-    fs::path file_path = SUANPAN_OUTPUT;
+    auto file_path = get_output_path();
 
     file_path.append(file_name.str());
 
@@ -19,11 +19,23 @@
 #include <Domain/DomainBase.h>
 #include <Material/Material.h>
 #include <Recorder/OutputType.h>
+#include <Toolbox/state_archive.h>
 
 Section::Section(const unsigned T, const SectionType ST, const unsigned MT, const double A, vec&& EC)
     : DataSection{MT, ST, EC.head(2), A}
     , Tag(T) {}
 
+Section::Section(const Section& old_obj)
+    : DataSection(old_obj)
+    , Tag(old_obj)
+    , initialized(old_obj.initialized)
+    , symmetric(old_obj.symmetric)
+    , registry(state_registry::enrol(this)) {}
+
+Section::~Section() {
+    if(nullptr != registry) registry->withdraw(this);
+}
+
 SectionType Section::get_section_type() const { return section_type; }
 
 double Section::get_area() const { return area; }
@@ -147,6 +159,11 @@ std::vector<vec> Section::record(const OutputType P) {
     return {};
 }
 
+void Section::archive(state_archive& A) {
+    A(current_deformation, current_deformation_rate, current_resistance, current_stiffness, current_geometry);
+    A(trial_deformation, trial_deformation_rate, trial_resistance, trial_stiffness, trial_geometry);
+}
+
 unique_ptr<Section> suanpan::make_copy(const shared_ptr<Section>& S) { return S->get_copy(); }
 
 unique_ptr<Section> suanpan::make_copy(const unique_ptr<Section>& S) { return S->get_copy(); }
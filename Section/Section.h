@@ -44,6 +44,8 @@ enum class OutputType;
 
 class DomainBase;
 class Material;
+class state_archive;
+class state_registry;
 
 struct DataSection {
     const unsigned material_tag; // material tag
@@ -78,6 +80,10 @@ class Section : protected DataSection, public Tag {
     const bool initialized = false;
     const bool symmetric = false;
 
+    friend class state_registry;
+
+    state_registry* registry = nullptr; // the element owning this copy, if any
+
 public:
     explicit Section(
         unsigned = 0,                  // section tag
@@ -86,12 +92,12 @@ public:
         double = 0.,                   // area
         vec&& = {0., 0.}               // eccentricity
     );
-    Section(const Section&) = default;           // default copy ctor
+    Section(const Section&);
     Section(Section&&) = delete;                 // move forbidden
     Section& operator=(const Section&) = delete; // assign forbidden
     Section& operator=(Section&&) = delete;      // assign forbidden
 
-    ~Section() override = default;
+    ~Section() override;
 
     [[nodiscard]] SectionType get_section_type() const;
     [[nodiscard]] double get_area() const;
@@ -144,6 +150,11 @@ public:
     virtual int reset_status() = 0;
 
     virtual std::vector<vec> record(OutputType);
+
+    /**
+     * \brief Archive the state for checkpoints, materials of the section are archived by the owning element.
+     */
+    virtual void archive(state_archive&);
 };
 
 namespace suanpan {
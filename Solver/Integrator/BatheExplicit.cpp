@@ -104,6 +104,14 @@ void BatheExplicit::clear_status() {
     ExplicitIntegrator::clear_status();
 }
 
+void BatheExplicit::archive(state_archive& A) {
+    // the time step is fixed between two sub-steps
+    auto if_first = FLAG::FIRST == step_flag;
+    A(if_first);
+    step_flag = if_first ? FLAG::FIRST : FLAG::SECOND;
+    set_time_step_switch(if_first);
+}
+
 void BatheExplicit::update_parameter(const double NT) {
     if(suanpan::approx_equal(DT, NT)) return;
 
@@ -116,6 +116,14 @@ void BatheTwoStep::clear_status() {
     ImplicitIntegrator::clear_status();
 }
 
+void BatheTwoStep::archive(state_archive& A) {
+    // the time step is fixed between two sub-steps
+    auto if_first = FLAG::TRAP == step_flag;
+    A(if_first);
+    step_flag = if_first ? FLAG::TRAP : FLAG::EULER;
+    set_time_step_switch(if_first);
+}
+
 vec BatheTwoStep::from_incre_velocity(const vec& incre_velocity, const uvec& encoding) {
     auto& W = get_domain()->get_factory();
 
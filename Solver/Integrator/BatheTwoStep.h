@@ -58,6 +58,8 @@ public:
     void commit_status() override;
     void clear_status() override;
 
+    void archive(state_archive&) override;
+
     void update_parameter(double) override;
 
     vec from_incre_velocity(const vec&, const uvec&) override;
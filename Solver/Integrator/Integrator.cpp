@@ -297,6 +297,8 @@ void Integrator::clear_status() {
 
 void Integrator::reset_status() { database.lock()->reset_status(); }
 
+void Integrator::archive(state_archive&) {}
+
 /**
  * When time step changes, some parameters may need to be updated.
  */
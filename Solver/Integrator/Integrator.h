@@ -42,6 +42,7 @@
 #include <Domain/Tag.h>
 
 class DomainBase;
+class state_archive;
 
 enum class IntegratorType {
     Implicit,
@@ -134,6 +135,11 @@ public:
     virtual void clear_status();
     virtual void reset_status();
 
+    /**
+     * \brief Archive history variables of the algorithm for checkpoints, the state of the domain is archived by the domain.
+     */
+    virtual void archive(state_archive&);
+
     virtual void update_parameter(double);
 
     virtual vec from_incre_velocity(const vec&, const uvec&);     // obtain target displacement from increment of velocity
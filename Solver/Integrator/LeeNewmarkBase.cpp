@@ -136,3 +136,5 @@ void LeeNewmarkBase::reset_status() {
 
     Newmark::reset_status();
 }
+
+void LeeNewmarkBase::archive(state_archive& A) { A(current_internal, trial_internal); }
@@ -83,6 +83,8 @@ public:
     void commit_status() final;
     void clear_status() final;
     void reset_status() final;
+
+    void archive(state_archive&) override;
 };
 
 #endif
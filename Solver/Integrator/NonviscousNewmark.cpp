@@ -79,6 +79,8 @@ void NonviscousNewmark::clear_status() {
     Newmark::clear_status();
 }
 
+void NonviscousNewmark::archive(state_archive& A) { A(current_damping); }
+
 void NonviscousNewmark::print() {
     suanpan_info("A NonviscousNewmark solver.\n");
 }
@@ -57,6 +57,8 @@ public:
     void commit_status() override;
     void clear_status() override;
 
+    void archive(state_archive&) override;
+
     void print() override;
 };
 
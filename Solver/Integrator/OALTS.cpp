@@ -118,6 +118,8 @@ void OALTS::clear_status() {
     ImplicitIntegrator::clear_status();
 }
 
+void OALTS::archive(state_archive& A) { A(if_starting); }
+
 vec OALTS::from_incre_velocity(const vec& incre_velocity, const uvec& encoding) {
     auto& W = get_domain()->get_factory();
 
@@ -53,6 +53,8 @@ public:
     void commit_status() override;
     void clear_status() override;
 
+    void archive(state_archive&) override;
+
     vec from_incre_velocity(const vec&, const uvec&) override;
     vec from_incre_acceleration(const vec&, const uvec&) override;
     vec from_total_velocity(const vec&, const uvec&) override;
@@ -0,0 +1,319 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "JFNK.h"
+#include <Constraint/Constraint.h>
+#include <Constraint/ParticleCollision.h>
+#include <Converger/Converger.h>
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Domain/MetaMat/IterativeSolver.hpp>
+#include <Element/Element.h>
+#include <Solver/Integrator/Integrator.h>
+
+/**
+ * \brief The linearised operator of the current trial state.
+ * Restrained DoFs are decoupled and mapped to themselves, which is equivalent to unifying the global matrix.
+ */
+class JFNK::Jacobian {
+    const shared_ptr<DomainBase> D;
+    const shared_ptr<Integrator> G;
+    const bool finite_difference;
+
+    vec free_dof, fixed_dof;
+
+    vec base_resistance, base_displacement, base_velocity, base_acceleration;
+
+    template<typename F> void for_each_element(F&& func) const {
+        if(const auto& color_map = D->get_color_map(); color_map.empty()) for(const auto& I : D->get_element_pool()) func(I);
+        else std::ranges::for_each(color_map, [&](const std::vector<unsigned>& color) { suanpan::for_all(color, [&](const unsigned tag) { func(D->get_element(tag)); }); });
+    }
+
+    [[nodiscard]] vec element_product(const vec&) const;
+    [[nodiscard]] vec difference_product(const vec&) const;
+
+public:
+    Jacobian(shared_ptr<DomainBase>, shared_ptr<Integrator>, bool, vec&&);
+
+    [[nodiscard]] vec evaluate(const vec&) const;
+
+    [[nodiscard]] vec diag() const;
+
+    void restore() const;
+};
+
+JFNK::Jacobian::Jacobian(shared_ptr<DomainBase> DB, shared_ptr<Integrator> IG, const bool FD, vec&& R)
+    : D(std::move(DB))
+    , G(std::move(IG))
+    , finite_difference(FD)
+    , base_resistance(std::move(R)) {
+    auto& W = D->get_factory();
+
+    free_dof.ones(W->get_size());
+    for(const auto I : D->get_restrained_dof()) free_dof(I) = 0.;
+    fixed_dof = 1. - free_dof;
+
+    if(!finite_difference) return;
+
+    base_displacement = W->get_trial_displacement();
+    if(AnalysisType::DYNAMICS != W->get_analysis_type()) return;
+    base_velocity = W->get_trial_velocity();
+    base_acceleration = W->get_trial_acceleration();
+}
+
+/**
+ * \brief \f$\sum{}K_ev_e\f$, elements of the same colour are processed concurrently
+ */
+vec JFNK::Jacobian::element_product(const vec& v) const {
+    const auto nlgeom = D->get_factory()->is_nlgeom();
+
+    vec product(v.n_elem, fill::zeros);
+
+    for_each_element([&](const shared_ptr<Element>& t_element) {
+        const auto& t_encoding = t_element->get_dof_encoding();
+        const vec t_v = v(t_encoding);
+        if(const auto& t_stiffness = t_element->get_trial_stiffness(); !t_stiffness.empty()) product(t_encoding) += t_stiffness * t_v;
+        if(!nlgeom || !t_element->is_nlgeom()) return;
+        if(const auto& t_geometry = t_element->get_trial_geometry(); !t_geometry.empty()) product(t_encoding) += t_geometry * t_v;
+    });
+
+    return product;
+}
+
+/**
+ * \brief \f$\left(R(u+\epsilon{}v)-R(u)\right)/\epsilon\f$, the trial status is updated via the integrator so that
+ * velocity and acceleration are consistent with the perturbed displacement
+ */
+vec JFNK::Jacobian::difference_product(const vec& v) const {
+    const auto norm_v = norm(v);
+    if(suanpan::approx_equal(norm_v, 0.)) return vec(v.n_elem, fill::zeros);
+
+    const auto epsilon = std::sqrt(datum::eps) * (1. + norm(base_displacement)) / norm_v;
+
+    auto& W = D->get_factory();
+
+    W->update_trial_displacement(base_displacement + epsilon * v);
+
+    // a failed perturbation is propagated as non-finite values
+    if(SUANPAN_SUCCESS != G->update_trial_status()) return vec(v.n_elem, fill::value(datum::nan));
+
+    G->assemble_resistance();
+
+    return (W->get_sushi() - base_resistance) / epsilon;
+}
+
+vec JFNK::Jacobian::evaluate(const vec& v) const {
+    const vec t_v = v % free_dof;
+
+    vec product = finite_difference ? difference_product(t_v) : element_product(t_v);
+
+    // constraints with stiffness are not assembled as there is no global container
+    for(const auto& I : D->get_constraint_pool())
+        if(I->is_initialized() && !I->get_stiffness().empty()) {
+            const auto& t_encoding = I->get_dof_encoding();
+            product(t_encoding) += I->get_stiffness() * t_v(t_encoding);
+        }
+
+    return product % free_dof + v % fixed_dof;
+}
+
+vec JFNK::Jacobian::diag() const {
+    const auto nlgeom = D->get_factory()->is_nlgeom();
+
+    vec t_diag(free_dof.n_elem, fill::zeros);
+
+    for_each_element([&](const shared_ptr<Element>& t_element) {
+        const auto& t_encoding = t_element->get_dof_encoding();
+        if(const auto& t_stiffness = t_element->get_trial_stiffness(); !t_stiffness.empty()) t_diag(t_encoding) += t_stiffness.diag();
+        if(!nlgeom || !t_element->is_nlgeom()) return;
+        if(const auto& t_geometry = t_element->get_trial_geometry(); !t_geometry.empty()) t_diag(t_encoding) += t_geometry.diag();
+    });
+
+    for(const auto& I : D->get_constraint_pool())
+        if(I->is_initialized() && !I->get_stiffness().empty()) t_diag(I->get_dof_encoding()) += vec(I->get_stiffness().diag());
+
+    t_diag = t_diag % free_dof + fixed_dof;
+
+    return t_diag.transform([](const double x) { return std::fabs(x) > datum::eps ? x : 1.; });
+}
+
+/**
+ * \brief Bring nodes and elements back to the unperturbed trial status.
+ * The domain is updated directly as the integrator skips the update if there is no displacement increment.
+ */
+void JFNK::Jacobian::restore() const {
+    if(!finite_difference) return;
+
+    auto& W = D->get_factory();
+
+    W->update_trial_displacement(base_displacement);
+    if(!base_velocity.empty()) W->update_trial_velocity(base_velocity);
+    if(!base_acceleration.empty()) W->update_trial_acceleration(base_acceleration);
+
+    D->update_trial_status();
+}
+
+JFNK::JFNK(const unsigned T, const bool FD, const bool P)
+    : Solver(T)
+    , finite_difference(FD)
+    , use_preconditioner(P) {}
+
+int JFNK::initialize() {
+    if(SUANPAN_SUCCESS != Solver::initialize()) return SUANPAN_FAIL;
+
+    const auto D = get_integrator()->get_domain();
+
+    if(!D->get_factory()->is_matrix_free()) {
+        suanpan_error("The global stiffness shall not be allocated.\n");
+        return SUANPAN_FAIL;
+    }
+
+    // the following constraints write into the global stiffness directly
+    if(std::ranges::any_of(D->get_constraint_pool(), [](const shared_ptr<Constraint>& I) { return nullptr != std::dynamic_pointer_cast<ParticleCollision>(I); })) {
+        suanpan_error("Particle collision is not supported.\n");
+        return SUANPAN_FAIL;
+    }
+
+    return SUANPAN_SUCCESS;
+}
+
+int JFNK::analyze() {
+    auto& C = get_converger();
+    auto& G = get_integrator();
+    const auto D = G->get_domain();
+    auto& W = D->get_factory();
+
+    suanpan_highlight(">> Current Analysis Time: {:.5f}.\n", W->get_trial_time());
+
+    const auto max_iteration = C->get_max_iteration();
+
+    // element products do not account for mass and damping
+    const auto difference = finite_difference || AnalysisType::DYNAMICS == W->get_analysis_type();
+
+    const auto linear_system = D->get_attribute(ModalAttribute::LinearSystem);
+
+    // iteration counter
+    auto counter = 0u;
+
+    vec samurai;
+
+    auto eta = eta_initial, pre_norm = 0.;
+
+    wall_clock t_clock;
+
+    while(true) {
+        set_step_amplifier(sqrt(max_iteration / (counter + 1.)));
+
+        // update for nodes and elements
+        t_clock.tic();
+        if(SUANPAN_SUCCESS != G->update_trial_status()) return SUANPAN_FAIL;
+        // process modifiers
+        if(SUANPAN_SUCCESS != G->process_modifier()) return SUANPAN_FAIL;
+        D->update<Statistics::UpdateStatus>(t_clock.toc());
+        // assemble resistance
+        t_clock.tic();
+        G->assemble_resistance();
+        D->update<Statistics::AssembleVector>(t_clock.toc());
+
+        vec element_resistance = difference ? W->get_sushi() : vec();
+
+        // there is no global stiffness, constraints only contribute to resistance and their own stiffness
+        t_clock.tic();
+        if(SUANPAN_SUCCESS != G->process_load()) return SUANPAN_FAIL;
+        if(SUANPAN_SUCCESS != G->process_constraint()) return SUANPAN_FAIL;
+        D->update<Statistics::ProcessConstraint>(t_clock.toc());
+
+        if(0 != W->get_mpc()) {
+            suanpan_error("Constraints implemented via multipliers are not supported.\n");
+            return SUANPAN_FAIL;
+        }
+
+        // call solver
+        t_clock.tic();
+
+        const auto residual = G->get_force_residual();
+
+        // forcing term, Eisenstat and Walker, choice 2
+        auto setting = W->get_solver_setting();
+        if(const auto residual_norm = norm(residual); linear_system) eta = setting.tolerance;
+        else {
+            if(counter > 0 && pre_norm > 0.) {
+                const auto safeguard = eta_gamma * eta * eta;
+                eta = eta_gamma * std::pow(residual_norm / pre_norm, 2.);
+                if(safeguard > .1) eta = std::max(eta, safeguard);
+                eta = std::clamp(eta, setting.tolerance, eta_max);
+            }
+            pre_norm = residual_norm;
+        }
+
+        const auto sushi = W->get_sushi();
+
+        const Jacobian jacobian(D, G, difference, std::move(element_resistance));
+
+        unique_ptr<Preconditioner<double>> preconditioner;
+        if(use_preconditioner) preconditioner = std::make_unique<Jacobi<double>>(jacobian.diag());
+        else preconditioner = std::make_unique<UnityPreconditioner<double>>();
+
+        setting.tolerance = eta;
+        setting.preconditioner = preconditioner.get();
+
+        samurai.reset();
+        const auto code = GMRES(&jacobian, samurai, residual, setting);
+
+        jacobian.restore();
+        W->set_sushi(sushi);
+
+        if(SUANPAN_SUCCESS != code) {
+            suanpan_warning("GMRES fails to converge, the relative residual {:.5E} is larger than the forcing term {:.5E}.\n", setting.tolerance, eta);
+            return SUANPAN_FAIL;
+        }
+
+        if(!samurai.is_finite()) {
+            suanpan_error("Non-finite number detected.\n");
+            return SUANPAN_FAIL;
+        }
+
+        D->update<Statistics::SolveSystem>(t_clock.toc());
+
+        // avoid machine error accumulation
+        G->erase_machine_error(samurai);
+
+        // exit if converged
+        // call corrector if it exists
+        if(C->is_converged(counter)) return G->sync_status(true);
+        // exit if maximum iteration is hit
+        if(++counter > max_iteration) return SUANPAN_FAIL;
+
+        // update internal variable
+        G->update_internal(samurai);
+        // update trial status for factory
+        G->update_from_ninja();
+        // for tracking
+        G->update_load();
+        // for tracking
+        G->update_constraint();
+
+        // fast handling for linear elastic case
+        // sync status using newly computed increment across elements and nodes
+        // this may just call predictor or call corrector
+        if(linear_system) return G->sync_status(false);
+    }
+}
+
+void JFNK::print() {
+    suanpan_info("A Jacobian-free Newton-Krylov solver using {} products{}", finite_difference ? "finite difference" : "element-wise", use_preconditioner ? " and element diagonal preconditioner.\n" : ".\n");
+}
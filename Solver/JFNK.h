@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class JFNK
+ * @brief The JFNK class defines a Jacobian-free Newton--Krylov solver.
+ *
+ * The global effective stiffness is never assembled. Each Newton correction
+ * is computed by restarted GMRES, in which the product \f$Kv\f$ is evaluated
+ * either element by element as \f$\sum{}K_ev_e\f$ or by finite differencing
+ * the global resistance,
+ *
+ * \f{gather}{
+ * Kv\approx\dfrac{R(u+\epsilon{}v)-R(u)}{\epsilon}.
+ * \f}
+ *
+ * The element-wise product only applies to static analysis, dynamic analysis
+ * always uses finite differencing so that inertial and damping forces are
+ * accounted for by the integrator. The global stiffness is not allocated,
+ * contributions of constraints, if any, are evaluated from the stiffness
+ * held by each constraint.
+ *
+ * The forcing term of the inexact Newton iteration follows the second choice
+ * of Eisenstat and Walker. The restart and the maximum iteration of GMRES are
+ * taken from the solver setting of the current step.
+ *
+ * Constraints implemented via Lagrange multipliers, constraints that write
+ * into the global stiffness directly, explicit integrators and damping
+ * models built from global matrices are not supported. The linear solve fails if GMRES does not reach
+ * the forcing term within the maximum iteration.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file JFNK.h
+ * @addtogroup Solver
+ * @{
+ */
+
+#ifndef JFNK_H
+#define JFNK_H
+
+#include <Solver/Solver.h>
+
+class JFNK final : public Solver {
+    class Jacobian;
+
+    static constexpr double eta_initial = .5;
+    static constexpr double eta_max = .9;
+    static constexpr double eta_gamma = .9;
+
+    const bool finite_difference;
+    const bool use_preconditioner;
+
+public:
+    explicit JFNK(unsigned = 0, bool = false, bool = true);
+
+    int initialize() override;
+
+    int analyze() override;
+
+    void print() override;
+};
+
+#endif
+
+//! @}
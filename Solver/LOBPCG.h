@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class LOBPCG
+ * @brief A LOBPCG class defines a solver using locally optimal block preconditioned conjugate gradient method.
+ *
+ * All wanted eigenvectors are iterated as a block so that products and
+ * triangular solves are performed with multiple right hand sides. The
+ * stiffness is factorised only once and the factorisation is reused as the
+ * preconditioner throughout the iteration.
+ *
+ * Only the smallest eigenvalues can be computed.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file LOBPCG.h
+ * @addtogroup Solver
+ * @{
+ */
+
+#ifndef LOBPCG_H
+#define LOBPCG_H
+
+#include <Solver/Solver.h>
+
+class LOBPCG final : public Solver {
+    const unsigned eigen_num;
+    const double tolerance;
+    const unsigned max_iteration;
+
+public:
+    explicit LOBPCG(
+        unsigned = 0,  // unique solver tag
+        unsigned = 1,  // number of eigenvalues
+        double = 1E-8, // tolerance
+        unsigned = 200 // maximum iteration
+    );
+
+    int initialize() override;
+
+    int analyze() override;
+
+    void print() override;
+};
+
+#endif
+
+//! @}
@@ -21,6 +21,8 @@
 #include <Step/Step.h>
 #include <Toolbox/utility.h>
 
+extern int SUANPAN_NUM_THREADS;
+
 int create_new_integrator(const shared_ptr<DomainBase>& domain, istringstream& command) {
     string integrator_type;
     if(!get_input(command, integrator_type)) {
@@ -476,8 +478,71 @@ int create_new_solver(const shared_ptr<DomainBase>& domain, istringstream& comma
 
         if(domain->insert(make_shared<FEAST>(tag, eigen_number, centre, radius, is_equal(solver_type, "QuadraticFEAST")))) code = 1;
     }
+    else if(is_equal(solver_type, "LOBPCG")) {
+        unsigned eigen_number;
+        if(!get_input(command, eigen_number)) {
+            suanpan_error("A valid number of frequencies is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        auto tolerance = 1E-8;
+        if(!command.eof() && !get_input(command, tolerance)) {
+            suanpan_error("A valid tolerance is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        auto max_iteration = 200u;
+        if(!command.eof() && !get_input(command, max_iteration)) {
+            suanpan_error("A valid maximum iteration is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        if(domain->insert(make_shared<LOBPCG>(tag, eigen_number, tolerance, max_iteration))) code = 1;
+    }
+    else if(is_equal(solver_type, "SpectrumSlicing") || is_equal(solver_type, "Slicing")) {
+        double lower_bound, upper_bound;
+        if(!get_input(command, lower_bound, upper_bound)) {
+            suanpan_error("A valid interval is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        auto slice_num = static_cast<unsigned>(std::max(1, SUANPAN_NUM_THREADS));
+        if(!command.eof() && !get_input(command, slice_num)) {
+            suanpan_error("A valid number of slices is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        auto tolerance = 1E-8;
+        if(!command.eof() && !get_input(command, tolerance)) {
+            suanpan_error("A valid tolerance is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        auto max_iteration = 200u;
+        if(!command.eof() && !get_input(command, max_iteration)) {
+            suanpan_error("A valid maximum iteration is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        if(domain->insert(make_shared<SpectrumSlicing>(tag, lower_bound, upper_bound, slice_num, tolerance, max_iteration))) code = 1;
+    }
     else if(is_equal(solver_type, "DisplacementControl") || is_equal(solver_type, "MPDC")) { if(domain->insert(make_shared<MPDC>(tag))) code = 1; }
     else if(is_equal(solver_type, "Ramm")) { if(domain->insert(make_shared<Ramm>(tag))) code = 1; }
+    else if(is_equal(solver_type, "JFNK")) {
+        string difference_flag = "false";
+        if(!command.eof() && !get_input(command, difference_flag)) {
+            suanpan_error("A valid finite difference flag is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        string preconditioner_flag = "true";
+        if(!command.eof() && !get_input(command, preconditioner_flag)) {
+            suanpan_error("A valid preconditioner flag is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+
+        if(domain->insert(make_shared<JFNK>(tag, is_true(difference_flag), is_true(preconditioner_flag)))) code = 1;
+    }
     else
         suanpan_error("Cannot identify the solver type.\n");
 
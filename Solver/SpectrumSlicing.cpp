@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "SpectrumSlicing.h"
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Solver/Integrator/Integrator.h>
+
+/**
+ * \brief Shift-invert subspace iteration that finds all eigenpairs in \f$[a,b)\f$, the shift is placed at the midpoint.
+ * As the number of eigenvalues in the slice is known, no eigenvalue would be missed.
+ */
+static int slice_solve(vec& eigval, mat& eigvec, const shared_ptr<MetaMat<double>>& K, const shared_ptr<MetaMat<double>>& M, const double a, const double b, const uword num, const double tolerance, const unsigned max_iteration) {
+    const auto n = K->n_rows;
+    const auto sigma = .5 * (a + b);
+
+    const unique_ptr<MetaMat<double>> shifted = K->make_copy();
+    shifted->scale_accu(-sigma, M);
+
+    // guard vectors accelerate the convergence of eigenvalues close to the boundaries
+    const auto p = std::min(n, num + std::max(num, 10llu));
+
+    mat X(n, p, fill::randn);
+    mat MX = M->operator*(X);
+
+    for(auto counter = 1u; counter <= max_iteration; ++counter) {
+        // all vectors are solved at once with a single factorisation
+        mat Y;
+        if(SUANPAN_SUCCESS != shifted->solve(Y, MX)) return SUANPAN_FAIL;
+
+        const mat MY = M->operator*(Y);
+
+        // M-orthonormalise the basis, columns are scaled first as they differ by orders of magnitude
+        mat gram = Y.t() * MY;
+        vec scale = gram.diag();
+        scale.transform([](const double x) { return x > 0. ? 1. / std::sqrt(x) : 0.; });
+        gram.each_col() %= scale;
+        gram.each_row() %= scale.t();
+
+        vec theta;
+        mat V;
+        if(!eig_sym(theta, V, .5 * (gram + gram.t()))) return SUANPAN_FAIL;
+
+        const uvec keep = find(theta > 1E-12 * theta.max());
+        mat Z = V.cols(keep);
+        Z.each_col() %= scale;
+        Z.each_row() /= sqrt(theta(keep)).t();
+
+        // (K-\sigma{}M)Y=MX so that the projected shifted stiffness needs no product
+        const mat H = Z.t() * (Y.t() * MX) * Z;
+
+        vec mu;
+        mat C;
+        if(!eig_sym(mu, C, .5 * (H + H.t()))) return SUANPAN_FAIL;
+
+        Z *= C;
+        X = Y * Z;
+        MX = MY * Z;
+
+        const vec lambda = mu + sigma;
+
+        const uvec active = find(lambda >= a && lambda < b);
+
+        suanpan_debug("Slice [{:.3E}, {:.3E}) iteration {}, {} of {} eigenvalues found.\n", a, b, counter, active.n_elem, num);
+
+        if(active.n_elem != num) continue;
+
+        const mat KX = K->operator*(X.cols(active));
+        const mat t_MX = MX.cols(active);
+        const rowvec t_lambda = lambda(active).t();
+
+        const rowvec residual = sqrt(sum(square(KX - t_MX.each_row() % t_lambda)));
+        const rowvec reference = sqrt(sum(square(KX))) + abs(t_lambda) % sqrt(sum(square(t_MX)));
+
+        if(any(residual > tolerance * reference)) continue;
+
+        eigval = lambda(active);
+        eigvec = X.cols(active);
+
+        return SUANPAN_SUCCESS;
+    }
+
+    suanpan_error("Slice [{:.3E}, {:.3E}) fails to converge within {} iterations.\n", a, b, max_iteration);
+    return SUANPAN_FAIL;
+}
+
+SpectrumSlicing::SpectrumSlicing(const unsigned T, const double LB, const double UB, const unsigned N, const double TL, const unsigned MI)
+    : Solver(T)
+    , lower_bound(std::min(LB, UB))
+    , upper_bound(std::max(LB, UB))
+    , slice_num(std::max(1u, N))
+    , tolerance(TL)
+    , max_iteration(MI) {}
+
+int SpectrumSlicing::initialize() {
+    if(get_integrator() == nullptr) {
+        suanpan_error("A valid integrator is required.\n");
+        return SUANPAN_FAIL;
+    }
+
+    return SUANPAN_SUCCESS;
+}
+
+int SpectrumSlicing::analyze() {
+    auto& G = get_integrator();
+    const auto D = G->get_domain();
+    auto& W = D->get_factory();
+
+    if(SUANPAN_SUCCESS != G->process_modifier()) return SUANPAN_FAIL;
+
+    D->assemble_trial_mass();
+    D->assemble_trial_stiffness();
+
+    if(SUANPAN_SUCCESS != G->process_constraint()) return SUANPAN_FAIL;
+
+    const auto& t_stiffness = W->get_stiffness();
+    const shared_ptr t_mass = W->get_mass()->make_copy();
+    const auto factor = 1E-12 * t_mass->max();
+    for(auto I = 0llu; I < t_mass->n_rows; ++I) t_mass->at(I, I) += factor;
+
+    // products are performed concurrently, condense beforehand
+    t_stiffness->csc_condense();
+    t_mass->csc_condense();
+
+    vec shift = linspace(lower_bound, upper_bound, slice_num + 1llu);
+
+    // number of eigenvalues less than each shift
+    uvec negative_num(shift.n_elem, fill::zeros);
+    std::vector<std::string> message(shift.n_elem);
+
+    // a shift that coincides with an eigenvalue or leads to a zero pivot is perturbed slightly
+    const auto perturbation = 1E-6 * (upper_bound - lower_bound) / slice_num;
+
+    suanpan::for_each(shift.n_elem, [&](const uword I) {
+        for(auto attempt = 0; attempt < 3; ++attempt) {
+            try {
+                const auto t_shifted = t_stiffness->make_copy();
+                t_shifted->scale_accu(-shift(I), t_mass);
+                negative_num(I) = t_shifted->inertia();
+                message[I].clear();
+                return;
+            }
+            catch(const std::exception& e) {
+                message[I] = e.what();
+                shift(I) += perturbation;
+            }
+        }
+    });
+
+    if(const auto failed = std::ranges::find_if(message, [](const std::string& m) { return !m.empty(); }); failed != message.end()) {
+        suanpan_error("Fail to count eigenvalues: {}.\n", *failed);
+        return SUANPAN_FAIL;
+    }
+
+    const uvec eigen_num = diff(negative_num);
+
+    suanpan_debug("{} eigenvalues found in [{:.5E}, {:.5E}).\n", accu(eigen_num), lower_bound, upper_bound);
+
+    std::vector<vec> t_eigval(slice_num);
+    std::vector<mat> t_eigvec(slice_num);
+
+    std::atomic_int code = 0;
+
+    // each slice owns its shifted factorisation
+    suanpan::for_each(static_cast<uword>(slice_num), [&](const uword I) {
+        if(0 == eigen_num(I)) return;
+        try { code += slice_solve(t_eigval[I], t_eigvec[I], t_stiffness, t_mass, shift(I), shift(I + 1), eigen_num(I), tolerance, max_iteration); }
+        catch(const std::exception&) { code += SUANPAN_FAIL; }
+    });
+
+    if(SUANPAN_SUCCESS != code) return SUANPAN_FAIL;
+
+    auto& eigval = W->modify_eigenvalue();
+    auto& eigvec = W->modify_eigenvector();
+
+    eigval.reset();
+    eigvec.reset();
+
+    // slices are in ascending order
+    for(auto I = 0u; I < slice_num; ++I) {
+        if(0 == eigen_num(I)) continue;
+        eigval = join_cols(eigval, t_eigval[I]);
+        eigvec = join_rows(eigvec, t_eigvec[I]);
+    }
+
+    if(eigval.empty())
+        suanpan_warning("No eigenvalue is found in the given interval.\n");
+
+    return SUANPAN_SUCCESS;
+}
+
+void SpectrumSlicing::print() {
+    suanpan_info("A spectrum slicing solver using {} slices in [{:.3E}, {:.3E}).\n", slice_num, lower_bound, upper_bound);
+}
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class SpectrumSlicing
+ * @brief A SpectrumSlicing class defines a solver that computes all eigenvalues in a given interval.
+ *
+ * The interval \f$[a,b)\f$ is split into a number of slices. The number of
+ * eigenvalues in each slice is counted by Sylvester's law of inertia, that is,
+ * the number of eigenvalues less than \f$\sigma\f$ equals the number of negative
+ * pivots in the \f$LDL^T\f$ factorisation of \f$K-\sigma{}M\f$.
+ *
+ * Each slice owns a factorisation of the system shifted to its midpoint, the
+ * eigenpairs are then computed via shift-invert subspace iteration. Slices are
+ * processed concurrently.
+ *
+ * The storage of the stiffness matrix must support the inertia, which includes
+ * full storage, sparse storage with SuperLU and symmetric sparse storage with
+ * MUMPS.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file SpectrumSlicing.h
+ * @addtogroup Solver
+ * @{
+ */
+
+#ifndef SPECTRUMSLICING_H
+#define SPECTRUMSLICING_H
+
+#include <Solver/Solver.h>
+
+class SpectrumSlicing final : public Solver {
+    const double lower_bound, upper_bound;
+    const unsigned slice_num;
+    const double tolerance;
+    const unsigned max_iteration;
+
+public:
+    SpectrumSlicing(
+        unsigned, // unique solver tag
+        double,   // lower bound
+        double,   // upper bound
+        unsigned, // number of slices
+        double,   // tolerance
+        unsigned  // maximum iteration
+    );
+
+    int initialize() override;
+
+    int analyze() override;
+
+    void print() override;
+};
+
+#endif
+
+//! @}
@@ -52,6 +52,11 @@ const shared_ptr<DomainBase>& Bead::get_domain(const unsigned T) const { return
 
 const shared_ptr<DomainBase>& Bead::get_current_domain() const { return domain_pool.at(current_domain_tag); }
 
+void Bead::share_topology(const shared_ptr<Bead>& B) {
+    for(const auto& [d_tag, t_domain] : domain_pool)
+        if(B->domain_pool.find(d_tag)) t_domain->share_topology(B->domain_pool.at(d_tag));
+}
+
 int Bead::precheck() {
     for(const auto& [d_tag, t_domain] : domain_pool)
         if(t_domain->is_active())
@@ -72,15 +77,24 @@ int Bead::analyze() {
         if(!t_domain->is_active()) continue;
         bool initial_record = true;
         for(const auto& [s_tag, t_step] : t_domain->get_step_pool()) {
+            // steps completed before the checkpoint are skipped
+            if(t_domain->is_restoring() && t_step->get_tag() < t_domain->get_restore_step_tag()) continue;
             t_domain->set_current_step_tag(t_step->get_tag());
             t_step->set_domain(t_domain);
             if(SUANPAN_FAIL == t_step->Step::initialize()) return SUANPAN_FAIL;
             if(SUANPAN_FAIL == t_step->initialize()) return SUANPAN_FAIL;
+            if(t_domain->is_restoring()) {
+                if(SUANPAN_SUCCESS != t_domain->apply_restore()) return SUANPAN_FAIL;
+                initial_record = false;
+            }
             if(initial_record) {
                 initial_record = false;
                 t_domain->record();
             }
-            if(SUANPAN_FAIL == t_step->analyze()) return SUANPAN_FAIL;
+            const auto code = t_step->analyze();
+            // output of the step is complete before the model is altered in the next step
+            t_domain->wait();
+            if(SUANPAN_FAIL == code) return SUANPAN_FAIL;
         }
     }
 
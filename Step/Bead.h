@@ -52,6 +52,11 @@ public:
     friend shared_ptr<DomainBase>& get_domain(const shared_ptr<Bead>&, unsigned);
     friend shared_ptr<DomainBase>& get_current_domain(const shared_ptr<Bead>&);
 
+    /**
+     * \brief Let each domain adopt the preparation of the domain with the same tag in another bead that holds the identical model.
+     */
+    void share_topology(const shared_ptr<Bead>&);
+
     int precheck();
 
     int analyze();
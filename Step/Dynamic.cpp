@@ -22,10 +22,12 @@
 #include <Load/GroupNodalDisplacement.h>
 #include <Solver/BFGS.h>
 #include <Solver/Integrator/LeeNewmarkBase.h>
+#include <Solver/JFNK.h>
 #include <Solver/MPDC.h>
 #include <Solver/Newton.h>
 #include <Solver/Ramm.h>
 #include <Solver/Integrator/Tchamwa.h>
+#include <Solver/Integrator/WilsonPenzienNewmark.h>
 
 Dynamic::Dynamic(const unsigned T, const double P, const IntegratorType AT)
     : Step(T, P)
@@ -34,6 +36,12 @@ Dynamic::Dynamic(const unsigned T, const double P, const IntegratorType AT)
 int Dynamic::initialize() {
     configure_storage_scheme();
 
+    // explicit integrators only solve with the mass matrix, which can be kept as a lumped diagonal
+    factory->set_lumped_mass(lumped_mat && IntegratorType::Explicit == analysis_type);
+
+    // the global stiffness is not allocated for matrix-free solvers
+    factory->set_matrix_free(nullptr != std::dynamic_pointer_cast<JFNK>(solver));
+
     factory->set_analysis_type(AnalysisType::DYNAMICS);
 
     const auto t_domain = database.lock();
@@ -80,6 +88,12 @@ int Dynamic::initialize() {
         return SUANPAN_FAIL;
     }
 
+    // damping models of the following integrators are built from global matrices
+    if(std::dynamic_pointer_cast<JFNK>(solver) && (IntegratorType::Implicit != modifier->type() || std::dynamic_pointer_cast<LeeNewmarkBase>(modifier) || std::dynamic_pointer_cast<WilsonPenzienNewmark>(modifier))) {
+        suanpan_error("JFNK solver supports neither explicit integrators nor damping models using global matrices.\n");
+        return SUANPAN_FAIL;
+    }
+
     solver->set_converger(tester);
     solver->set_integrator(modifier);
 
@@ -95,8 +109,8 @@ int Dynamic::analyze() {
     auto& G = get_integrator();
     auto& W = get_factory();
 
-    auto remain_time = get_time_period();
-    auto step_time = get_ini_step_size();
+    auto remain_time = get_time_left();
+    auto step_time = std::min(get_ini_step_size(), remain_time);
 
     unsigned num_increment = 0, num_converged_step = 0;
 
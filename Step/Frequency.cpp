@@ -19,6 +19,7 @@
 #include <Domain/DomainBase.h>
 #include <Domain/Factory.hpp>
 #include <Solver/Arnoldi.h>
+#include <Solver/LOBPCG.h>
 #include <Solver/Integrator/Integrator.h>
 
 Frequency::Frequency(const unsigned T, const unsigned N, const char TP)
@@ -38,7 +39,11 @@ int Frequency::initialize() {
     modifier->set_domain(t_domain);
 
     // solver
-    if(nullptr == solver) solver = make_shared<Arnoldi>(0, eigen_number, eigen_type);
+    if(nullptr == solver) {
+        // block solver batches solves over all wanted eigenvectors
+        if('B' == eigen_type) solver = make_shared<LOBPCG>(0, eigen_number);
+        else solver = make_shared<Arnoldi>(0, eigen_number, eigen_type);
+    }
     solver->set_integrator(modifier);
 
     if(SUANPAN_SUCCESS != modifier->initialize()) return SUANPAN_FAIL;
@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "Harmonic.h"
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Domain/Node.h>
+#include <Load/Load.h>
+#include <Solver/Integrator/Integrator.h>
+
+extern int SUANPAN_NUM_THREADS;
+
+Harmonic::Harmonic(const unsigned T, vec&& F)
+    : Step(T, 0.)
+    , frequency(std::move(F)) {}
+
+int Harmonic::initialize() {
+    configure_storage_scheme();
+
+    // triplets of global matrices are required to form the real equivalent system
+    if(!factory->is_sparse()) factory->set_storage_scheme(StorageScheme::SPARSE);
+
+    factory->set_analysis_type(AnalysisType::DYNAMICS);
+
+    const auto t_domain = database.lock();
+
+    if(SUANPAN_SUCCESS != t_domain->restart()) return SUANPAN_FAIL;
+
+    // integrator
+    modifier = make_shared<Integrator>();
+    modifier->set_domain(t_domain);
+
+    return modifier->initialize();
+}
+
+int Harmonic::analyze() {
+    auto& G = get_integrator();
+    auto& W = get_factory();
+    const auto D = G->get_domain();
+
+    if(SUANPAN_SUCCESS != G->process_modifier()) return SUANPAN_FAIL;
+
+    D->assemble_trial_mass();
+    D->assemble_trial_damping();
+    D->assemble_trial_stiffness();
+
+    if(SUANPAN_SUCCESS != G->process_constraint()) return SUANPAN_FAIL;
+
+    if(0 != W->get_mpc()) {
+        suanpan_error("Constraints implemented via multipliers are not supported.\n");
+        return SUANPAN_FAIL;
+    }
+
+    if(W->is_nonviscous()) suanpan_warning("Nonviscous damping is ignored in harmonic analysis.\n");
+
+    const auto n_size = static_cast<uword>(W->get_size());
+
+    vec load(2llu * n_size, fill::zeros);
+    for(const auto& I : D->get_load_pool()) {
+        if(!I->validate_step(D)) continue;
+        const auto t_pattern = I->get_spatial_pattern(D);
+        if(t_pattern.is_empty()) {
+            suanpan_error("Load {} cannot be decomposed into a spatial pattern and a time history.\n", I->get_tag());
+            return SUANPAN_FAIL;
+        }
+        load.head(n_size) += t_pattern;
+    }
+
+    if(nullptr == W->get_stiffness() || nullptr == W->get_mass()) {
+        suanpan_error("Global stiffness and mass are required.\n");
+        return SUANPAN_FAIL;
+    }
+
+    // frequency independent parts of the real equivalent system
+    triplet_form<double, uword> stiffness(2llu * n_size, 2llu * n_size), mass(2llu * n_size, 2llu * n_size), damping(2llu * n_size, 2llu * n_size);
+
+    const auto& t_stiffness = W->get_stiffness()->triplet_mat;
+    stiffness.assemble(t_stiffness, 0, 0, 1.);
+    stiffness.assemble(t_stiffness, n_size, n_size, 1.);
+
+    const auto& t_mass = W->get_mass()->triplet_mat;
+    mass.assemble(t_mass, 0, 0, -1.);
+    mass.assemble(t_mass, n_size, n_size, -1.);
+
+    if(nullptr != W->get_damping()) {
+        const auto& t_damping = W->get_damping()->triplet_mat;
+        damping.assemble(t_damping, 0, n_size, -1.);
+        damping.assemble(t_damping, n_size, 0, 1.);
+    }
+
+    // each worker owns a container so that factorisations are independent
+    const auto n_worker = std::min(static_cast<uword>(std::max(1, SUANPAN_NUM_THREADS)), frequency.n_elem);
+
+    Factory<double> companion(2u * W->get_size(), AnalysisType::NONE, StorageScheme::SPARSE);
+    companion.set_solver_type(system_solver);
+    companion.set_solver_setting(W->get_solver_setting());
+
+    std::vector<shared_ptr<MetaMat<double>>> worker(n_worker);
+    for(auto& I : worker) {
+        companion.initialize_stiffness();
+        I = companion.get_stiffness();
+    }
+
+    // the state prior to this step is restored on exit
+    const auto current_time = W->get_current_time();
+    const vec current_displacement = W->get_current_displacement();
+    const vec current_velocity = W->get_current_velocity();
+    const vec current_acceleration = W->get_current_acceleration();
+
+    // only the factory and nodes hold the response, elements are not updated so that their history is untouched
+    auto update_state = [&](const double t_time, const vec& t_displacement, const vec& t_velocity, const vec& t_acceleration) {
+        W->update_trial_time(t_time);
+        W->update_trial_displacement(t_displacement);
+        W->update_trial_velocity(t_velocity);
+        W->update_trial_acceleration(t_acceleration);
+        W->commit_status();
+        suanpan::for_all(D->get_node_pool(), [&](const shared_ptr<Node>& t_node) {
+            t_node->update_trial_status(t_displacement, t_velocity, t_acceleration);
+            t_node->commit_status();
+        });
+    };
+
+    mat response(2llu * n_size, n_worker);
+
+    for(uword begin = 0; begin < frequency.n_elem; begin += n_worker) {
+        const auto end = std::min(begin + n_worker, frequency.n_elem);
+
+        std::atomic_int code = SUANPAN_SUCCESS;
+
+        suanpan::for_each(begin, end, [&](const uword I) {
+            const auto omega = frequency(I);
+
+            auto t_triplet = stiffness;
+            t_triplet.assemble(mass, 0, 0, omega * omega);
+            t_triplet.assemble(damping, 0, 0, omega);
+
+            const auto& t_mat = worker[I - begin];
+            t_mat->zeros();
+            t_mat->scale_accu(1., t_triplet);
+
+            if(mat t_response; SUANPAN_SUCCESS != t_mat->solve(t_response, load)) code = SUANPAN_FAIL;
+            else response.col(I - begin) = t_response;
+        });
+
+        if(SUANPAN_SUCCESS != code) {
+            suanpan_error("Fail to solve the system for frequencies from {:.5E} to {:.5E}.\n", frequency(begin), frequency(end - 1));
+            return SUANPAN_FAIL;
+        }
+
+        // stream the current batch to recorders in order
+        for(auto I = begin; I < end; ++I) {
+            const auto omega = frequency(I);
+            const vec real = response.col(I - begin).head(n_size), imag = response.col(I - begin).tail(n_size);
+            update_state(omega, real, -omega * imag, -omega * omega * real);
+            G->record();
+        }
+    }
+
+    update_state(current_time, current_displacement, current_velocity, current_acceleration);
+
+    return SUANPAN_SUCCESS;
+}
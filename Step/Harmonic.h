@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class Harmonic
+ * @brief A Harmonic class.
+ *
+ * The Harmonic class computes the steady state response under harmonic excitations.
+ * For each circular frequency \f$\omega\f$, the complex system
+ * \f{gather}{\left(K-\omega^2M+i\omega{}C\right)u=F\f}
+ * is solved in its real equivalent form
+ * \f{gather}{\begin{bmatrix}K-\omega^2M&-\omega{}C\\\omega{}C&K-\omega^2M\end{bmatrix}\begin{Bmatrix}u_r\\u_i\end{Bmatrix}=\begin{Bmatrix}F\\0\end{Bmatrix},\f}
+ * so that the existing sparse solvers can be used.
+ * Global matrices are assembled once, frequency points are solved concurrently with independent factorisations.
+ *
+ * The load amplitude \f$F\f$ is the spatial pattern of active loads, support motions are treated as unit base accelerations.
+ * Recorders sample the state at \f$t=0\f$ of the steady state response, that is,
+ * the displacement is \f$u_r\f$, the velocity is \f$-\omega{}u_i\f$ and the acceleration is \f$-\omega^2u_r\f$.
+ * The recorded time is the circular frequency.
+ * Only nodes and global vectors hold the response, elements and materials are not updated so that their history is
+ * not altered, element recorders thus sample the state prior to this step.
+ * Nodal states prior to this step are restored on exit.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file Harmonic.h
+ * @addtogroup Step
+ * @{
+ */
+
+#ifndef HARMONIC_H
+#define HARMONIC_H
+
+#include <Step/Step.h>
+
+class Harmonic final : public Step {
+    const vec frequency;
+
+public:
+    Harmonic(unsigned, vec&&);
+
+    int initialize() override;
+
+    int analyze() override;
+};
+
+#endif
+
+//! @}
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "ModalDynamic.h"
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Load/SupportMotion.h>
+#include <Recorder/Recorder.h>
+#include <Solver/Integrator/Integrator.h>
+
+ModalDynamic::ModalDynamic(const unsigned T, const double P, const double Z)
+    : Step(T, P)
+    , damping_ratio(Z) {}
+
+int ModalDynamic::initialize() {
+    configure_storage_scheme();
+
+    factory->set_analysis_type(AnalysisType::DYNAMICS);
+
+    const auto t_domain = database.lock();
+
+    if(SUANPAN_SUCCESS != t_domain->restart()) return SUANPAN_FAIL;
+
+    if(factory->get_eigenvalue().is_empty() || factory->get_eigenvector().n_rows != factory->get_size()) {
+        suanpan_error("Valid eigenpairs are required, perform a frequency analysis first.\n");
+        return SUANPAN_FAIL;
+    }
+
+    // modal equations are integrated exactly, the integrator only manages the state
+    modifier = make_shared<Integrator>();
+    modifier->set_domain(t_domain);
+
+    return modifier->initialize();
+}
+
+int ModalDynamic::analyze() {
+    auto& G = get_integrator();
+    auto& W = get_factory();
+    const auto D = G->get_domain();
+
+    D->assemble_trial_mass();
+
+    // rigid body modes cannot be handled by the recurrence
+    const uvec active = find(W->get_eigenvalue() > 0.);
+    if(active.is_empty()) {
+        suanpan_error("No positive eigenvalue is found.\n");
+        return SUANPAN_FAIL;
+    }
+    if(active.n_elem < W->get_eigenvalue().n_elem) suanpan_warning("{} modes with non-positive eigenvalues are excluded.\n", W->get_eigenvalue().n_elem - active.n_elem);
+
+    const mat phi = W->get_eigenvector().cols(active);
+    const vec omega = sqrt(W->get_eigenvalue()(active));
+    const vec stiffness = square(omega);
+
+    // modes are mass orthogonal but not necessarily mass normalised
+    mat projector = W->get_mass()->operator*(phi);
+    const vec modal_mass = sum(phi % projector).t();
+    projector.each_row() /= modal_mass.t();
+
+    // spatial patterns are projected once, support motions are differentiated to accelerations
+    std::vector<shared_ptr<Load>> load_pool;
+    std::vector<unsigned> load_order;
+    mat participation(phi.n_cols, 0);
+    for(const auto& I : D->get_load_pool()) {
+        if(!I->validate_step(D)) continue;
+        const auto t_pattern = I->get_spatial_pattern(D);
+        if(t_pattern.is_empty()) {
+            suanpan_error("Load {} cannot be decomposed into a spatial pattern and a time history.\n", I->get_tag());
+            return SUANPAN_FAIL;
+        }
+        load_pool.emplace_back(I);
+        load_order.emplace_back(std::dynamic_pointer_cast<SupportDisplacement>(I) ? 2 : std::dynamic_pointer_cast<SupportVelocity>(I) ? 1 : 0);
+        participation.insert_cols(participation.n_cols, phi.t() * t_pattern / modal_mass);
+    }
+
+    const auto n_step = std::max(1., std::round(get_time_period() / get_ini_step_size()));
+    const auto dt = get_time_period() / n_step;
+
+    auto modal_load = [&](const double t) -> vec {
+        vec history(load_pool.size());
+        for(auto I = 0llu; I < load_pool.size(); ++I) {
+            const auto& t_load = load_pool[I];
+            if(2 == load_order[I]) history(I) = (t_load->get_time_history(t + dt) - 2. * t_load->get_time_history(t) + t_load->get_time_history(t - dt)) / dt / dt;
+            else if(1 == load_order[I]) history(I) = .5 * (t_load->get_time_history(t + dt) - t_load->get_time_history(t - dt)) / dt;
+            else history(I) = t_load->get_time_history(t);
+        }
+        return participation * history;
+    };
+
+    // coefficients of the exact recurrence for piecewise linear excitations
+    const auto root = std::sqrt(1. - damping_ratio * damping_ratio);
+    const vec omega_d = root * omega;
+    const vec ratio = 2. * damping_ratio / (dt * omega);
+    const vec decay = exp(-damping_ratio * dt * omega);
+    const vec s = decay % sin(dt * omega_d), c = decay % cos(dt * omega_d);
+
+    const vec ca = damping_ratio / root * s + c;
+    const vec cb = s / omega_d;
+    const vec cc = (ratio + ((1. - 2. * damping_ratio * damping_ratio) / (dt * omega_d) - damping_ratio / root) % s - (1. + ratio) % c) / stiffness;
+    const vec cd = (1. - ratio + (2. * damping_ratio * damping_ratio - 1.) / (dt * omega_d) % s + ratio % c) / stiffness;
+    const vec va = -omega / root % s;
+    const vec vb = c - damping_ratio / root * s;
+    const vec vc = (-1. / dt + (omega + damping_ratio / dt) / root % s + c / dt) / stiffness;
+    const vec vd = (1. - ca) / stiffness / dt;
+
+    // components outside the span of the basis are discarded
+    vec q = projector.t() * W->get_current_displacement();
+    vec v = projector.t() * W->get_current_velocity();
+    vec p = modal_load(W->get_current_time());
+
+    const auto& recorder_pool = D->get_recorder_pool();
+
+    for(auto I = 1u; I <= static_cast<unsigned>(n_step); ++I) {
+        G->update_incre_time(dt);
+
+        const vec p_next = modal_load(W->get_trial_time());
+        const vec q_next = ca % q + cb % v + cc % p + cd % p_next;
+        v = va % q + vb % v + vc % p + vd % p_next;
+        q = q_next;
+        p = p_next;
+
+        set_time_left(get_time_period() - I * dt);
+
+        if(I == n_step || std::ranges::any_of(recorder_pool, [](const shared_ptr<Recorder>& t_recorder) { return t_recorder->if_record_next(); })) {
+            const mat response = phi * join_rows(q, v, p - 2. * damping_ratio * omega % v - stiffness % q);
+            W->update_trial_displacement(response.col(0));
+            W->update_trial_velocity(response.col(1));
+            W->update_trial_acceleration(response.col(2));
+            if(SUANPAN_SUCCESS != D->update_trial_status()) return SUANPAN_FAIL;
+            G->stage_and_commit_status();
+        }
+        else W->commit_time();
+
+        // recorders not sampling the state only advance their counters
+        G->record();
+    }
+
+    return SUANPAN_SUCCESS;
+}
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class ModalDynamic
+ * @brief A ModalDynamic class.
+ *
+ * The ModalDynamic class performs linear time history analysis by modal superposition.
+ * The eigenpairs stored in the factory, typically computed by a preceding frequency step,
+ * are used as the basis. Loads are decomposed into spatial patterns and time histories,
+ * the spatial patterns are projected onto the basis once.
+ *
+ * The decoupled modal equations
+ * \f{gather}{\ddot{q}_i+2\zeta\omega_i\dot{q}_i+\omega_i^2q_i=p_i(t)\f}
+ * are integrated in a batch by the exact recurrence of piecewise linear excitations.
+ * Modal coordinates are only expanded to physical DoFs when recorders sample the state.
+ *
+ * Support motions are treated as uniform base excitations, the response is thus relative to the moving base.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @version 0.1.0
+ * @file ModalDynamic.h
+ * @addtogroup Step
+ * @{
+ */
+
+#ifndef MODALDYNAMIC_H
+#define MODALDYNAMIC_H
+
+#include <Step/Step.h>
+
+class ModalDynamic final : public Step {
+    const double damping_ratio;
+
+public:
+    ModalDynamic(unsigned, double, double = 0.);
+
+    int initialize() override;
+
+    int analyze() override;
+};
+
+#endif
+
+//! @}
@@ -21,6 +21,7 @@
 #include <Domain/Factory.hpp>
 #include <Load/GroupNodalDisplacement.h>
 #include <Solver/Integrator/Integrator.h>
+#include <Solver/JFNK.h>
 #include <Solver/MPDC.h>
 #include <Solver/Newton.h>
 
@@ -32,6 +33,9 @@ int Static::initialize() {
 
     factory->set_analysis_type(AnalysisType::STATICS);
 
+    // the global stiffness is not allocated for matrix-free solvers
+    factory->set_matrix_free(nullptr != std::dynamic_pointer_cast<JFNK>(solver));
+
     const auto t_domain = database.lock();
 
     if(SUANPAN_SUCCESS != t_domain->restart()) return SUANPAN_FAIL;
@@ -58,6 +62,12 @@ int Static::initialize() {
         solver = make_shared<MPDC>();
     }
 
+    // the replacement requires the global stiffness
+    if(factory->is_matrix_free() && nullptr == std::dynamic_pointer_cast<JFNK>(solver)) {
+        factory->set_matrix_free(false);
+        if(SUANPAN_SUCCESS != t_domain->restart()) return SUANPAN_FAIL;
+    }
+
     solver->set_integrator(modifier);
     solver->set_converger(tester);
 
@@ -72,8 +82,8 @@ int Static::analyze() {
     auto& S = get_solver();
     auto& G = get_integrator();
 
-    auto remain_time = get_time_period();
-    auto step_time = get_ini_step_size();
+    auto remain_time = get_time_left();
+    auto step_time = std::min(get_ini_step_size(), remain_time);
 
     unsigned num_increment = 0, num_converged_step = 0;
 
@@ -89,13 +99,13 @@ int Static::analyze() {
         G->update_incre_time(step_time);
         if(auto code = S->analyze(); SUANPAN_SUCCESS == code) {
             // success step
+            // eat current increment
+            // update time left which will be used in for example criterion and checkpoint
+            set_time_left(remain_time -= step_time);
             // commit converged iteration
             G->stage_and_commit_status();
             // record response
             G->record();
-            // eat current increment
-            // update time left which will be used in for example criterion
-            set_time_left(remain_time -= step_time);
             if(!is_fixed_step_size() && ++num_converged_step > 5) {
                 step_time = std::min(get_max_step_size(), step_time * S->get_step_amplifier());
                 num_converged_step = 0;
@@ -37,6 +37,9 @@ Step::Step(const unsigned T, const double P)
 int Step::initialize() {
     const auto t_domain = database.lock();
 
+    // a step resumed from a checkpoint has its remaining time restored afterwards
+    time_left = time_period;
+
     if(sparse_mat) {
         // LAPACK and SPIKE are for dense only
         if(SolverType::LAPACK == system_solver || SolverType::SPIKE == system_solver) system_solver = SolverType::MUMPS;
@@ -66,6 +69,9 @@ int Step::initialize() {
     factory->set_solver_type(system_solver);
     factory->set_solver_setting(system_setting);
     factory->set_sub_solver_type(sub_system_solver);
+    // the factory is shared by all steps, the lumped mass and the matrix-free mode are opted in by each step
+    factory->set_lumped_mass(false);
+    factory->set_matrix_free(false);
 #ifdef SUANPAN_MAGMA
     factory->set_solver_setting(magma_setting);
 #endif
@@ -170,8 +176,12 @@ bool Step::is_band() const { return band_mat; }
 
 bool Step::is_sparse() const { return sparse_mat; }
 
+bool Step::is_lumped() const { return lumped_mat; }
+
 void Step::set_symm(const bool B) const { access::rw(symm_mat) = B; }
 
 void Step::set_band(const bool B) const { access::rw(band_mat) = B; }
 
 void Step::set_sparse(const bool B) const { access::rw(sparse_mat) = B; }
+
+void Step::set_lumped(const bool B) const { access::rw(lumped_mat) = B; }
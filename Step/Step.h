@@ -57,6 +57,7 @@ protected:
     const bool symm_mat = false;
     const bool band_mat = true;
     const bool sparse_mat = false;
+    const bool lumped_mat = false;
 
     SolverType system_solver = SolverType::LAPACK;
     SolverSetting<double> system_setting{};
@@ -137,9 +138,11 @@ public:
     [[nodiscard]] bool is_symm() const;
     [[nodiscard]] bool is_band() const;
     [[nodiscard]] bool is_sparse() const;
+    [[nodiscard]] bool is_lumped() const;
     void set_symm(bool) const;
     void set_band(bool) const;
     void set_sparse(bool) const;
+    void set_lumped(bool) const;
 };
 
 #endif
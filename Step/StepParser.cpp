@@ -96,6 +96,40 @@ int create_new_step(const shared_ptr<DomainBase>& domain, istringstream& command
         else
             suanpan_error("Cannot create new step.\n");
     }
+    else if(is_equal(step_type, "ModalDynamic")) {
+        auto time = 1.;
+        if(!command.eof() && !get_input(command, time)) {
+            suanpan_error("A valid time period is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+        auto damping_ratio = 0.;
+        if(!command.eof() && !get_input(command, damping_ratio)) {
+            suanpan_error("A valid damping ratio is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+        if(damping_ratio < 0. || damping_ratio >= 1.) {
+            suanpan_error("The damping ratio shall be in [0, 1).\n");
+            return SUANPAN_SUCCESS;
+        }
+        if(domain->insert(make_shared<ModalDynamic>(tag, time, damping_ratio))) domain->set_current_step_tag(tag);
+        else
+            suanpan_error("Cannot create new step.\n");
+    }
+    else if(is_equal(step_type, "Harmonic")) {
+        double start, end;
+        if(!get_input(command, start, end) || start < 0. || end < start) {
+            suanpan_error("A valid range of circular frequencies is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+        auto num = 1u;
+        if(!command.eof() && (!get_input(command, num) || 0u == num)) {
+            suanpan_error("A valid number of frequency points is required.\n");
+            return SUANPAN_SUCCESS;
+        }
+        if(domain->insert(make_shared<Harmonic>(tag, 1u == num ? vec{start} : linspace(start, end, num)))) domain->set_current_step_tag(tag);
+        else
+            suanpan_error("Cannot create new step.\n");
+    }
     else if(is_equal(step_type, "ArcLength")) {
         if(domain->insert(make_shared<ArcLength>(tag))) domain->set_current_step_tag(tag);
         else
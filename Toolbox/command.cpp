@@ -61,6 +61,10 @@
 #ifdef SUANPAN_MAGMA
 #include <Domain/MetaMat/SparseMatMAGMA.hpp>
 #endif
+#ifdef SUANPAN_HDF5
+#include <hdf5.h>
+#include <hdf5_hl.h>
+#endif
 
 using std::ifstream;
 using std::ofstream;
@@ -328,6 +332,229 @@ void perform_response_spectrum(istringstream& command) {
         suanpan_info("Data is saved to file \"{}\".\n", motion_name);
 }
 
+/**
+ * \brief Run the same model against a batch of ground motions.
+ * The model file is parsed once into normalised commands, each member replays them with the record of the given amplitude replaced.
+ * A prototype is prechecked so that members adopt its DoF ordering, colouring and sparse pattern instead of computing them again.
+ * Members run concurrently, recorders of each member are saved into a folder named after the record.
+ */
+void perform_ensemble(istringstream& command) {
+    string model_name;
+    unsigned amplitude_tag;
+    if(!get_input(command, model_name, amplitude_tag)) {
+        suanpan_error("A valid model file and a valid amplitude tag are required.\n");
+        return;
+    }
+
+    std::error_code code;
+    vector<fs::path> record_list;
+    for(string record_name; get_input(command, record_name);)
+        if(fs::is_directory(record_name, code)) {
+            vector<fs::path> t_list;
+            for(const auto& I : fs::directory_iterator(record_name, code))
+                if(I.is_regular_file()) t_list.emplace_back(I.path());
+            std::ranges::sort(t_list);
+            record_list.insert(record_list.end(), t_list.begin(), t_list.end());
+        }
+        else if(fs::exists(record_name, code)) record_list.emplace_back(record_name);
+        else
+            suanpan_warning("Record \"{}\" is not found and thus ignored.\n", record_name);
+
+    if(record_list.empty()) {
+        suanpan_error("At least one valid record is required.\n");
+        return;
+    }
+
+    ifstream input_file(model_name);
+    if(!input_file.is_open()) {
+        suanpan_error("Cannot open the model file \"{}\".\n", model_name);
+        return;
+    }
+
+    // analysis and output related commands are issued by the ensemble itself
+    vector<string> model_command;
+    string all_line, command_line;
+    while(!getline(input_file, command_line).fail()) {
+        if(!normalise_command(all_line, command_line)) continue;
+        istringstream tmp_str(all_line);
+        all_line.clear();
+        string command_id;
+        if(!get_input(tmp_str, command_id)) continue;
+        if(std::ranges::none_of(std::array{"analyze", "analyse", "precheck", "ensemble", "save", "restore", "clear", "reset", "exit", "quit"}, [&](const char* skipped) { return is_equal(command_id, skipped); })) model_command.emplace_back(tmp_str.str());
+    }
+
+    auto amplitude_found = false;
+
+    const auto build_model = [&](const fs::path& record, const bool with_recorder) {
+        auto t_model = make_shared<Bead>();
+        for(const auto& I : model_command) {
+            istringstream tmp_str(I);
+            string command_id, amplitude_type, file_name;
+            if(!with_recorder && get_input(tmp_str, command_id) && std::ranges::any_of(std::array{"recorder", "hdf5recorder", "plainrecorder", "streamrecorder"}, [&](const char* skipped) { return is_equal(command_id, skipped); })) continue;
+            tmp_str = istringstream(I);
+            if(unsigned tag; get_input(tmp_str, command_id, amplitude_type, tag, file_name) && is_equal(command_id, "amplitude") && tag == amplitude_tag) {
+                amplitude_found = true;
+                auto t_command = fmt::format("amplitude {} {} {}", amplitude_type, tag, record.generic_string());
+                if(const auto remaining = get_remaining(tmp_str); !remaining.empty()) t_command += ' ' + remaining;
+                tmp_str = istringstream(t_command);
+            }
+            else tmp_str = istringstream(I);
+            process_command(t_model, tmp_str);
+        }
+        return t_model;
+    };
+
+    // the prototype only provides the topology, it shall not write anything
+    const auto prototype = build_model(record_list.front(), false);
+    if(!amplitude_found) {
+        suanpan_error("Amplitude {} reading from a file is not found in the model.\n", amplitude_tag);
+        return;
+    }
+    if(SUANPAN_SUCCESS != prototype->precheck()) {
+        suanpan_error("The model fails the precheck.\n");
+        return;
+    }
+
+    const auto original_output = SUANPAN_OUTPUT;
+
+    auto n_failure = 0u;
+
+    const auto n_record = record_list.size();
+    const auto n_batch = std::min(n_record, static_cast<size_t>(SUANPAN_NUM_THREADS));
+    for(size_t start = 0; start < n_record; start += n_batch) {
+        const auto n_member = std::min(n_batch, n_record - start);
+
+        // each member writes to its own folder, including streamed samples, frames and checkpoints
+        vector<shared_ptr<Bead>> member(n_member);
+        for(size_t I = 0; I < n_member; ++I) {
+            member[I] = build_model(record_list[start + I], true);
+            member[I]->share_topology(prototype);
+
+            const auto output_path = original_output / record_list[start + I].stem();
+            fs::create_directories(output_path, code);
+            member[I]->get_current_domain()->set_output_path(output_path);
+        }
+
+        vector<int> status(n_member, SUANPAN_SUCCESS);
+        suanpan::for_each(n_member, [&](const size_t I) { status[I] = member[I]->analyze(); });
+
+        for(size_t I = 0; I < n_member; ++I) {
+            if(SUANPAN_SUCCESS != status[I]) {
+                ++n_failure;
+                suanpan_error("The analysis using record \"{}\" fails, the recorded history is saved.\n", record_list[start + I].generic_string());
+            }
+
+            for(const auto& t_recorder : member[I]->get_current_domain()->get_recorder_pool()) t_recorder->save();
+        }
+    }
+
+    suanpan_info("{} out of {} analyses are completed successfully.\n", n_record - n_failure, n_record);
+}
+
+/**
+ * \brief Compute response spectra of all records in a folder for a number of damping ratios and store them in one HDF5 file.
+ * Each record is stored as a dataset of size (damping ratio, 4, period), the second dimension follows the layout of a single spectrum.
+ */
+void perform_response_spectrum_batch(istringstream& command) {
+    string folder_name, period_name;
+    if(!get_input(command, folder_name, period_name)) {
+        suanpan_error("A valid folder of ground motions and a valid file name of period vector are required.\n");
+        return;
+    }
+
+    auto interval = 0.;
+    if(!get_input(command, interval) || interval <= 0.) {
+        suanpan_error("A valid sampling interval for records stored in one column is required.\n");
+        return;
+    }
+
+    vector<double> damping_list;
+    for(auto damping_ratio = 0.; get_input(command, damping_ratio);) {
+        if(damping_ratio < 0. || damping_ratio >= 1.) {
+            suanpan_error("A valid damping ratio is required.\n");
+            return;
+        }
+        damping_list.emplace_back(damping_ratio);
+    }
+    if(damping_list.empty()) {
+        suanpan_error("At least one valid damping ratio is required.\n");
+        return;
+    }
+    const vec damping_ratio(damping_list);
+
+    std::error_code code;
+    mat period;
+    if(!fs::exists(period_name, code) || !period.load(period_name, raw_ascii) || period.empty()) {
+        suanpan_error("A valid period vector stored in one column is required.\n");
+        return;
+    }
+
+    if(!fs::is_directory(folder_name, code)) {
+        suanpan_error("A valid folder of ground motions is required.\n");
+        return;
+    }
+
+    vector<fs::path> record_list;
+    for(const auto& I : fs::directory_iterator(folder_name, code))
+        if(I.is_regular_file()) record_list.emplace_back(I.path());
+    std::ranges::sort(record_list);
+
+    vector<cube> spectrum(record_list.size());
+
+    // records are processed concurrently, oscillators of each record are further vectorised and processed concurrently
+    suanpan::for_each(record_list.size(), [&](const size_t I) {
+        mat motion;
+        if(!motion.load(record_list[I].string(), raw_ascii) || motion.empty() || motion.n_cols > 2llu || motion.n_rows < 2llu) return;
+
+        auto t_interval = interval;
+        if(2llu == motion.n_cols) {
+            t_interval = mean(diff(motion.col(0)));
+            motion = motion.col(1);
+        }
+
+        spectrum[I] = response_spectrum<double>(damping_ratio, t_interval, motion.col(0), period.col(0));
+    });
+
+#ifdef SUANPAN_HDF5
+    auto file_name = fs::path(folder_name).lexically_normal();
+    if(!file_name.has_filename()) file_name = file_name.parent_path();
+    file_name += "_response_spectrum.h5";
+
+    const auto file_id = H5Fcreate(file_name.generic_string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if(file_id < 0) {
+        suanpan_error("Fail to create file \"{}\".\n", file_name.generic_string());
+        return;
+    }
+
+    hsize_t dimension[3] = {period.n_rows, 1};
+    H5LTmake_dataset(file_id, "Period", 1, dimension, H5T_NATIVE_DOUBLE, period.colptr(0));
+    dimension[0] = damping_ratio.n_elem;
+    H5LTmake_dataset(file_id, "DampingRatio", 1, dimension, H5T_NATIVE_DOUBLE, damping_ratio.memptr());
+
+    const auto group_id = H5Gcreate(file_id, "/Spectrum", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    auto n_success = 0u;
+    for(size_t I = 0; I < record_list.size(); ++I) {
+        if(spectrum[I].is_empty()) {
+            suanpan_warning("Record \"{}\" is not a valid ground motion stored in either one or two columns, skipped.\n", record_list[I].generic_string());
+            continue;
+        }
+        dimension[0] = spectrum[I].n_slices;
+        dimension[1] = spectrum[I].n_cols;
+        dimension[2] = spectrum[I].n_rows;
+        H5LTmake_dataset(group_id, record_list[I].stem().generic_string().c_str(), 3, dimension, H5T_NATIVE_DOUBLE, spectrum[I].memptr());
+        ++n_success;
+    }
+
+    H5Gclose(group_id);
+    H5Fclose(file_id);
+
+    suanpan_info("Spectra of {} records are saved to file \"{}\".\n", n_success, file_name.generic_string());
+#else
+    suanpan_error("HDF5 support is not enabled.\n");
+#endif
+}
+
 void perform_sdof_response(istringstream& command) {
     string motion_name;
     if(!get_input(command, motion_name)) {
@@ -757,6 +984,19 @@ int save_object(const shared_ptr<DomainBase>& domain, istringstream& command) {
     return SUANPAN_SUCCESS;
 }
 
+int restore_model(const shared_ptr<DomainBase>& domain, istringstream& command) {
+    if(nullptr == domain) {
+        suanpan_error("A valid domain is required.\n");
+        return SUANPAN_SUCCESS;
+    }
+
+    string name = "Model.h5";
+    if(!command.eof() && !get_input(command, name)) name = "Model.h5";
+    domain->restore(name);
+
+    return SUANPAN_SUCCESS;
+}
+
 int suspend_object(const shared_ptr<DomainBase>& domain, istringstream& command) {
     if(nullptr == domain) {
         suanpan_error("A valid domain is required.\n");
@@ -890,6 +1130,18 @@ int set_property(const shared_ptr<DomainBase>& domain, istringstream& command) {
 
         return SUANPAN_SUCCESS;
     }
+    if(is_equal(property_id, "frozen_pattern")) {
+        string value;
+        get_input(command, value) ? domain->set_frozen_pattern(is_true(value)) : suanpan_error("A valid value is required.\n");
+
+        return SUANPAN_SUCCESS;
+    }
+    if(is_equal(property_id, "element_arena")) {
+        string value;
+        get_input(command, value) ? domain->set_element_arena(is_true(value)) : suanpan_error("A valid value is required.\n");
+
+        return SUANPAN_SUCCESS;
+    }
     if(is_equal(property_id, "constraint_multiplier")) {
         double value;
         get_input(command, value) ? set_constraint_multiplier(value) : suanpan_error("A valid value is required.\n");
@@ -929,6 +1181,10 @@ int set_property(const shared_ptr<DomainBase>& domain, istringstream& command) {
         string value;
         get_input(command, value) ? t_step->set_sparse(is_true(value)) : suanpan_error("A valid value is required.\n");
     }
+    else if(is_equal(property_id, "lumped_mat")) {
+        string value;
+        get_input(command, value) ? t_step->set_lumped(is_true(value)) : suanpan_error("A valid value is required.\n");
+    }
     else if(is_equal(property_id, "iterative_refinement")) {
         if(unsigned value; get_input(command, value)) t_step->set_refinement(value);
         else
@@ -960,6 +1216,7 @@ int set_property(const shared_ptr<DomainBase>& domain, istringstream& command) {
 #endif
         else if(is_equal(value, "GMRES")) t_step->set_system_solver(IterativeSolver::GMRES);
         else if(is_equal(value, "BICGSTAB")) t_step->set_system_solver(IterativeSolver::BICGSTAB);
+        else if(is_equal(value, "CG")) t_step->set_system_solver(IterativeSolver::CG);
         else if(is_equal(value, "NONE")) t_step->set_system_solver(IterativeSolver::NONE);
         else
             suanpan_error("A valid solver type is required.\n");
@@ -986,6 +1243,8 @@ int set_property(const shared_ptr<DomainBase>& domain, istringstream& command) {
             suanpan_error("A valid value is required.\n");
         else if(is_equal(value, "NONE")) t_step->set_preconditioner(PreconditionerType::NONE);
         else if(is_equal(value, "JACOBI")) t_step->set_preconditioner(PreconditionerType::JACOBI);
+        else if(is_equal(value, "ICC")) t_step->set_preconditioner(PreconditionerType::ICC);
+        else if(is_equal(value, "AMG")) t_step->set_preconditioner(PreconditionerType::AMG);
 #ifndef SUANPAN_SUPERLUMT
         else if(is_equal(value, "ILU")) t_step->set_preconditioner(PreconditionerType::ILU);
 #endif
@@ -1163,6 +1422,7 @@ int print_command() {
     suanpan_info(format, "domain", "create/switch to other problem domains");
     suanpan_info(format, "element", "define elements");
     suanpan_info(format, "enable", "enable objects");
+    suanpan_info(format, "ensemble", "run a model against a batch of ground motions concurrently");
     suanpan_info(format, "example", "establish and execute a minimum example");
     suanpan_info(format, "exit/quit", "exit the program");
     suanpan_info(format, "file", "load external files");
@@ -1189,7 +1449,9 @@ int print_command() {
     suanpan_info(format, "qrcode", "print a qr code");
     suanpan_info(format, "recorder", "define recorders");
     suanpan_info(format, "reset", "reset the model to the previously converged state");
+    suanpan_info(format, "restore", "resume the next analysis from a checkpoint saved by save model");
     suanpan_info(format, "response_spectrum", "compute the response spectrum of a given ground motion");
+    suanpan_info(format, "response_spectrum_batch", "compute response spectra of all ground motions in a folder");
     suanpan_info(format, "save", "save objects");
     suanpan_info(format, "sdof_response", "compute the sdof response of a given ground motion");
     suanpan_info(format, "section", "define sections");
@@ -1197,6 +1459,7 @@ int print_command() {
     suanpan_info(format, "set", "set properties of the analysis/model");
     suanpan_info(format, "solver", "define solvers");
     suanpan_info(format, "step", "define steps");
+    suanpan_info(format, "streamrecorder", "define hdf5 recorders that write samples in chunks during the analysis");
     suanpan_info(format, "summary", "print summary for the current problem domain");
     suanpan_info(format, "suspend", "suspend objects in the current step");
     suanpan_info(format, "terminal", "execute commands in terminal");
@@ -1297,6 +1560,7 @@ int process_command(const shared_ptr<Bead>& model, istringstream& command) {
     if(is_equal(command_id, "list")) return list_object(domain, command);
     if(is_equal(command_id, "protect")) return protect_object(domain, command);
     if(is_equal(command_id, "save")) return save_object(domain, command);
+    if(is_equal(command_id, "restore")) return restore_model(domain, command);
     if(is_equal(command_id, "set")) return set_property(domain, command);
     if(is_equal(command_id, "suspend")) return suspend_object(domain, command);
     if(is_equal(command_id, "use")) return use_object(domain, command);
@@ -1317,6 +1581,7 @@ int process_command(const shared_ptr<Bead>& model, istringstream& command) {
     if(is_equal(command_id, "orientation")) return create_new_orientation(domain, command);
     if(is_equal(command_id, "plainrecorder")) return create_new_recorder(domain, command, false);
     if(is_equal(command_id, "recorder")) return create_new_recorder(domain, command);
+    if(is_equal(command_id, "streamrecorder")) return create_new_stream_recorder(domain, command);
     if(is_equal(command_id, "section")) return create_new_section(domain, command);
     if(is_equal(command_id, "solver")) return create_new_solver(domain, command);
     if(is_equal(command_id, "step")) return create_new_step(domain, command);
@@ -1520,11 +1785,21 @@ int process_command(const shared_ptr<Bead>& model, istringstream& command) {
         return SUANPAN_SUCCESS;
     }
 
+    if(is_equal(command_id, "response_spectrum_batch")) {
+        perform_response_spectrum_batch(command);
+        return SUANPAN_SUCCESS;
+    }
+
     if(is_equal(command_id, "sdof_response")) {
         perform_sdof_response(command);
         return SUANPAN_SUCCESS;
     }
 
+    if(is_equal(command_id, "ensemble")) {
+        perform_ensemble(command);
+        return SUANPAN_SUCCESS;
+    }
+
     if(is_equal(command_id, "version")) print_version();
     else
         suanpan_error("Command \"{}\" not found.\n", command.str());
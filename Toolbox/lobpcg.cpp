@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "lobpcg.h"
+
+/**
+ * \brief Orthonormalise a block with respect to \f$M\f$ via SVQB, linearly dependent directions are dropped.
+ * The product with \f$M\f$ is transformed alongside.
+ */
+static void svqb(mat& Q, mat& MQ) {
+    if(Q.empty()) return;
+
+    mat gram = Q.t() * MQ;
+    gram = .5 * (gram + gram.t());
+
+    vec scale = gram.diag();
+    scale.transform([](const double x) { return x > 0. ? 1. / std::sqrt(x) : 0.; });
+
+    gram.each_col() %= scale;
+    gram.each_row() %= scale.t();
+
+    vec theta;
+    mat V;
+    if(!eig_sym(theta, V, gram)) {
+        Q.reset();
+        return;
+    }
+
+    const uvec keep = find(theta > 1E-10 * theta.max());
+
+    mat Z = V.cols(keep);
+    Z.each_col() %= scale;
+    Z.each_row() /= sqrt(theta(keep)).t();
+
+    Q *= Z;
+    MQ *= Z;
+}
+
+/**
+ * \brief Rayleigh--Ritz on the basis \f$S\f$, the Gram matrix is used explicitly as \f$S\f$ is only approximately \f$M\f$-orthonormal.
+ * \return eigenvalues (ascending) and coefficients
+ */
+static bool rayleigh_ritz(vec& theta, mat& C, mat&& HK, mat&& HM) {
+    HK = .5 * (HK + HK.t());
+    HM = .5 * (HM + HM.t());
+
+    if(mat L; chol(L, HM, "lower")) {
+        const mat IL = inv(trimatl(L));
+        if(!eig_sym(theta, C, IL * HK * IL.t())) return false;
+        C = IL.t() * C;
+        return true;
+    }
+
+    return eig_sym(theta, C, HK);
+}
+
+/**
+ * \brief Rayleigh--Ritz on \f$[X~Q]\f$, only the blocks involving \f$Q\f$ are computed as the current Ritz vectors \f$X\f$ satisfy
+ * \f$X^TKX=\Lambda\f$ and \f$X^TMX=I\f$.
+ */
+static bool rayleigh_ritz(vec& theta, mat& C, const vec& lambda, const mat& KX, const mat& MX, const mat& Q, const mat& KQ, const mat& MQ) {
+    const auto m = KX.n_cols, q = Q.n_cols;
+
+    mat HK(m + q, m + q), HM(m + q, m + q);
+
+    HK.submat(0, 0, m - 1, m - 1) = diagmat(lambda);
+    HK.submat(0, m, m - 1, m + q - 1) = KX.t() * Q;
+    HK.submat(m, 0, m + q - 1, m - 1) = HK.submat(0, m, m - 1, m + q - 1).t();
+    HK.submat(m, m, m + q - 1, m + q - 1) = Q.t() * KQ;
+
+    HM.submat(0, 0, m - 1, m - 1).eye();
+    HM.submat(0, m, m - 1, m + q - 1) = MX.t() * Q;
+    HM.submat(m, 0, m + q - 1, m - 1) = HM.submat(0, m, m - 1, m + q - 1).t();
+    HM.submat(m, m, m + q - 1, m + q - 1) = Q.t() * MQ;
+
+    return rayleigh_ritz(theta, C, std::move(HK), std::move(HM));
+}
+
+int lobpcg_solve(vec& eigval, mat& eigvec, const std::shared_ptr<MetaMat<double>>& K, const std::shared_ptr<MetaMat<double>>& M, const unsigned num, const double tolerance, const unsigned max_iteration) {
+    const auto n = K->n_rows;
+    const auto nev = std::min(static_cast<uword>(num), n);
+    // guard vectors accelerate the convergence of the last few wanted pairs
+    const auto m = std::min(n, nev + std::max(nev / 5, 5llu));
+
+    // condensed sparse storage enables multithreaded block products
+    K->csc_condense();
+    M->csc_condense();
+
+    // a slight shift keeps the preconditioner definite for floating structures
+    const unique_ptr<MetaMat<double>> factor = K->make_copy();
+    factor->scale_accu(1E-10 * std::fabs(K->max() / M->max()), M);
+
+    auto precondition = [&](const mat& R) {
+        mat W;
+        if(SUANPAN_SUCCESS != factor->solve(W, R)) W.reset();
+        return W;
+    };
+
+    mat X = precondition(M->operator*(mat(n, m, fill::randn)));
+    if(X.empty()) {
+        suanpan_error("Fail to factorise the shifted stiffness.\n");
+        return SUANPAN_FAIL;
+    }
+
+    mat MX = M->operator*(X);
+    svqb(X, MX);
+    if(X.n_cols < m) {
+        suanpan_error("Fail to generate a linearly independent initial block.\n");
+        return SUANPAN_FAIL;
+    }
+
+    vec lambda;
+    mat C;
+    mat KX = K->operator*(X);
+    if(!rayleigh_ritz(lambda, C, X.t() * KX, X.t() * MX)) return SUANPAN_FAIL;
+    X *= C;
+    KX *= C;
+    MX *= C;
+
+    mat P;
+
+    // columns whose relative residual exceeds the tolerance
+    auto find_active = [&](const mat& t_KX, const mat& t_MX) -> uvec {
+        const rowvec residual = sqrt(sum(square(t_KX - t_MX.each_row() % lambda.t())));
+        const rowvec scale = sqrt(sum(square(t_KX))) + abs(lambda.t()) % sqrt(sum(square(t_MX)));
+        return find(residual > tolerance * scale);
+    };
+
+    for(auto counter = 1u; counter <= max_iteration; ++counter) {
+        auto active = find_active(KX, MX);
+
+        suanpan_debug("LOBPCG iteration {}, {} active vectors.\n", counter, active.n_elem);
+
+        if(active.empty() || active.min() >= nev) {
+            // products are updated recursively, confirm convergence with fresh products
+            KX = K->operator*(X);
+            MX = M->operator*(X);
+            if(active = find_active(KX, MX); active.empty() || active.min() >= nev) {
+                eigval = lambda.head(nev);
+                eigvec = X.head_cols(nev);
+                suanpan_debug("LOBPCG iteration counter: {}.\n", counter);
+                return SUANPAN_SUCCESS;
+            }
+        }
+
+        mat R = MX.cols(active);
+        R.each_row() %= -lambda(active).t();
+        R += KX.cols(active);
+
+        mat W = precondition(R);
+        if(W.empty()) return SUANPAN_FAIL;
+
+        // X is M-orthonormal, remove its components from the search directions
+        for(auto I = 0; I < 2; ++I) W -= X * (MX.t() * W);
+        if(!P.empty()) P -= X * (MX.t() * P);
+
+        // for sparse matrices, fresh products are cheaper than dense updates of the products
+        mat Q = join_rows(W, P), MQ = M->operator*(Q);
+        svqb(Q, MQ);
+        if(Q.empty()) {
+            suanpan_error("LOBPCG stagnates as no new search direction can be found.\n");
+            return SUANPAN_FAIL;
+        }
+        const mat KQ = K->operator*(Q);
+
+        if(vec theta; !rayleigh_ritz(theta, C, lambda, KX, MX, Q, KQ, MQ)) return SUANPAN_FAIL;
+        else lambda = theta.head(m);
+        const mat CX = C.submat(0, 0, m - 1, m - 1), CQ = C.submat(m, 0, C.n_rows - 1, m - 1);
+
+        P = Q * CQ;
+
+        X = X * CX + P;
+        KX = KX * CX + KQ * CQ;
+        MX = MX * CX + MQ * CQ;
+    }
+
+    suanpan_error("LOBPCG fails to converge within {} iterations.\n", max_iteration);
+    return SUANPAN_FAIL;
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @fn lobpcg
+ * @brief Locally optimal block preconditioned conjugate gradient eigensolver.
+ *
+ * Computes the smallest eigenpairs of \f$Kx=\lambda{}Mx\f$ with all vectors
+ * processed as one block. The preconditioner is \f$(K+\sigma{}M)^{-1}\f$ with
+ * a tiny shift \f$\sigma\f$, which is factorised once and applied to all
+ * active residuals in a single multi-RHS solve. Products with \f$K\f$ and \f$M\f$ are also evaluated block-wise.
+ *
+ * The returned eigenvectors are \f$M\f$-orthonormal.
+ *
+ * @author tlc
+ * @date 17/10/2026
+ * @file lobpcg.h
+ * @addtogroup Utility
+ * @{
+ */
+
+#ifndef LOBPCG_SOLVE_H
+#define LOBPCG_SOLVE_H
+
+#include <Domain/MetaMat/MetaMat.hpp>
+#include <memory>
+
+int lobpcg_solve(vec&, mat&, const std::shared_ptr<MetaMat<double>>&, const std::shared_ptr<MetaMat<double>>&, unsigned, double = 1E-8, unsigned = 200);
+
+#endif
+
+//! @}
@@ -32,6 +32,7 @@
 #ifndef RESPONSE_SPECTRUM_H
 #define RESPONSE_SPECTRUM_H
 
+#include <array>
 #include <Toolbox/utility.h>
 
 template<sp_d T> class Oscillator {
@@ -111,29 +112,97 @@ public:
 };
 
 /**
- * \brief compute response spectrum of the given ground motion
- * \param damping_ratio damping ratio
+ * \brief compute response spectra of the given ground motion for a number of damping ratios
+ * Oscillators of all period and damping ratio pairs are advanced in lock-step, each block of oscillators occupies the lanes of
+ * fixed-size arrays so that the recurrence over the motion is vectorised across oscillators. Blocks are processed concurrently.
+ * \param damping_ratio damping ratios
  * \param interval sampling interval of the target ground motion
  * \param motion target ground motion stored in one column
  * \param period periods where response spectrum needs to be computed
- * \return response spectrum stored in four columns (period, displacement, velocity, acceleration)
+ * \return response spectra with each slice stored in four columns (period, displacement, velocity, acceleration)
  */
-template<sp_d T> Mat<T> response_spectrum(const T damping_ratio, const T interval, const Col<T>& motion, const Col<T>& period) {
-    Mat<T> spectrum(3, period.n_elem, fill::none);
-
-    suanpan::for_each(period.n_elem, [&](const uword I) {
-        if(!suanpan::approx_equal(period(I), T(0), 10000)) [[likely]] spectrum.col(I) = Oscillator(datum::tau / period(I), damping_ratio).compute_maximum_response(interval, motion);
-        else [[unlikely]] {
-            spectrum.col(I)(0) = spectrum.col(I)(1) = T(0);
-            spectrum.col(I)(2) = std::max(std::abs(motion.max()), std::abs(motion.min()));
+template<sp_d T> Cube<T> response_spectrum(const Col<T>& damping_ratio, const T interval, const Col<T>& motion, const Col<T>& period) {
+    // one block fills a cache line
+    static constexpr auto lane = 64llu / sizeof(T);
+
+    const auto n_period = period.n_elem;
+    const auto n_oscillator = n_period * damping_ratio.n_elem;
+    const auto n_block = (n_oscillator + lane - 1llu) / lane;
+
+    const auto max_motion = std::max(std::abs(motion.max()), std::abs(motion.min()));
+
+    Cube<T> spectrum(n_period, 4, damping_ratio.n_elem, fill::none);
+    spectrum.each_slice([&](Mat<T>& t_spectrum) { t_spectrum.col(0) = period; });
+
+    suanpan::for_each(n_block, [&](const uword B) {
+        std::array<T, lane> b{}, c{}, factor{};
+        std::array<T, lane> u_a{}, u_b{}, v_a{}, max_u{}, max_v{}, max_a{};
+
+        const auto first = B * lane, last = std::min(first + lane, n_oscillator);
+
+        // idle lanes run a trivial recurrence
+        for(auto L = first; L < last; ++L) {
+            const auto I = L % n_period;
+            if(suanpan::approx_equal(period(I), T(0), 10000)) [[unlikely]] continue;
+
+            const auto omega = datum::tau / period(I);
+            const auto zeta = damping_ratio(L / n_period);
+            const auto alpha = omega * zeta;
+            const auto beta = omega * std::sqrt(1. - zeta * zeta);
+            const auto exp_term = std::exp(-alpha * interval);
+
+            b[L - first] = 2. * exp_term * std::cos(beta * interval);
+            c[L - first] = exp_term * exp_term;
+            factor[L - first] = (1. - b[L - first] + c[L - first]) / interval / omega / omega;
         }
-    });
 
-    arma::inplace_trans(spectrum);
+        max_a.fill(std::abs(motion(0)));
+
+        for(auto I = 1llu; I < motion.n_elem; ++I) {
+            const auto excitation = motion(I - 1llu), ground = motion(I);
+            for(auto L = 0llu; L < lane; ++L) {
+                const auto u = b[L] * u_a[L] - c[L] * u_b[L] - excitation;
+                const auto v = u - u_a[L];
+                const auto a = v - v_a[L];
+
+                max_u[L] = std::max(max_u[L], std::abs(u));
+                max_v[L] = std::max(max_v[L], std::abs(v));
+                max_a[L] = std::max(max_a[L], std::abs(a * factor[L] / interval + ground));
 
-    return arma::join_rows(period, spectrum);
+                u_b[L] = u_a[L];
+                u_a[L] = u;
+                v_a[L] = v;
+            }
+        }
+
+        for(auto L = first; L < last; ++L) {
+            const auto I = L % n_period;
+            auto t_spectrum = spectrum.slice(L / n_period).row(I);
+            if(suanpan::approx_equal(period(I), T(0), 10000)) [[unlikely]] {
+                t_spectrum(1) = t_spectrum(2) = T(0);
+                t_spectrum(3) = max_motion;
+            }
+            else [[likely]] {
+                t_spectrum(1) = max_u[L - first] * factor[L - first] * interval;
+                t_spectrum(2) = max_v[L - first] * factor[L - first];
+                t_spectrum(3) = max_a[L - first];
+            }
+        }
+    });
+
+    return spectrum;
 }
 
+/**
+ * \brief compute response spectrum of the given ground motion
+ * \param damping_ratio damping ratio
+ * \param interval sampling interval of the target ground motion
+ * \param motion target ground motion stored in one column
+ * \param period periods where response spectrum needs to be computed
+ * \return response spectrum stored in four columns (period, displacement, velocity, acceleration)
+ */
+template<sp_d T> Mat<T> response_spectrum(const T damping_ratio, const T interval, const Col<T>& motion, const Col<T>& period) { return response_spectrum(Col<T>{damping_ratio}, interval, motion, period).slice(0); }
+
 /**
  * \brief compute response of a linear SDOF system
  * \param damping_ratio damping ratio of the system
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+
+#include "state_archive.h"
+#include <Material/Material.h>
+#include <Section/Section.h>
+
+state_archive::state_archive(std::vector<double>&& D, std::vector<uword>&& S)
+    : data(std::move(D))
+    , shape(std::move(S))
+    , loading(true) { valid = 0 == shape.size() % 2; }
+
+void state_archive::put(const double* const D, const uword R, const uword C) {
+    shape.emplace_back(R);
+    shape.emplace_back(C);
+    data.insert(data.end(), D, D + R * C);
+}
+
+/**
+ * \brief Read the shape of the next item and return the pointer to its values, `nullptr` if the archive is exhausted.
+ */
+const double* state_archive::get(uword& R, uword& C) {
+    if(!valid || shape_cursor + 2 > shape.size()) {
+        valid = false;
+        return nullptr;
+    }
+
+    R = shape[shape_cursor++];
+    C = shape[shape_cursor++];
+
+    if(data_cursor + R * C > data.size()) {
+        valid = false;
+        return nullptr;
+    }
+
+    const auto D = data.data() + data_cursor;
+    data_cursor += R * C;
+    return D;
+}
+
+bool state_archive::is_loading() const { return loading; }
+
+bool state_archive::is_valid() const { return valid && (!loading || (shape_cursor == shape.size() && data_cursor == data.size())); }
+
+const std::vector<double>& state_archive::get_data() const { return data; }
+
+const std::vector<uword>& state_archive::get_shape() const { return shape; }
+
+state_archive& state_archive::operator()(double& D) {
+    if(!loading) put(&D, 1, 1);
+    else if(uword R, C; const auto P = get(R, C)) {
+        if(1 == R && 1 == C) D = *P;
+        else valid = false;
+    }
+
+    return *this;
+}
+
+state_archive& state_archive::operator()(bool& D) {
+    auto flag = D ? 1. : 0.;
+    operator()(flag);
+    D = 0. != flag;
+
+    return *this;
+}
+
+state_archive& state_archive::operator()(mat& D) {
+    if(!loading) put(D.memptr(), D.n_rows, D.n_cols);
+    else if(uword R, C; const auto P = get(R, C)) {
+        // copy in place so that matrices hosted by an arena keep their memory
+        if(D.n_rows == R && D.n_cols == C) std::copy_n(P, R * C, D.memptr());
+        else D = mat(P, R, C);
+    }
+
+    return *this;
+}
+
+state_archive& state_archive::operator()(vec& D) {
+    if(!loading) put(D.memptr(), D.n_rows, D.n_cols);
+    else if(uword R, C; const auto P = get(R, C)) {
+        if(C > 1) valid = false;
+        else if(D.n_elem == R) std::copy_n(P, R, D.memptr());
+        else D = vec(P, R);
+    }
+
+    return *this;
+}
+
+state_archive& state_archive::operator()(cx_mat& D) {
+    mat real_part, imag_part;
+    if(!loading) {
+        real_part = real(D);
+        imag_part = imag(D);
+    }
+
+    operator()(real_part, imag_part);
+
+    if(loading) {
+        if(real_part.n_rows == imag_part.n_rows && real_part.n_cols == imag_part.n_cols) D = cx_mat(real_part, imag_part);
+        else valid = false;
+    }
+
+    return *this;
+}
+
+thread_local state_registry* state_registry::active = nullptr;
+
+state_registry* state_registry::enrol(Material* M) {
+    if(nullptr != active) active->material_pool.emplace_back(M);
+    return active;
+}
+
+state_registry* state_registry::enrol(Section* S) {
+    if(nullptr != active) active->section_pool.emplace_back(S);
+    return active;
+}
+
+void state_registry::withdraw(const Material* M) { std::erase(material_pool, M); }
+
+void state_registry::withdraw(const Section* S) { std::erase(section_pool, S); }
+
+state_registry::scope::scope(state_registry& R)
+    : previous(std::exchange(active, &R)) {}
+
+state_registry::scope::~scope() { active = previous; }
+
+state_registry::~state_registry() {
+    // enrolled objects may outlive the owner
+    for(const auto I : material_pool) I->registry = nullptr;
+    for(const auto I : section_pool) I->registry = nullptr;
+}
+
+void state_registry::archive(state_archive& A) const {
+    for(const auto I : section_pool) I->archive(A);
+    for(const auto I : material_pool) I->archive(A);
+}
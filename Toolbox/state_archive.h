@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class state_archive
+ * @brief A flat archive of the state of a model.
+ *
+ * The same `archive()` method of an object is used for both directions. When saving, each item is appended
+ * to the archive; when loading, items are read back in the same order. Shapes are stored alongside values so
+ * that a mismatch between the model and the archive is detected instead of silently misplacing data.
+ *
+ * Materials and sections copied while an element is initialised are enrolled to the element via
+ * `state_registry`, so that their states can be archived without changing each element.
+ * The enrolment only covers copies made within `Element::initialize()` on the calling thread.
+ * Objects created elsewhere, such as in the constructor of an element, and history variables
+ * stored in elements, orientations and integrators, shall be archived by overriding `archive()`.
+ *
+ * @author tlc
+ * @date 18/10/2026
+ * @version 0.1.0
+ * @file state_archive.h
+ * @addtogroup Utility
+ * @{
+ */
+
+#ifndef STATE_ARCHIVE_H
+#define STATE_ARCHIVE_H
+
+#include <suanPan.h>
+
+class Material;
+class Section;
+
+class state_archive final {
+    std::vector<double> data; // values of all items
+    std::vector<uword> shape; // number of rows and columns of each item
+
+    size_t data_cursor = 0, shape_cursor = 0;
+
+    const bool loading = false;
+
+    bool valid = true;
+
+    void put(const double*, uword, uword);
+    const double* get(uword&, uword&);
+
+public:
+    state_archive() = default;
+    state_archive(std::vector<double>&&, std::vector<uword>&&);
+
+    [[nodiscard]] bool is_loading() const;
+
+    /**
+     * \brief Check if all items match the archive, and when loading, if the archive is fully consumed.
+     */
+    [[nodiscard]] bool is_valid() const;
+
+    [[nodiscard]] const std::vector<double>& get_data() const;
+    [[nodiscard]] const std::vector<uword>& get_shape() const;
+
+    state_archive& operator()(double&);
+    state_archive& operator()(bool&);
+    state_archive& operator()(mat&);
+    state_archive& operator()(vec&);
+    state_archive& operator()(cx_mat&);
+
+    template<typename T, typename... U> requires(sizeof...(U) > 0) state_archive& operator()(T& first, U&... rest) {
+        operator()(first);
+        return operator()(rest...);
+    }
+};
+
+/**
+ * \brief A checkpoint read from file, applied to the domain once the step to resume is initialised.
+ */
+struct state_checkpoint {
+    static constexpr unsigned version = 1;
+
+    unsigned step_tag = 0; // the step in progress
+    double time_left = 0.; // the remaining time of the step
+    state_archive state;
+};
+
+class state_registry final {
+    static thread_local state_registry* active;
+
+    std::vector<Material*> material_pool;
+    std::vector<Section*> section_pool;
+
+    friend class Material;
+    friend class Section;
+
+    static state_registry* enrol(Material*);
+    static state_registry* enrol(Section*);
+    void withdraw(const Material*);
+    void withdraw(const Section*);
+
+public:
+    /**
+     * \brief Objects copied on the current thread are enrolled to the given registry during the lifetime of the scope.
+     */
+    class scope final {
+        state_registry* previous;
+
+    public:
+        explicit scope(state_registry&);
+        scope(const scope&) = delete;
+        scope(scope&&) = delete;
+        scope& operator=(const scope&) = delete;
+        scope& operator=(scope&&) = delete;
+        ~scope();
+    };
+
+    state_registry() = default;
+    state_registry(const state_registry&) = delete;
+    state_registry(state_registry&&) = delete;
+    state_registry& operator=(const state_registry&) = delete;
+    state_registry& operator=(state_registry&&) = delete;
+    ~state_registry();
+
+    void archive(state_archive&) const;
+};
+
+#endif
+
+//! @}
@@ -27,7 +27,8 @@
 namespace suanpan {
     template<sp_i IT, std::invocable<IT> F> void for_each(const IT start, const IT end, F&& FN) {
 #ifdef SUANPAN_MT
-        static tbb::affinity_partitioner ap;
+        // loops may be nested in concurrently running tasks, each thread keeps its own affinity record
+        static thread_local tbb::affinity_partitioner ap;
         tbb::parallel_for(start, end, std::forward<F>(FN), ap);
 #else
         for(IT I = start; I < end; ++I) FN(I);
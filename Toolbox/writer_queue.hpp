@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (C) 2017-2024 Theodore Chang
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ******************************************************************************/
+/**
+ * @class writer_queue
+ * @brief A single thread that performs output tasks in order.
+ *
+ * Recorders snapshot the data on the solver thread and push the formatting and writing into the queue,
+ * so that disk access overlaps with the following steps. The queue is bounded, producers are blocked when
+ * it is full so that memory held by pending snapshots is limited. `flush()` acts as a barrier that returns
+ * once all pending tasks are completed.
+ *
+ * All file output of recorders goes through the same queue, the underlying libraries (HDF5, VTK) are thus
+ * only accessed by one thread. Tasks can be tagged with an owner, typically the domain that produces them,
+ * `flush(owner)` only waits for tasks of the given owner so that models sharing the queue do not wait for
+ * the output pushed by others afterwards.
+ *
+ * @author tlc
+ * @date 18/10/2026
+ * @version 0.1.0
+ * @file writer_queue.hpp
+ * @addtogroup Utility
+ * @{
+ */
+
+#ifndef WRITER_QUEUE_HPP
+#define WRITER_QUEUE_HPP
+
+#include <suanPan.h>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+class writer_queue final {
+    const size_t capacity;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+
+    std::queue<std::pair<std::function<void()>, const void*>> tasks;
+    std::unordered_map<const void*, size_t> pending; // number of queued and running tasks of each owner
+
+    bool running = true;
+    bool busy = false;
+
+    std::thread worker;
+
+    void process() {
+        std::unique_lock lock(queue_mutex);
+        while(true) {
+            queue_cv.wait(lock, [this] { return !tasks.empty() || !running; });
+            if(tasks.empty()) return;
+
+            auto [task, owner] = std::move(tasks.front());
+            tasks.pop();
+            busy = true;
+            lock.unlock();
+            // producers may be waiting for a free slot
+            queue_cv.notify_all();
+
+            try { task(); }
+            catch(const std::exception& e) { suanpan_error("Fail to write output: {}.\n", e.what()); }
+
+            lock.lock();
+            busy = false;
+            if(const auto found = pending.find(owner); 0 == --found->second) pending.erase(found);
+            queue_cv.notify_all();
+        }
+    }
+
+public:
+    explicit writer_queue(const size_t C = 16)
+        : capacity(std::max(size_t{1}, C))
+        , worker(&writer_queue::process, this) {}
+
+    writer_queue(const writer_queue&) = delete;
+    writer_queue(writer_queue&&) = delete;
+    writer_queue& operator=(const writer_queue&) = delete;
+    writer_queue& operator=(writer_queue&&) = delete;
+
+    ~writer_queue() {
+        {
+            std::scoped_lock lock(queue_mutex);
+            running = false;
+        }
+        queue_cv.notify_all();
+        // pending tasks are completed before the thread exits
+        worker.join();
+    }
+
+    /**
+     * \brief Queue an output task, block if the queue is full.
+     * Tasks shall not push further tasks as the caller may be blocked by itself.
+     */
+    void push(std::function<void()>&& task, const void* owner = nullptr) {
+        {
+            std::unique_lock lock(queue_mutex);
+            queue_cv.wait(lock, [this] { return tasks.size() < capacity; });
+            tasks.emplace(std::move(task), owner);
+            ++pending[owner];
+        }
+        queue_cv.notify_all();
+    }
+
+    /**
+     * \brief Wait until all queued tasks are completed.
+     */
+    void flush() {
+        std::unique_lock lock(queue_mutex);
+        queue_cv.wait(lock, [this] { return tasks.empty() && !busy; });
+    }
+
+    /**
+     * \brief Wait until all queued tasks of the given owner are completed.
+     * Tasks of other owners queued ahead are still performed first as there is only one thread.
+     */
+    void flush(const void* owner) {
+        std::unique_lock lock(queue_mutex);
+        queue_cv.wait(lock, [&] { return !pending.contains(owner); });
+    }
+};
+
+namespace suanpan {
+    /**
+     * \brief The output queue shared by all recorders.
+     */
+    inline writer_queue& output_queue() {
+        static writer_queue queue;
+        return queue;
+    }
+} // namespace suanpan
+
+#endif
+
+//! @}
@@ -1,5 +1,6 @@
 #include <Domain/MetaMat/FullMat.hpp>
 #include <Toolbox/arpack.h>
+#include <Toolbox/lobpcg.h>
 #include <Toolbox/utility.h>
 #include "CatchHeader.h"
 
@@ -46,3 +47,35 @@ TEST_CASE("Eigensolver", "[Utility.Eigen]") {
             REQUIRE(Approx(cx_eigval(I).real()) == .5 * I + .5);
     }
 }
+
+TEST_CASE("Block Eigensolver", "[Utility.Eigen]") {
+    constexpr auto N = 100;
+    constexpr auto Q = 6;
+
+    const vec D = regspace(1, 1, N);
+
+    for(auto L = 0; L < 10; ++L) {
+        const mat P = orth(randn(D.n_elem, D.n_elem));
+
+        mat K = P * diagmat(D) * P.t();
+
+        auto KK = make_shared<FullMat<double>>(D.n_elem, D.n_elem);
+
+        for(auto I = 0llu; I < D.n_elem; ++I) for(auto J = 0llu; J < D.n_elem; ++J) KK->at(J, I) = K(J, I);
+
+        auto MM = make_shared<FullMat<double>>(D.n_elem, D.n_elem);
+
+        for(auto I = 0llu; I < D.n_elem; ++I) MM->at(I, I) = 2.;
+
+        vec eigval;
+        mat eigvec;
+
+        REQUIRE(lobpcg_solve(eigval, eigvec, KK, MM, Q) == 0);
+
+        for(auto I = 0; I < Q; ++I)
+            REQUIRE(Approx(eigval(I)) == .5 * I + .5);
+
+        // eigenvectors are mass orthonormal
+        REQUIRE(norm(eigvec.t() * MM->operator*(eigvec) - eye(Q, Q)) < 1E-10);
+    }
+}
@@ -0,0 +1,181 @@
+#include <Domain/DOF.h>
+#include <Element/Element.h>
+#include <Element/ElementArena.h>
+#include "CatchHeader.h"
+
+namespace {
+    class ArenaProbe final : public Element {
+    public:
+        ArenaProbe(const unsigned T, const unsigned S)
+            : Element(T, 1, S, uvec{1}, std::vector(S, DOF::U1)) { initialize(nullptr); }
+
+        using DataElement::current_resistance;
+        using DataElement::current_stiffness;
+        using DataElement::trial_resistance;
+        using DataElement::trial_stiffness;
+
+        // mimic what a typical element does in initialisation
+        int initialize(const shared_ptr<DomainBase>&) override {
+            const auto S = get_total_number();
+            trial_stiffness = current_stiffness = initial_stiffness = randu(S, S);
+            trial_resistance = current_resistance = randu(S);
+            return SUANPAN_SUCCESS;
+        }
+
+        int update_status() override {
+            trial_stiffness += 1.;
+            trial_resistance += 1.;
+            return SUANPAN_SUCCESS;
+        }
+
+        int clear_status() override { return Element::clear_status(); }
+
+        int commit_status() override { return Element::commit_status(); }
+
+        int reset_status() override { return Element::reset_status(); }
+
+        // no nodes are attached
+        void update_strain_energy() override {}
+
+        void update_kinetic_energy() override {}
+
+        void update_viscous_energy() override {}
+
+        void update_nonviscous_energy() override {}
+
+        void update_complementary_energy() override {}
+
+        void update_momentum() override {}
+    };
+
+    auto create_probe(const unsigned N) {
+        std::vector<shared_ptr<Element>> pool;
+        for(auto I = 1u; I <= N; ++I) pool.emplace_back(std::make_shared<ArenaProbe>(I, 2 + I % 3));
+        return pool;
+    }
+
+    ArenaProbe& probe(const shared_ptr<Element>& E) { return dynamic_cast<ArenaProbe&>(*E); }
+} // namespace
+
+TEST_CASE("Hosted Container", "[Element.Arena]") {
+    std::vector<double> pool(8);
+
+    mat owned(2, 2, fill::randu);
+    mat trial(pool.data(), 2, 2, false, false);
+    mat current(pool.data() + 4, 2, 2, false, false);
+
+    REQUIRE_FALSE(ElementArena::is_hosted(owned, owned));
+    REQUIRE_FALSE(ElementArena::is_hosted(trial, owned));
+    REQUIRE(ElementArena::is_hosted(trial, current));
+
+    // same size assignment writes into the bound memory
+    trial = owned;
+    REQUIRE(ElementArena::is_hosted(trial, current));
+    REQUIRE(trial.memptr() == pool.data());
+    REQUIRE(Approx(owned(1, 1)) == pool[3]);
+
+    // resizing detaches the container from the pool
+    trial.zeros(3, 3);
+    REQUIRE_FALSE(ElementArena::is_hosted(trial, current));
+    REQUIRE(trial.memptr() != pool.data());
+}
+
+TEST_CASE("Arena Commit And Reset", "[Element.Arena]") {
+    const auto pool = create_probe(10);
+
+    ElementArena arena(pool);
+
+    REQUIRE(arena.get_size() == 2 * std::transform_reduce(pool.cbegin(), pool.cend(), uword{0}, std::plus(), [](const shared_ptr<Element>& E) { return probe(E).trial_stiffness.n_elem + probe(E).trial_resistance.n_elem; }));
+
+    for(const auto& I : pool) {
+        REQUIRE(ElementArena::is_hosted(probe(I).trial_stiffness, probe(I).current_stiffness));
+        REQUIRE(ElementArena::is_hosted(probe(I).trial_resistance, probe(I).current_resistance));
+        I->update_status();
+    }
+
+    // elements skip hosted containers
+    for(const auto& I : pool) {
+        I->commit_status();
+        REQUIRE(norm(probe(I).trial_stiffness - probe(I).current_stiffness) > 1.);
+    }
+
+    arena.commit_status();
+
+    for(const auto& I : pool) {
+        REQUIRE(approx_equal(probe(I).trial_stiffness, probe(I).current_stiffness, "absdiff", 1E-14));
+        REQUIRE(approx_equal(probe(I).trial_resistance, probe(I).current_resistance, "absdiff", 1E-14));
+        I->update_status();
+        I->reset_status();
+    }
+
+    arena.reset_status();
+
+    for(const auto& I : pool) {
+        REQUIRE(approx_equal(probe(I).trial_stiffness, probe(I).current_stiffness, "absdiff", 1E-14));
+        REQUIRE(approx_equal(probe(I).trial_resistance, probe(I).current_resistance, "absdiff", 1E-14));
+    }
+}
+
+TEST_CASE("Arena Reallocation", "[Element.Arena]") {
+    const auto pool = create_probe(6);
+
+    ElementArena arena(pool);
+
+    // the third element grows its resistance, which is then handled by the element itself
+    auto& target = probe(pool[2]);
+    const auto old_size = target.trial_resistance.n_elem;
+    target.trial_resistance = randu(old_size + 2);
+
+    REQUIRE_FALSE(ElementArena::is_hosted(target.trial_resistance, target.current_resistance));
+    REQUIRE(ElementArena::is_hosted(target.trial_stiffness, target.current_stiffness));
+
+    for(const auto& I : pool) I->update_status();
+
+    arena.commit_status();
+    for(const auto& I : pool) I->commit_status();
+
+    for(const auto& I : pool) {
+        REQUIRE(probe(I).trial_resistance.n_elem == probe(I).current_resistance.n_elem);
+        REQUIRE(approx_equal(probe(I).trial_stiffness, probe(I).current_stiffness, "absdiff", 1E-14));
+        REQUIRE(approx_equal(probe(I).trial_resistance, probe(I).current_resistance, "absdiff", 1E-14));
+    }
+
+    // the neighbours stay bound to the pool
+    REQUIRE(ElementArena::is_hosted(probe(pool[1]).trial_resistance, probe(pool[1]).current_resistance));
+    REQUIRE(ElementArena::is_hosted(probe(pool[3]).trial_resistance, probe(pool[3]).current_resistance));
+}
+
+TEST_CASE("Arena Reinitialisation", "[Element.Arena]") {
+    const auto pool = create_probe(6);
+
+    auto arena = std::make_unique<ElementArena>(pool);
+
+    // initialisation with unchanged sizes writes into the pools
+    for(const auto& I : pool) I->initialize(nullptr);
+    for(const auto& I : pool) REQUIRE(ElementArena::is_hosted(probe(I).trial_stiffness, probe(I).current_stiffness));
+
+    std::vector<mat> reference;
+    for(const auto& I : pool) reference.emplace_back(probe(I).trial_stiffness);
+
+    // memory is handed back to elements when the arena is released
+    arena.reset();
+
+    for(auto I = 0llu; I < pool.size(); ++I) {
+        REQUIRE_FALSE(ElementArena::is_hosted(probe(pool[I]).trial_stiffness, probe(pool[I]).current_stiffness));
+        REQUIRE(approx_equal(probe(pool[I]).trial_stiffness, reference[I], "absdiff", 1E-14));
+    }
+
+    // a new arena can be assigned after elements are initialised again
+    for(const auto& I : pool) I->initialize(nullptr);
+
+    arena = std::make_unique<ElementArena>(pool);
+
+    for(const auto& I : pool) {
+        I->update_status();
+        REQUIRE(ElementArena::is_hosted(probe(I).trial_stiffness, probe(I).current_stiffness));
+    }
+
+    arena->commit_status();
+
+    for(const auto& I : pool) REQUIRE(approx_equal(probe(I).trial_stiffness, probe(I).current_stiffness, "absdiff", 1E-14));
+}
@@ -0,0 +1,30 @@
+#include <Load/Load.h>
+#include "CatchHeader.h"
+
+TEST_CASE("Grouped Load Reduction", "[Utility.Load]") {
+    constexpr auto N = 1000llu;
+
+    std::vector<LoadContribution> pool(20);
+    for(auto& I : pool) {
+        // duplicated indices are summed
+        const uvec index = randi<uvec>(200, distr_param(0, N - 1));
+        I.insert(index, randn<vec>(index.n_elem));
+        I.insert(index.head(10), 1.);
+    }
+
+    vec reference(N, fill::zeros);
+    for(const auto& I : pool) I.scatter(reference, 0, N);
+
+    for(const auto n_chunk : {1llu, 2llu, 3llu, 7llu, 16llu, N}) {
+        const auto width = (N + n_chunk - 1) / n_chunk;
+        const auto n_group = (N + width - 1) / width;
+
+        vec result(N, fill::zeros);
+        for(const auto& I : pool) I.group(width, n_group);
+        for(auto G = 0llu; G < n_group; ++G)
+            for(const auto& I : pool) I.scatter_group(result, G);
+
+        // the order of summation of each entry is unchanged
+        REQUIRE(approx_equal(result, reference, "absdiff", 1E-15));
+    }
+}
@@ -1,4 +1,6 @@
+#include <Domain/Factory.hpp>
 #include <Domain/MetaMat/MetaMat>
+#include <Toolbox/shape.h>
 #include "CatchHeader.h"
 
 template<typename MT, typename ET, std::invocable T> void test_mat_solve(MT& A, const Mat<ET>& D, const Col<ET>& C, T clear_mat) {
@@ -319,6 +321,109 @@ TEST_CASE("BandMatSpike", "[Matrix.Dense]") { test_dense_mat_setup<double>(creat
 
 TEST_CASE("BandSymmMat", "[Matrix.Dense]") { test_dense_mat_setup<double>(create_new<BandSymmMat<double>>); }
 
+TEST_CASE("DiagMat", "[Matrix.Dense]") {
+    constexpr auto tol = std::numeric_limits<double>::epsilon() * 1000;
+    for(auto I = 0; I < 100; ++I) {
+        const auto N = randi<uword>(distr_param(100, 200));
+        DiagMat<double> A(N);
+        REQUIRE(A.n_rows == N);
+        REQUIRE(A.n_cols == N);
+
+        const vec B = randu<vec>(N) + 1.;
+
+        auto clear_mat = [&] {
+            A.zeros();
+            for(auto J = 0llu; J < N; ++J) A.at(J, J) = B(J);
+            // off-diagonal entries are discarded
+            A.at(0, N - 1) = 1.;
+        };
+
+        const vec C = randu<vec>(N);
+
+        clear_mat();
+
+        REQUIRE(Approx(0.) == A(0, N - 1));
+        REQUIRE(arma::norm(A * C - B % C) < tol);
+
+        test_mat_solve(A, (C / B).eval(), C, clear_mat);
+    }
+}
+
+TEST_CASE("Lumped Mass", "[Matrix.Dense]") {
+    // consistent mass of an eight-node serendipity element with unit density on [-1, 1]^2
+    mat scalar(8, 8, fill::zeros);
+    const vec point{-std::sqrt(.6), 0., std::sqrt(.6)}, weight{5. / 9., 8. / 9., 5. / 9.};
+    for(auto I = 0llu; I < 3; ++I)
+        for(auto J = 0llu; J < 3; ++J) {
+            const rowvec n = shape::quad(vec{point(I), point(J)}, 0, 8);
+            scalar += weight(I) * weight(J) * n.t() * n;
+        }
+
+    mat element_mass(16, 16, fill::zeros);
+    for(auto I = 0llu; I < 8; ++I)
+        for(auto J = 0llu; J < 8; ++J) element_mass(2 * I, 2 * J) = element_mass(2 * I + 1, 2 * J + 1) = scalar(I, J);
+
+    // row sum lumping gives negative corner masses
+    REQUIRE(accu(element_mass.row(0)) < 0.);
+
+    const mat element_stiffness = element_mass + 10. * eye(16, 16);
+
+    // two elements sharing one edge
+    auto to_dof = [](const uvec& node) {
+        uvec dof(2 * node.n_elem);
+        for(auto I = 0llu; I < node.n_elem; ++I) dof(2 * I + 1) = (dof(2 * I) = 2 * node(I)) + 1;
+        return dof;
+    };
+    const std::vector encoding{to_dof(uvec{0, 1, 2, 3, 4, 5, 6, 7}), to_dof(uvec{1, 8, 9, 2, 10, 11, 12, 5})};
+
+    constexpr auto N = 26u;
+
+    auto create_factory = [&](const bool lumped, const mat& mass) {
+        const auto W = std::make_shared<Factory<double>>(N, AnalysisType::DYNAMICS, StorageScheme::FULL);
+        W->set_lumped_mass(lumped);
+        W->initialize();
+        W->clear_mass();
+        W->clear_stiffness();
+        for(const auto& I : encoding) {
+            W->assemble_mass(mass, I, {}, {});
+            W->assemble_stiffness(element_stiffness, I, {}, {});
+        }
+        return W;
+    };
+
+    // full storage with element matrices lumped beforehand
+    const mat hrz = diagmat(element_mass.diag() * accu(element_mass) / trace(element_mass));
+
+    const auto lumped = create_factory(true, element_mass);
+    const auto consistent = create_factory(false, element_mass);
+    const auto reference = create_factory(false, hrz);
+
+    const vec lumped_diag = lumped->get_mass()->diag();
+    REQUIRE(all(lumped_diag > 0.));
+    // total mass is preserved
+    REQUIRE(Approx(accu(lumped_diag)) == accu(consistent->get_mass()->operator*(mat(N, 1, fill::ones))));
+
+    // only the mass is lumped
+    REQUIRE(Approx(lumped->get_stiffness()->operator()(0, 2)) == element_stiffness(0, 2));
+
+    // a few central difference steps
+    const vec load = randn<vec>(N);
+    constexpr auto dt = 1E-2;
+    auto integrate = [&](const shared_ptr<Factory<double>>& W) {
+        vec u_previous(N, fill::zeros), u_current(N, fill::zeros);
+        for(auto I = 0; I < 10; ++I) {
+            mat acceleration;
+            REQUIRE(SUANPAN_SUCCESS == W->get_mass()->solve(acceleration, load - W->get_stiffness()->operator*(u_current)));
+            const vec u_next = 2. * u_current - u_previous + dt * dt * acceleration;
+            u_previous = u_current;
+            u_current = u_next;
+        }
+        return u_current;
+    };
+
+    REQUIRE(norm(integrate(lumped) - integrate(reference)) < 1E-12 * norm(integrate(reference)));
+}
+
 TEST_CASE("FullMatFloat", "[Matrix.Dense]") { test_dense_mat_setup<float>(create_new<FullMat<float>>); }
 
 TEST_CASE("SymmPackMatFloat", "[Matrix.Dense]") { test_dense_mat_setup<float>(create_new<SymmPackMat<float>>); }
@@ -333,6 +438,96 @@ TEST_CASE("SparseMatSuperLU", "[Matrix.Sparse]") { test_sparse_mat_setup<double>
 
 TEST_CASE("SparseMatSuperLUFloat", "[Matrix.Sparse]") { test_sparse_mat_setup<float>(create_new<SparseMatSuperLU<float>>); }
 
+template<typename T> void test_sparse_mat_refactorisation(T A) {
+    const auto N = A.n_rows;
+
+    sp_mat B = sprandu(N, N, .05);
+    B = B + B.t() + speye(N, N) * N;
+
+    for(auto K = 0; K < 3; ++K) {
+        A.zeros();
+        for(auto I = B.begin(); I != B.end(); ++I) A.at(I.row(), I.col()) = (K + 1.) * *I;
+
+        // a structural entry that vanishes in the second round shall not alter the pattern
+        const auto corner = 1 == K ? 0. : 1.;
+        A.at(0, N - 1) = A.at(N - 1, 0) = corner;
+
+        const vec C = randu<vec>(N);
+        vec D;
+        A.solve(D, C);
+
+        sp_mat E = (K + 1.) * B;
+        E(0, N - 1) += corner;
+        E(N - 1, 0) += corner;
+
+        REQUIRE(norm(E * D - C) < 1E-10);
+    }
+
+    REQUIRE(A.get_symbolic_counter() == 1);
+    REQUIRE(A.get_numeric_counter() == 3);
+
+    A.zeros();
+    for(auto I = 0llu; I < N; ++I) A.at(I, I) = 1.;
+
+    const vec C = randu<vec>(N);
+    vec D;
+    A.solve(D, C);
+
+    REQUIRE(norm(D - C) < 1E-10);
+    REQUIRE(A.get_symbolic_counter() == 2);
+}
+
+template<typename T> void test_mat_inertia(T A) {
+    const auto N = A.n_rows;
+
+    sp_mat B = sprandu(N, N, .05);
+    B = B + B.t();
+    B.diag() = regspace(1., static_cast<double>(N)) - N / 2. - .5;
+
+    for(auto I = B.begin(); I != B.end(); ++I) A.at(I.row(), I.col()) = *I;
+
+    const vec eigval = eig_sym(mat(B));
+
+    REQUIRE(A.inertia() == static_cast<uword>(accu(eigval < 0.)));
+
+    // the matrix remains usable for solving
+    const vec C = randu<vec>(N);
+    vec D;
+    A.solve(D, C);
+
+    REQUIRE(norm(B * D - C) < 1E-10);
+}
+
+TEST_CASE("FullMat Inertia", "[Matrix.Dense]") { test_mat_inertia(FullMat<double>(100, 100)); }
+
+TEST_CASE("SparseMatSuperLU Inertia", "[Matrix.Sparse]") {
+    test_mat_inertia(SparseMatSuperLU<double>(100, 100));
+
+    SparseMatSuperLU<double> A(2, 2);
+    A.at(0, 0) = A.at(1, 1) = 1.;
+    A.at(0, 1) = A.at(1, 0) = 2.;
+
+    REQUIRE(A.inertia() == 1);
+
+    // a tiny diagonal requires off-diagonal pivots, which are only taken if the original options are restored
+    A.zeros();
+    A.at(0, 0) = 1E-20;
+    A.at(1, 1) = 1.;
+    A.at(0, 1) = A.at(1, 0) = 1.;
+
+    vec X;
+    REQUIRE(SUANPAN_SUCCESS == A.solve(X, vec{1., 2.}));
+    REQUIRE(approx_equal(X, vec{1., 1.}, "absdiff", 1E-12));
+}
+
+TEST_CASE("SparseSymmMatMUMPS Inertia", "[Matrix.Sparse]") { test_mat_inertia(SparseSymmMatMUMPS<double>(100, 100)); }
+
+TEST_CASE("SparseMatSuperLU Refactorisation", "[Matrix.Sparse]") { test_sparse_mat_refactorisation(SparseMatSuperLU<double>(100, 100)); }
+
+TEST_CASE("SparseMatMUMPS Refactorisation", "[Matrix.Sparse]") { test_sparse_mat_refactorisation(SparseMatMUMPS<double>(100, 100)); }
+
+TEST_CASE("SparseSymmMatMUMPS Refactorisation", "[Matrix.Sparse]") { test_sparse_mat_refactorisation(SparseSymmMatMUMPS<double>(100, 100)); }
+
 TEST_CASE("SparseMatMUMPS", "[Matrix.Sparse]") { test_sparse_mat_setup<double>(create_new<SparseMatMUMPS<double>>); }
 
 TEST_CASE("SparseMatMUMPSFloat", "[Matrix.Sparse]") { test_sparse_mat_setup<float>(create_new<SparseMatMUMPS<float>>); }
@@ -410,6 +605,103 @@ TEST_CASE("Triplet/CSR/CSC Sparse", "[Matrix.Sparse]") {
     }
 }
 
+TEST_CASE("Condensed Triplet Product", "[Matrix.Sparse]") {
+    for(const auto N : {100llu, 2000llu}) {
+        const sp_mat A = sprandu<sp_mat>(N, N, 10. / static_cast<double>(N)) + speye(N, N);
+
+        const triplet_form<double, uword> B(A);
+
+        auto C = B, D = B;
+        C.csr_condense();
+        D.csc_condense();
+
+        for(const auto M : {1llu, 3llu, 8llu}) {
+            const mat E(N, M, fill::randn);
+
+            const mat F = A * E;
+
+            REQUIRE(norm(F - B * E) <= 1E-12);
+            REQUIRE(norm(F - C * E) <= 1E-12);
+            REQUIRE(norm(F - D * E) <= 1E-12);
+        }
+
+        const vec G(N, fill::randn);
+
+        REQUIRE(norm(A * G - C * G) <= 1E-12);
+        REQUIRE(norm(A * G - D * G) <= 1E-12);
+    }
+}
+
+TEST_CASE("Frozen Sparse Pattern", "[Matrix.Sparse]") {
+    constexpr auto N = 20u;
+
+    Factory<double> W(N, AnalysisType::STATICS, StorageScheme::SPARSE);
+    W.initialize();
+
+    // a chain of two-node elements
+    std::vector<uvec> encoding;
+    for(auto I = 0llu; I < N - 1; ++I) encoding.emplace_back(uvec{I, I + 1});
+
+    triplet_form<double, uword> pattern(N, N);
+    for(const auto& I : encoding) pattern.assemble(mat(2, 2, fill::ones), I);
+    pattern.csc_condense();
+
+    std::vector<uvec> mapping;
+    for(const auto& I : encoding) mapping.emplace_back(pattern.locate(I));
+
+    pattern.zeros_val();
+    W.set_sparse_pattern(std::move(pattern));
+
+    auto& K = W.get_stiffness();
+
+    const uword* storage = nullptr;
+
+    for(auto round = 0; round < 3; ++round) {
+        W.clear_stiffness();
+
+        // values are cleared in place
+        if(nullptr != storage) REQUIRE(storage == K->triplet_mat.row_mem());
+        storage = K->triplet_mat.row_mem();
+
+        mat reference(N, N, fill::zeros);
+        for(auto I = 0llu; I < encoding.size(); ++I) {
+            const mat element(2, 2, fill::randu);
+            W.assemble_stiffness(element, encoding[I], {}, mapping[I]);
+            reference(encoding[I], encoding[I]) += element;
+        }
+
+        REQUIRE(K->triplet_mat.has_same_pattern(W.get_sparse_pattern()));
+        REQUIRE(norm(K->operator*(mat(N, N, fill::eye)) - reference) <= 1E-12);
+    }
+
+    // entries outside the pattern are discarded on clearing
+    K->at(0, N - 1) = 1.;
+    W.clear_stiffness();
+
+    REQUIRE(K->triplet_mat.has_same_pattern(W.get_sparse_pattern()));
+    REQUIRE(accu(abs(K->operator*(mat(N, N, fill::eye)))) == 0.);
+}
+
+TEST_CASE("Benchmark Triplet Product", "[Matrix.Benchmark]") {
+    constexpr auto N = 100000llu;
+
+    const triplet_form<double, uword> B(sp_mat(sprandu<sp_mat>(N, N, 20. / static_cast<double>(N)) + speye(N, N)));
+
+    auto C = B, D = B;
+    C.csr_condense();
+    D.csc_condense();
+
+    for(const auto M : {1llu, 8llu}) {
+        const mat E(N, M, fill::randn);
+
+        BENCHMARK(string("Triplet " + std::to_string(M)).c_str()) { return B * E; };
+
+        BENCHMARK(string("CSR " + std::to_string(M)).c_str()) { return C * E; };
+
+        BENCHMARK(string("CSC " + std::to_string(M)).c_str()) { return D * E; };
+    }
+}
+
 TEST_CASE("Benchmark Triplet Assembly", "[Matrix.Sparse]") {
     constexpr unsigned long long N = 1024;
     constexpr unsigned long long REPEAT = 8;
@@ -568,6 +860,31 @@ TEST_CASE("Unify SparseMatMUMPS", "[Matrix.Utility]") { test_sparse_mat_unify(Sp
 TEST_CASE("Unify SparseMatPARDISO", "[Matrix.Utility]") { test_sparse_mat_unify(SparseMatPARDISO<double>(10, 10)); }
 #endif
 
+TEST_CASE("Batched Unify SparseMat", "[Matrix.Utility]") {
+    constexpr auto N = 20;
+
+    const sp_mat B = sprandu(N, N, .4) + speye(N, N);
+
+    SparseMatSuperLU<double> A(N, N), C(N, N);
+    for(auto I = B.begin(); I != B.end(); ++I) A.at(I.row(), I.col()) = C.at(I.row(), I.col()) = *I;
+
+    const uvec dof{1, 4, 7, 13};
+
+    A.unify(dof);
+    for(const auto I : dof) C.unify(I);
+
+    A.csc_condense();
+    C.csc_condense();
+
+    for(auto I = 0; I < N; ++I)
+        for(auto J = 0; J < N; ++J) REQUIRE(Approx(A(I, J)) == C(I, J));
+
+    A.nullify(dof);
+    A.csc_condense();
+
+    for(const auto I : dof) REQUIRE(Approx(A(I, I)) == 0.);
+}
+
 #ifdef SUANPAN_CUDA
 TEST_CASE("Unify SparseMatCUDA", "[Matrix.Utility]") { test_sparse_mat_unify(SparseMatCUDA<double>(10, 10)); }
 
@@ -0,0 +1,487 @@
+#include <Domain/DomainBase.h>
+#include <Domain/Factory.hpp>
+#include <Domain/Node.h>
+#include <Element/Element.h>
+#include <Recorder/NodeRecorder.h>
+#include <Recorder/SumRecorder.h>
+#include <Step/Bead.h>
+#include <Toolbox/command.h>
+#include <Toolbox/writer_queue.hpp>
+#include "CatchHeader.h"
+
+#ifdef SUANPAN_HDF5
+#include <hdf5.h>
+#include <hdf5_hl.h>
+#endif
+
+extern fs::path SUANPAN_OUTPUT;
+
+namespace {
+    shared_ptr<Bead> create_model(const string& source) {
+        auto model = make_shared<Bead>();
+
+        istringstream input(source);
+        for(string line; std::getline(input, line);)
+            if(istringstream command(line); SUANPAN_EXIT == process_command(model, command)) break;
+
+        return model;
+    }
+
+    vec get_displacement(const shared_ptr<Bead>& model, const unsigned tag) { return model->get_current_domain()->get_node(tag)->get_current_displacement(); }
+
+    // always sample by looking up nodes
+    template<typename T> class LookupRecorder final : public T {
+    public:
+        using T::T;
+
+        void initialize(const shared_ptr<DomainBase>& D) override {
+            T::initialize(D);
+            this->set_column_layout({});
+        }
+    };
+
+    const string truss_model = R"(
+node 1 0 0
+node 2 4 0
+node 3 0 -3
+material MPF 1 100 5 .1
+material MPF 2 100 5 .1 20. 18.5 .15 .01 7. true
+element T2D2 1 1 2 1 10
+element T2D2 2 3 2 2 10
+)";
+} // namespace
+
+TEST_CASE("JFNK Static", "[Model.Solver]") {
+    auto analyze = [](const string& solver) {
+        const auto model = create_model(truss_model + R"(
+fix2 1 P 1 3
+step static 1
+set ini_step_size 1E-1
+set fixed_step_size 1
+set sparse_mat 1
+cload 1 0 100 2 2
+converger RelIncreDisp 1 1E-12 50 1
+)" + solver);
+
+        REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+        return get_displacement(model, 2);
+    };
+
+    const auto reference = analyze("solver Newton 1");
+
+    REQUIRE(norm(reference) > 1.);
+    REQUIRE(approx_equal(analyze("solver JFNK 1"), reference, "reldiff", 1E-8));
+    REQUIRE(approx_equal(analyze("solver JFNK 1 true"), reference, "reldiff", 1E-6));
+    REQUIRE(approx_equal(analyze("solver JFNK 1 false false"), reference, "reldiff", 1E-8));
+}
+
+TEST_CASE("JFNK Dynamic", "[Model.Solver]") {
+    auto analyze = [](const string& solver) {
+        const auto model = create_model(truss_model + R"(
+mass 3 2 10 1 2
+fix 1 P 1 3
+step dynamic 1 1
+set ini_step_size 5E-2
+set fixed_step_size 1
+set sparse_mat 1
+cload 1 0 100 2 2
+integrator Newmark 1
+converger RelIncreDisp 1 1E-12 50 1
+)" + solver);
+
+        REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+        return get_displacement(model, 2);
+    };
+
+    const auto reference = analyze("solver Newton 1");
+
+    REQUIRE(norm(reference) > 1E-2);
+    REQUIRE(approx_equal(analyze("solver JFNK 1"), reference, "reldiff", 1E-6));
+}
+
+TEST_CASE("JFNK Followed By Newton", "[Model.Solver]") {
+    const auto model = create_model(truss_model + R"(
+fix2 1 P 1 3
+step static 1
+set ini_step_size 1E-1
+set fixed_step_size 1
+cload 1 0 50 2 2
+converger RelIncreDisp 1 1E-12 50 1
+solver JFNK 1
+step static 2
+set ini_step_size 1E-1
+set fixed_step_size 1
+cload 2 0 50 2 2
+converger RelIncreDisp 2 1E-12 50 1
+solver Newton 2
+)");
+
+    // the global stiffness is allocated again for the second step
+    REQUIRE(SUANPAN_SUCCESS == model->analyze());
+    REQUIRE(nullptr != model->get_current_domain()->get_factory()->get_stiffness());
+}
+
+TEST_CASE("JFNK Linear Solver Failure", "[Model.Solver]") {
+    // the two degrees of freedom are coupled so that the diagonal preconditioner does not give the exact solution
+    const auto model = create_model(R"(
+node 1 0 0
+node 2 4 0
+node 3 0 -3
+material Elastic1D 1 100
+element T2D2 1 1 2 1 10
+element T2D2 2 3 2 1 10
+fix2 1 P 1 3
+step static 1
+set fixed_step_size 1
+set linear_system
+set tolerance 0
+cload 1 0 100 2 2
+solver JFNK 1
+)");
+
+    // the forcing term cannot be reached
+    REQUIRE(SUANPAN_FAIL == model->analyze());
+    REQUIRE(norm(get_displacement(model, 2)) < 1E-12);
+}
+
+TEST_CASE("Modal Dynamic Step Load", "[Model.Step]") {
+    // a cantilever with a single lumped mass, the lateral stiffness is 300
+    constexpr auto mass = 10., force = 10., period = 1.;
+
+    const auto omega = std::sqrt(30.);
+
+    for(const auto zeta : {0., .05}) {
+        const auto model = create_model(R"(
+node 1 0 0
+node 2 0 1
+material Elastic1D 1 100 0
+element EB21 1 1 2 10 1 1 0
+mass 2 2 10 1
+fix2 1 P 1
+step frequency 1 1
+set band_mat 0
+)" + std::string("step ModalDynamic 2 ") + std::to_string(period) + " " + std::to_string(zeta) + R"(
+set ini_step_size .01
+amplitude Constant 1
+cload 1 1 10 1 2
+)");
+
+        REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+        const auto& t_node = model->get_current_domain()->get_node(2);
+
+        // closed-form response of a damped oscillator to a step load from rest
+        const auto root = std::sqrt(1. - zeta * zeta);
+        const auto decay = std::exp(-zeta * omega * period);
+        const auto static_deflection = force / mass / omega / omega;
+        const auto u = static_deflection * (1. - decay * (std::cos(root * omega * period) + zeta / root * std::sin(root * omega * period)));
+        const auto v = static_deflection * omega / root * decay * std::sin(root * omega * period);
+
+        REQUIRE(t_node->get_current_displacement()(0) == Approx(u).epsilon(1E-8));
+        REQUIRE(t_node->get_current_velocity()(0) == Approx(v).epsilon(1E-8));
+    }
+}
+
+TEST_CASE("Harmonic Response", "[Model.Step]") {
+    // the same cantilever, the load is condensed to the lumped mass
+    const auto model = create_model(R"(
+node 1 0 0
+node 2 0 1
+material Elastic1D 1 100 0
+element EB21 1 1 2 10 1 1 0
+mass 2 2 10 1
+fix2 1 P 1
+recorder 1 plain Node U1 2
+step Harmonic 1 1 4 4
+cload 1 0 10 1 2
+)");
+
+    REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+    const auto sample = model->get_current_domain()->get_recorder(1)->get_sample();
+
+    // the initial state is recorded before the sweep
+    REQUIRE(sample.size() == 1);
+    REQUIRE(sample[0].n_cols == 5);
+    REQUIRE(norm(sample[0].col(0)) < 1E-12);
+
+    const mat response = sample[0].tail_cols(4);
+    const rowvec omega = response.row(0);
+    REQUIRE(approx_equal(omega, rowvec{1., 2., 3., 4.}, "absdiff", 1E-12));
+    REQUIRE(approx_equal(response.row(1), 10. / (300. - 10. * square(omega)), "reldiff", 1E-10));
+
+    // the state prior to the step is restored
+    REQUIRE(norm(get_displacement(model, 2)) < 1E-12);
+}
+
+TEST_CASE("Harmonic History", "[Model.Step]") {
+    const auto static_model = truss_model + R"(
+mass 3 2 10 1 2
+fix2 1 P 1 3
+step static 1
+set ini_step_size 1E-1
+set fixed_step_size 1
+set sparse_mat 1
+cload 1 0 100 2 2
+converger RelIncreDisp 1 1E-12 50 1
+)";
+
+    const auto reference = create_model(static_model);
+    REQUIRE(SUANPAN_SUCCESS == reference->analyze());
+
+    const auto model = create_model(static_model + "step Harmonic 2 1 4 4\n");
+    REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+    // the hysteretic material is not driven by the frequency sweep
+    REQUIRE(approx_equal(get_displacement(model, 2), get_displacement(reference, 2), "absdiff", 1E-12));
+    for(const auto tag : {1u, 2u}) REQUIRE(approx_equal(model->get_current_domain()->get_element(tag)->get_current_resistance(), reference->get_current_domain()->get_element(tag)->get_current_resistance(), "absdiff", 1E-12));
+}
+
+TEST_CASE("Ensemble Output Folder", "[Model.Output]") {
+    const auto root = fs::temp_directory_path() / "suanpan-ensemble";
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    // the linear truss is driven by two records, the second one is twice the first one
+    for(const auto& [name, scale] : {std::pair{"record-a", 1.}, std::pair{"record-b", 2.}}) {
+        const mat record{{0., 0.}, {1., scale}};
+        REQUIRE(record.save((root / name).replace_extension(".txt").string(), raw_ascii));
+    }
+
+    std::ofstream((root / "model.supan").string()) << R"(
+node 1 0 0
+node 2 4 0
+node 3 0 -3
+material Elastic1D 1 100
+element T2D2 1 1 2 1 10
+element T2D2 2 3 2 1 10
+fix2 1 P 1 3
+amplitude Tabular 1 record.txt
+plainrecorder 1 Node U2 2
+step static 1
+set ini_step_size .5
+set fixed_step_size 1
+cload 1 1 100 2 2
+analyze
+)";
+
+    const auto original_output = SUANPAN_OUTPUT;
+    SUANPAN_OUTPUT = root;
+
+    const auto model = make_shared<Bead>();
+    istringstream command("ensemble " + (root / "model.supan").generic_string() + " 1 " + (root / "record-a.txt").generic_string() + " " + (root / "record-b.txt").generic_string());
+    process_command(model, command);
+    suanpan::output_queue().flush();
+
+    SUANPAN_OUTPUT = original_output;
+
+    auto load_history = [](const fs::path& folder) {
+        std::vector<fs::path> file_list;
+        for(const auto& I : fs::directory_iterator(folder)) file_list.emplace_back(I.path());
+        REQUIRE(file_list.size() == 1);
+
+        mat history;
+        REQUIRE(history.load(file_list.front().string(), raw_ascii));
+        return history;
+    };
+
+    // nothing is written to the global folder, each member writes to its own
+    for(const auto& I : fs::directory_iterator(root)) REQUIRE((I.is_directory() || I.path().extension() == ".txt" || I.path().extension() == ".supan"));
+    const mat history_a = load_history(root / "record-a"), history_b = load_history(root / "record-b");
+
+    REQUIRE(history_a.n_rows == 3);
+    REQUIRE(std::fabs(history_a(1, 1)) > 1E-6);
+    REQUIRE(approx_equal(history_b.col(1), 2. * history_a.col(1), "reldiff", 1E-10));
+
+    fs::remove_all(root);
+}
+
+TEST_CASE("Gathered Node Output", "[Model.Output]") {
+    const auto model = create_model(R"(
+node 1 0 0
+node 2 4 0
+node 3 0 -3
+material Elastic1D 1 100 1
+element T2D2 1 1 2 1 10
+element T2D2 2 3 2 1 10
+mass 3 2 10 1 2
+modifier Rayleigh 4 .2 .002 0 0
+fix 1 P 1 3
+step dynamic 1 1
+set ini_step_size .1
+set fixed_step_size 1
+cload 1 0 100 2 2
+integrator Newmark 1
+converger RelIncreDisp 1 1E-10 20 1
+)");
+
+    const auto& t_domain = model->get_current_domain();
+
+    const std::vector<string> node_type{"U", "V", "A", "RF", "DF", "IF", "GDF", "GIF"};
+    const std::vector<string> scalar_type{"U1", "U2", "UR3", "V1", "V2", "A1", "A2", "RF1", "RF2", "RM1", "DF1", "DF2", "IF1", "IF2", "GDF1", "GDF2", "GDM1", "GIF1", "GIF2", "GIM1"};
+
+    // pairs of recorders with and without gathering
+    auto tag = 0u;
+    std::vector<std::pair<shared_ptr<Recorder>, shared_ptr<Recorder>>> pool;
+    auto add_pair = [&]<typename T>(const string& type) {
+        tag += 2;
+        pool.emplace_back(make_shared<T>(tag - 1, uvec{1, 2}, to_token(type), 1, true, false), make_shared<LookupRecorder<T>>(tag, uvec{1, 2}, to_token(type), 1, true, false));
+    };
+    for(const auto& I : node_type) add_pair.operator()<NodeRecorder>(I);
+    for(const auto& I : scalar_type) {
+        add_pair.operator()<NodeRecorder>(I);
+        add_pair.operator()<SumRecorder>(I);
+    }
+    for(const auto& [gathered, lookup] : pool) {
+        REQUIRE(t_domain->insert(gathered));
+        REQUIRE(t_domain->insert(lookup));
+    }
+
+    REQUIRE(SUANPAN_SUCCESS == model->analyze());
+    REQUIRE(norm(pool.front().first->get_sample().back().row(1)) > 1E-3);
+
+    auto compare = [&] {
+        for(const auto& [gathered, lookup] : pool) {
+            const auto gathered_sample = gathered->get_sample(), lookup_sample = lookup->get_sample();
+            REQUIRE(gathered_sample.size() == lookup_sample.size());
+            for(size_t I = 0; I < gathered_sample.size(); ++I) {
+                REQUIRE(gathered_sample[I].n_rows == lookup_sample[I].n_rows);
+                REQUIRE(gathered_sample[I].n_cols == lookup_sample[I].n_cols);
+                REQUIRE(approx_equal(gathered_sample[I], lookup_sample[I], "absdiff", 1E-12));
+            }
+        }
+    };
+
+    compare();
+
+    // the deactivated node is no longer sampled by either path
+    t_domain->get_node(2)->disable();
+    for(const auto& [gathered, lookup] : pool) {
+        gathered->record(t_domain);
+        lookup->record(t_domain);
+    }
+    t_domain->get_node(2)->enable();
+
+    compare();
+}
+
+#ifdef SUANPAN_HDF5
+TEST_CASE("Streamed Sparse Pattern Change", "[Model.Output]") {
+    const auto root = fs::temp_directory_path() / "suanpan-stream";
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    {
+        const auto model = create_model(truss_model + R"(
+hdf5recorder 1 Global K
+fix2 1 P 1 3
+step static 1
+set ini_step_size .5
+set fixed_step_size 1
+cload 1 0 10 2 2
+)");
+
+        const auto& t_domain = model->get_current_domain();
+        t_domain->set_output_path(root);
+
+        REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+        // a new element couples the supports so that the pattern grows
+        istringstream command("element T2D2 3 1 3 1 10");
+        process_command(model, command);
+        REQUIRE(SUANPAN_SUCCESS == t_domain->restart());
+
+        const auto& t_recorder = t_domain->get_recorder(1);
+        t_recorder->record(t_domain);
+        t_recorder->save();
+    }
+
+    const auto file_id = H5Fopen((root / "R1-K.h5").generic_string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    REQUIRE(file_id >= 0);
+
+    auto get_dimension = [&](const string& name) {
+        hsize_t dimension[2]{0, 0};
+        REQUIRE(H5Lexists(file_id, name.c_str(), H5P_DEFAULT) > 0);
+        H5LTget_dataset_info(file_id, name.c_str(), dimension, nullptr, nullptr);
+        return std::pair{dimension[0], dimension[1]};
+    };
+
+    // each group holds its own pattern and samples of the matching width, including the time stamp
+    const auto [n_sample, width] = get_dimension("/R1-K/R1-K0");
+    const auto [n_nonzero, unused] = get_dimension("/R1-K/R1-K-RowIndex");
+    const auto [new_n_sample, new_width] = get_dimension("/R1-K-1/R1-K0");
+    const auto [new_n_nonzero, new_unused] = get_dimension("/R1-K-1/R1-K-RowIndex");
+
+    H5Fclose(file_id);
+
+    REQUIRE(n_sample > 0);
+    REQUIRE(width == n_nonzero + 1);
+    REQUIRE(new_n_sample == 1);
+    REQUIRE(new_width == new_n_nonzero + 1);
+    REQUIRE(new_n_nonzero > n_nonzero);
+
+    fs::remove_all(root);
+}
+
+TEST_CASE("Checkpoint Round Trip", "[Model.Output]") {
+    const auto root = fs::temp_directory_path() / "suanpan-checkpoint";
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    // both the materials and the integrator carry history
+    const auto source = truss_model + R"(
+mass 3 2 10 1 2
+fix 1 P 1 3
+hdf5recorder 2 Node U2 2
+step dynamic 1 1
+set ini_step_size .0625
+set fixed_step_size 1
+cload 1 0 100 2 2
+integrator LeeNewmark 1 .25 .5 .05 2. .05 10.
+converger RelIncreDisp 1 1E-12 50 1
+)";
+
+    auto get_state = [](const shared_ptr<Bead>& model) {
+        const auto& t_domain = model->get_current_domain();
+        return std::vector<vec>{t_domain->get_node(2)->get_current_displacement(), t_domain->get_node(2)->get_current_velocity(), t_domain->get_element(1)->get_current_resistance(), t_domain->get_element(2)->get_current_resistance()};
+    };
+
+    auto analyze = [&](const string& extra, const bool restore) {
+        const auto model = create_model(source + extra);
+        const auto& t_domain = model->get_current_domain();
+        t_domain->set_output_path(root);
+        if(restore) {
+            istringstream command("restore checkpoint.h5");
+            process_command(model, command);
+            REQUIRE(t_domain->is_restoring());
+        }
+
+        REQUIRE(SUANPAN_SUCCESS == model->analyze());
+
+        return std::pair{get_state(model), t_domain->get_recorder(2)->get_time_pool()};
+    };
+
+    const auto [reference, reference_time] = analyze("", false);
+
+    // the initial state is recorded as the first sample, the last checkpoint is saved at the twelfth increment
+    const auto [interrupted, interrupted_time] = analyze("hdf5recorder 3 Checkpoint checkpoint.h5 every 12", false);
+    REQUIRE(fs::exists(root / "checkpoint.h5"));
+
+    const auto [resumed, resumed_time] = analyze("", true);
+
+    // only increments after the checkpoint are performed
+    REQUIRE(reference_time.size() == 17);
+    REQUIRE(resumed_time.size() == 4);
+    REQUIRE(Approx(resumed_time.front()) == .8125);
+
+    for(auto I = 0llu; I < reference.size(); ++I) {
+        REQUIRE(norm(reference[I]) > 0.);
+        REQUIRE(approx_equal(interrupted[I], reference[I], "absdiff", 1E-14));
+        REQUIRE(approx_equal(resumed[I], reference[I], "reldiff", 1E-10));
+    }
+
+    fs::remove_all(root);
+}
+#endif
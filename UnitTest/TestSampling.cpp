@@ -1,4 +1,5 @@
 #include <Toolbox/resampling.h>
+#include <Toolbox/response_spectrum.h>
 #include "CatchHeader.h"
 
 TEST_CASE("GCD", "[Utility.Sampling]") {
@@ -37,3 +38,18 @@ TEST_CASE("FIR", "[Utility.Sampling]") {
     fir_band_stop<WindowType::BlackmanHarris>(4, .1, .8);
     fir_band_stop<WindowType::FlatTop>(4, .1, .8);
 }
+
+TEST_CASE("Response Spectrum", "[Utility.Sampling]") {
+    const vec motion = sin(regspace(0., 999.) * .05) % exp(-regspace(0., 999.) * .002) + .1 * randn(1000);
+    const vec period = regspace(0., .1, 3.);
+    const vec damping_ratio{0., .02, .05, .2};
+
+    const auto spectra = response_spectrum(damping_ratio, .01, motion, period);
+
+    for(auto I = 0llu; I < damping_ratio.n_elem; ++I) {
+        const mat& spectrum = spectra.slice(I);
+        REQUIRE(norm(spectrum.col(0) - period) == 0.);
+        REQUIRE(spectrum(0, 3) == Approx(max(abs(motion))));
+        for(auto J = 1llu; J < period.n_elem; ++J) REQUIRE(norm(spectrum.row(J).tail(3).t() - Oscillator(datum::tau / period(J), damping_ratio(I)).compute_maximum_response(.01, motion)) <= 1E-10 * norm(spectrum.row(J)));
+    }
+}
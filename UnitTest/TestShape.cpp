@@ -1,4 +1,6 @@
+#include <Element/Utility/FixedKernel.hpp>
 #include <Toolbox/shape.h>
+#include <Toolbox/tensor.h>
 #include "CatchHeader.h"
 
 TEST_CASE("Compute Area By Shoelace", "[Utility.Shape]") {
@@ -24,3 +26,121 @@ TEST_CASE("Small Sparse", "[Utility.Shape]") {
         };
     }
 }
+
+namespace {
+    template<unsigned D, unsigned N> struct DynamicKernel {
+        static constexpr auto S = D * N, V = D * (D + 1) / 2;
+
+        static void update(mat& K, mat& G, vec& R, const vec& disp, const mat& pn, const mat& stiffness, const double weight) {
+            const mat gradient = reshape(disp, D, N) * pn.t() + eye(D, D);
+            mat BN(V, S);
+            for(unsigned J = 0; J < N; ++J)
+                for(unsigned L = 0; L < D; ++L) {
+                    const auto M = J * D + L;
+                    if constexpr(2 == D) {
+                        BN(0, M) = pn(0, J) * gradient(L, 0);
+                        BN(1, M) = pn(1, J) * gradient(L, 1);
+                        BN(2, M) = pn(0, J) * gradient(L, 1) + pn(1, J) * gradient(L, 0);
+                    }
+                    else {
+                        BN(0, M) = pn(0, J) * gradient(L, 0);
+                        BN(1, M) = pn(1, J) * gradient(L, 1);
+                        BN(2, M) = pn(2, J) * gradient(L, 2);
+                        BN(3, M) = pn(0, J) * gradient(L, 1) + pn(1, J) * gradient(L, 0);
+                        BN(4, M) = pn(1, J) * gradient(L, 2) + pn(2, J) * gradient(L, 1);
+                        BN(5, M) = pn(2, J) * gradient(L, 0) + pn(0, J) * gradient(L, 2);
+                    }
+                }
+
+            const vec stress = stiffness * tensor::strain::to_voigt(tensor::strain::to_green(gradient));
+            const mat sigma = tensor::stress::to_tensor(stress);
+            const mat t_geometry = weight * pn.t() * sigma * pn;
+            for(unsigned J = 0; J < N; ++J)
+                for(unsigned L = 0; L < N; ++L)
+                    for(unsigned M = 0; M < D; ++M) G(L * D + M, J * D + M) += t_geometry(L, J);
+
+            K += weight * BN.t() * stiffness * BN;
+            R += weight * BN.t() * stress;
+        }
+    };
+
+    template<unsigned D, unsigned N> struct FixedKernel {
+        static constexpr auto S = D * N, V = suanpan::kernel::voigt_size<D>;
+
+        static void update(mat& K, mat& G, vec& R, const vec& disp, const mat& pn, const mat& stiffness, const double weight) {
+            mat::fixed<D, D> gradient;
+            vec::fixed<V> strain, stress;
+            mat::fixed<V, S> BN;
+            suanpan::kernel::deformation_gradient<D, N>(gradient, disp, pn);
+            suanpan::kernel::nonlinear_strain_mat<D, N>(BN, pn, gradient);
+            suanpan::kernel::green_strain<D>(strain, gradient);
+            for(unsigned I = 0; I < V; ++I) {
+                stress(I) = 0.;
+                for(unsigned J = 0; J < V; ++J) stress(I) += stiffness(I, J) * strain(J);
+            }
+            suanpan::kernel::geometric_stiffness<D, N>(G, pn, stress, weight);
+            suanpan::kernel::btdb(K, BN, stiffness, weight);
+            suanpan::kernel::bts(R, BN, stress, weight);
+        }
+    };
+
+    template<unsigned D, unsigned N> void benchmark_element_kernel(const std::string& title) {
+        constexpr auto S = D * N, V = D * (D + 1) / 2;
+
+        const vec disp = 1E-2 * randn(S);
+        const mat pn = randn(D, N);
+        mat stiffness = randn(V, V);
+        stiffness += stiffness.t();
+
+        mat K1(S, S, fill::zeros), G1(S, S, fill::zeros), K2(S, S, fill::zeros), G2(S, S, fill::zeros);
+        vec R1(S, fill::zeros), R2(S, fill::zeros);
+
+        DynamicKernel<D, N>::update(K1, G1, R1, disp, pn, stiffness, .5);
+        FixedKernel<D, N>::update(K2, G2, R2, disp, pn, stiffness, .5);
+
+        REQUIRE(norm(K1 - K2) <= 1E-12 * norm(K1));
+        REQUIRE(norm(G1 - G2) <= 1E-12 * norm(G1));
+        REQUIRE(norm(R1 - R2) <= 1E-12 * norm(R1));
+
+        mat::fixed<V, S> FB;
+        suanpan::kernel::linear_strain_mat<D, N>(FB, pn);
+        const sp_mat SB(FB);
+
+        K1.zeros();
+        K2.zeros();
+        K1 += .5 * SB.t() * stiffness * SB;
+        suanpan::kernel::btdb(K2, FB, stiffness, .5);
+        REQUIRE(norm(K1 - K2) <= 1E-12 * norm(K1));
+
+        BENCHMARK((title + " Dynamic Nonlinear").c_str()) {
+            DynamicKernel<D, N>::update(K1, G1, R1, disp, pn, stiffness, .5);
+            return K1(0, 0);
+        };
+
+        BENCHMARK((title + " Fixed Nonlinear").c_str()) {
+            FixedKernel<D, N>::update(K2, G2, R2, disp, pn, stiffness, .5);
+            return K2(0, 0);
+        };
+
+        BENCHMARK((title + " Sparse Linear").c_str()) {
+            K1 += .5 * SB.t() * stiffness * SB;
+            R1 += .5 * SB.t() * (stiffness * (SB * disp));
+            return K1(0, 0);
+        };
+
+        BENCHMARK((title + " Fixed Linear").c_str()) {
+            vec::fixed<V> strain;
+            suanpan::kernel::bu(strain, FB, disp);
+            suanpan::kernel::btdb(K2, FB, stiffness, .5);
+            suanpan::kernel::bts(R2, FB, stiffness * strain, .5);
+            return K2(0, 0);
+        };
+    }
+} // namespace
+
+TEST_CASE("Fixed Size Element Kernel", "[Utility.Shape]") {
+    benchmark_element_kernel<2, 4>("CP4");
+    benchmark_element_kernel<2, 8>("CP8");
+    benchmark_element_kernel<3, 8>("C3D8");
+    benchmark_element_kernel<3, 20>("C3D20");
+}
@@ -207,3 +207,145 @@ TEST_CASE("Iterative Solver Dense Mat", "[Matrix.Solver]") {
         REQUIRE(norm(solve(B, C) - x) <= 1E-12);
     }
 }
+
+TEST_CASE("Iterative Solver CG", "[Matrix.Solver]") {
+    SolverSetting<double> setting;
+    setting.iterative_solver = IterativeSolver::CG;
+    setting.max_iteration = 1000;
+    setting.tolerance = 1E-14;
+
+    for(const auto P : {PreconditionerType::ICC, PreconditionerType::JACOBI, PreconditionerType::NONE}) {
+        setting.preconditioner_type = P;
+
+        for(auto I = 0; I < 10; ++I) {
+            const auto N = randi<uword>(distr_param(100, 200));
+            auto A = SparseMatSuperLU<double>(N, N);
+
+            const sp_mat D = sprandu(N, N, .02);
+            const sp_mat B = D + D.t() + speye(N, N) * 1E1;
+
+            const mat C = randu<mat>(N, 2);
+            mat x;
+
+            A.zeros();
+            for(auto J = B.begin(); J != B.end(); ++J) A.at(J.row(), J.col()) = *J;
+            A.set_solver_setting(setting);
+
+            REQUIRE(SUANPAN_SUCCESS == A.solve(x, C));
+            REQUIRE(norm(spsolve(B, C) - x) <= 1E-12);
+        }
+    }
+}
+
+TEST_CASE("Iterative Solver CG AMG", "[Matrix.Solver]") {
+    SolverSetting<double> setting;
+    setting.iterative_solver = IterativeSolver::CG;
+    setting.preconditioner_type = PreconditionerType::AMG;
+    setting.max_iteration = 200;
+    setting.tolerance = 1E-12;
+
+    // 2D Laplacian large enough to build more than one level
+    constexpr uword M = 60, N = M * M;
+    auto A = SparseMatSuperLU<double>(N, N);
+    A.set_solver_setting(setting);
+
+    sp_mat B(N, N);
+    for(uword I = 0; I < M; ++I)
+        for(uword J = 0; J < M; ++J) {
+            const auto K = I * M + J;
+            B(K, K) = 4.;
+            if(J > 0) B(K, K - 1) = B(K - 1, K) = -1.;
+            if(I > 0) B(K, K - M) = B(K - M, K) = -1.;
+        }
+
+    const mat C = randu<mat>(N, 2);
+
+    // the second solve shares the same pattern and reuses the hierarchy
+    for(const auto factor : {1., 2.}) {
+        const sp_mat D = factor * B;
+
+        A.zeros();
+        for(auto J = D.begin(); J != D.end(); ++J) A.at(J.row(), J.col()) = *J;
+
+        mat x;
+        REQUIRE(SUANPAN_SUCCESS == A.solve(x, C));
+        REQUIRE(norm(D * x - C) <= 1E-10 * norm(C));
+    }
+
+    REQUIRE(A.get_amg_preconditioner()->get_level() > 1);
+    REQUIRE(A.get_amg_preconditioner()->get_symbolic_counter() == 1);
+    REQUIRE(A.get_amg_preconditioner()->get_numeric_counter() == 2);
+}
+
+TEST_CASE("Iterative Solver CG AMG Rigid Body", "[Matrix.Solver]") {
+    // a braced lattice of bars with two DoFs per node, the left edge is supported by springs
+    constexpr uword M = 25, N = M * M;
+
+    auto space = std::make_shared<NearNullSpace<double>>();
+    space->basis.zeros(2 * N, 3);
+    space->group.zeros(2 * N);
+
+    sp_mat B(2 * N, 2 * N);
+    auto add_bar = [&](const uword P, const uword Q, const double X, const double Y) {
+        const vec direction = normalise(vec{X, Y});
+        const mat K = direction * direction.t();
+        const uvec dof{2 * P, 2 * P + 1, 2 * Q, 2 * Q + 1};
+        for(auto I = 0llu; I < 2; ++I)
+            for(auto J = 0llu; J < 2; ++J) {
+                B(dof(I), dof(J)) += K(I, J);
+                B(dof(I + 2), dof(J + 2)) += K(I, J);
+                B(dof(I), dof(J + 2)) -= K(I, J);
+                B(dof(I + 2), dof(J)) -= K(I, J);
+            }
+    };
+
+    for(uword I = 0; I < M; ++I)
+        for(uword J = 0; J < M; ++J) {
+            const auto K = I * M + J;
+            const auto X = static_cast<double>(J), Y = static_cast<double>(I);
+            space->group(2 * K) = space->group(2 * K + 1) = K;
+            space->basis(2 * K, 0) = space->basis(2 * K + 1, 1) = 1.;
+            space->basis(2 * K, 2) = -Y;
+            space->basis(2 * K + 1, 2) = X;
+            if(J > 0) add_bar(K, K - 1, 1., 0.);
+            if(I > 0) add_bar(K, K - M, 0., 1.);
+            if(I > 0 && J > 0) add_bar(K, K - M - 1, 1., 1.);
+            if(I > 0 && J + 1 < M) add_bar(K, K - M + 1, -1., 1.);
+            if(0 == J) B(2 * K, 2 * K) += 1., B(2 * K + 1, 2 * K + 1) += 1.;
+        }
+
+    SolverSetting<double> setting;
+    setting.iterative_solver = IterativeSolver::CG;
+    setting.preconditioner_type = PreconditionerType::AMG;
+    setting.max_iteration = 500;
+    setting.tolerance = 1E-12;
+    setting.near_null_space = space;
+
+    auto A = SparseMatSuperLU<double>(2 * N, 2 * N);
+    A.set_solver_setting(setting);
+
+    const mat C = randu<mat>(2 * N, 1);
+
+    // the corner coupling vanishes in the second solve, which shall not alter the structure
+    for(const auto corner : {1E-3, 0.}) {
+        sp_mat D = 2. * B;
+
+        A.zeros();
+        for(auto J = D.begin(); J != D.end(); ++J) A.at(J.row(), J.col()) = *J;
+        A.at(0, 2 * N - 1) = A.at(2 * N - 1, 0) = corner;
+
+        D(0, 2 * N - 1) = D(2 * N - 1, 0) = corner;
+
+        mat x;
+        REQUIRE(SUANPAN_SUCCESS == A.solve(x, C));
+        REQUIRE(norm(D * x - C) <= 1E-10 * norm(C));
+    }
+
+    REQUIRE(A.get_amg_preconditioner()->get_level() > 1);
+    REQUIRE(A.get_amg_preconditioner()->get_symbolic_counter() == 1);
+    REQUIRE(A.get_amg_preconditioner()->get_numeric_counter() == 2);
+
+    // copies do not share the hierarchy
+    const auto copy = A.make_copy();
+    REQUIRE(nullptr == copy->get_amg_preconditioner());
+}
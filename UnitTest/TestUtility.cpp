@@ -1,5 +1,7 @@
+#include <Domain/Domain.h>
 #include <Toolbox/sync_ostream.h>
 #include <Toolbox/utility.h>
+#include <Toolbox/writer_queue.hpp>
 #include <thread>
 #include "CatchHeader.h"
 
@@ -65,3 +67,80 @@ TEST_CASE("Color Print", "[Utility.Print]") {
     suanpan_fatal("TEST.\n");
     suanpan_info("TEST.\n", vec{1, 2, 3});
 }
+
+TEST_CASE("Writer Queue Order", "[Utility.Queue]") {
+    writer_queue queue(4);
+
+    std::vector<int> result;
+    for(auto I = 0; I < 100; ++I) queue.push([&result, I] { result.emplace_back(I); });
+    queue.flush();
+
+    REQUIRE(result.size() == 100);
+    for(auto I = 0; I < 100; ++I) REQUIRE(result[I] == I);
+}
+
+TEST_CASE("Writer Queue Back Pressure", "[Utility.Queue]") {
+    writer_queue queue(2);
+
+    std::promise<void> started, gate;
+    auto gate_future = gate.get_future().share();
+
+    // the running task holds the thread, two more tasks fill the queue
+    queue.push([&started, gate_future] {
+        started.set_value();
+        gate_future.wait();
+    });
+    started.get_future().wait();
+    queue.push([] {});
+    queue.push([] {});
+
+    std::atomic_bool pushed = false;
+    std::thread producer([&] {
+        queue.push([] {});
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE_FALSE(pushed);
+
+    gate.set_value();
+    producer.join();
+    queue.flush();
+
+    REQUIRE(pushed);
+}
+
+TEST_CASE("Writer Queue Owner Flush", "[Utility.Queue]") {
+    writer_queue queue;
+
+    int owner_a, owner_b;
+
+    std::atomic_bool done_a = false;
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+
+    queue.push([&] { done_a = true; }, &owner_a);
+    queue.push([gate_future] { gate_future.wait(); }, &owner_b);
+
+    // the task of the other owner is still blocked
+    queue.flush(&owner_a);
+    REQUIRE(done_a);
+
+    gate.set_value();
+    queue.flush(&owner_b);
+}
+
+TEST_CASE("Writer Queue Flush On Wait", "[Utility.Queue]") {
+    const auto domain = std::make_shared<Domain>();
+
+    std::atomic_int counter = 0;
+    for(auto I = 0; I < 20; ++I)
+        suanpan::output_queue().push([&counter] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ++counter;
+        }, static_cast<const DomainBase*>(domain.get()));
+
+    domain->wait();
+
+    REQUIRE(20 == counter);
+}